@@ -0,0 +1,19 @@
+#include <stdio.h>
+
+// the same sum as in.msk, read by scanf
+int main(void)
+{
+    long n = 0, x = 0, s = 0;
+    if (scanf("%ld", &n) != 1)
+        return 1;
+
+    for (long i = 0; i < n; ++i)
+    {
+        if (scanf("%ld", &x) != 1)
+            return 1;
+        s += x;
+    }
+
+    printf("%ld\n", s);
+    return 0;
+}
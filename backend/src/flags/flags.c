@@ -58,6 +58,8 @@ enum FlagsError flags_objs_ctor(flags_objs_t* const flags_objs)
     flags_objs->nasm_out    = NULL;
     flags_objs->elf_out     = NULL;
 
+    flags_objs->regalloc    = true;
+
     return FLAGS_ERROR_SUCCESS;
 }
 
@@ -94,7 +96,7 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
     lassert(argc, "");
 
     int getopt_rez = 0;
-    while ((getopt_rez = getopt(argc, argv, "l:i:s:a:e:")) != -1)
+    while ((getopt_rez = getopt(argc, argv, "l:i:s:a:e:r:")) != -1)
     {
         switch (getopt_rez)
         {
@@ -151,6 +153,13 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
                 break;
             }
 
+            case 'r':
+            {
+                flags_objs->regalloc = atoi(optarg);
+
+                break;
+            }
+
             default:
             {
                 fprintf(stderr, "Getopt error - d: %d, c: %c\n", getopt_rez, (char)getopt_rez);
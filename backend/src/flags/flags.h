@@ -1,6 +1,8 @@
 #ifndef MASIK_BACKEND_SRC_FLAGS_FLAGS_H
 #define MASIK_BACKEND_SRC_FLAGS_FLAGS_H
 
+#include <stdbool.h>
+
 #include "utils/utils.h"
 
 enum FlagsError
@@ -36,6 +38,8 @@ typedef struct FlagsObjs
     FILE* splu_out;
     FILE* nasm_out;
     FILE* elf_out;
+
+    bool regalloc;
 } flags_objs_t;
 
 enum FlagsError flags_objs_ctor (flags_objs_t* const flags_objs);
@@ -7,11 +7,13 @@
 #include <stdbool.h>
 #include <ctype.h>
 #include <string.h>
+#include <stdlib.h>
 
 #include "funcs.h"
 #include "utils/utils.h"
 #include "ir_fist/verification/verification.h"
 #include "ir_fist/structs.h"
+#include "utils/src/pyam_bin/structs.h"
 
 #define FIST_ERROR_HANDLE_(call_func, ...)                                                          \
     do {                                                                                            \
@@ -45,24 +47,78 @@ enum IrFistError ir_block_init(ir_block_t* const block)
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_CALL_FUNCTION(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_FUNCTION_BODY(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_COND_JUMP(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_ASSIGNMENT(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_OPERATION(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_RETURN(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_LABEL(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_SYSCALL(ir_block_t* const block, const char** const cur_text_pos);
-static enum IrFistError parse_GLOBAL_VARS(ir_block_t* const block, const char** const cur_text_pos);
+size_t ir_block_use_tmps(const ir_block_t* const block, size_t* const tmps)
+{
+    lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(tmps), "");
+
+    if (block->type == IR_OP_BLOCK_TYPE_OPERATION)
+    {
+        tmps[0] = block->operand1_num;
+        tmps[1] = block->operand2_num;
+        return 2;
+    }
+
+    if (block->type == IR_OP_BLOCK_TYPE_RETURN)
+    {
+        tmps[0] = block->ret_num;
+        return 1;
+    }
+
+    if ((block->type == IR_OP_BLOCK_TYPE_COND_JUMP || block->type == IR_OP_BLOCK_TYPE_ASSIGNMENT)
+      && block->operand1_type == IR_OPERAND_TYPE_TMP)
+    {
+        tmps[0] = block->operand1_num;
+        return 1;
+    }
+
+    return 0;
+}
+
+bool ir_block_syscall_have_ret_val(const ir_block_t* const block)
+{
+    lassert(!is_invalid_ptr(block), "");
+    lassert(block->type == IR_OP_BLOCK_TYPE_SYSCALL, "");
+
+    if (block->operand2_num < kIR_SYS_CALL_NUMBER)
+        return kIR_SYS_CALL_ARRAY[block->operand2_num].HaveRetVal;
+
+    return true;
+}
+
+static enum IrFistError parse_CALL_FUNCTION(ir_block_t* const block, char* const label,
+                                            const char** const cur_text_pos);
+static enum IrFistError parse_FUNCTION_BODY(ir_block_t* const block, char* const label,
+                                            const char** const cur_text_pos);
+static enum IrFistError parse_COND_JUMP(ir_block_t* const block, char* const label,
+                                        const char** const cur_text_pos);
+static enum IrFistError parse_ASSIGNMENT(ir_block_t* const block, char* const label,
+                                         const char** const cur_text_pos);
+static enum IrFistError parse_OPERATION(ir_block_t* const block, char* const label,
+                                        const char** const cur_text_pos);
+static enum IrFistError parse_RETURN(ir_block_t* const block, char* const label,
+                                     const char** const cur_text_pos);
+static enum IrFistError parse_LABEL(ir_block_t* const block, char* const label,
+                                    const char** const cur_text_pos);
+static enum IrFistError parse_SYSCALL(ir_block_t* const block, char* const label,
+                                      const char** const cur_text_pos);
+static enum IrFistError parse_GLOBAL_VARS(ir_block_t* const block, char* const label,
+                                          const char** const cur_text_pos);
 
 static int str_from_file_(const char* const filename, char** str, size_t* const str_size);
 
+static enum IrFistError ir_fist_from_bin_(fist_t* const fist, interner_t* const labels,
+                                          const char* const data, const size_t data_size);
+
+static size_t syscall_index_(const char* const name);
+
 #define IR_OP_BLOCK_HANDLE(num_, name_)                                                             \
     parse_##name_,
 
-enum IrFistError ir_fist_ctor(fist_t* fist, const char* const filename)
+enum IrFistError ir_fist_ctor(fist_t* fist, interner_t* const labels, const char* const filename)
 {
     lassert(!is_invalid_ptr(fist), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(filename), "");
 
     char* text = NULL;
@@ -74,7 +130,21 @@ enum IrFistError ir_fist_ctor(fist_t* fist, const char* const filename)
         return IR_FIST_ERROR_STANDARD_ERRNO;
     }
 
-    enum IrFistError (*ir_blocks[])(ir_block_t* const block, const char** const cur_text_pos) = {
+    if (text_size >= sizeof(pyam_bin_header_t) && !memcmp(text, PYAM_BIN_MAGIC, PYAM_BIN_MAGIC_SIZE))
+    {
+        IR_FIST_ERROR_HANDLE(
+            ir_fist_from_bin_(fist, labels, text, text_size),
+            fist_dtor(fist);
+            munmap(text, text_size);
+        );
+
+        munmap(text, text_size);
+
+        return IR_FIST_ERROR_SUCCESS;
+    }
+
+    enum IrFistError (*ir_blocks[])(ir_block_t* const block, char* const label,
+                                    const char** const cur_text_pos) = {
 
 #include "PYAM_IR/include/codegen.h"
 
@@ -100,12 +170,14 @@ enum IrFistError ir_fist_ctor(fist_t* fist, const char* const filename)
             munmap(text, text_size);
         );
 
+        char label[MAX_LABEL_NAME_SIZE + 1] = {};
+
         bool is_parsed = false;
         // fprintf(stderr, RED_TEXT("NEXT:\n") "'%s'", cur_text_pos);
 
         for (size_t ir_block_ind = 0; ir_block_ind < ir_blocks_size; ++ir_block_ind)
         {
-            if (ir_blocks[ir_block_ind](&block, &cur_text_pos) == IR_FIST_ERROR_SUCCESS)
+            if (ir_blocks[ir_block_ind](&block, label, &cur_text_pos) == IR_FIST_ERROR_SUCCESS)
             {
                 // fprintf(stderr, "it: %zu, ind: %zu\n",  handled_block_cnt, ir_block_ind);
                 is_parsed = true;
@@ -121,6 +193,15 @@ enum IrFistError ir_fist_ctor(fist_t* fist, const char* const filename)
             return IR_FIST_ERROR_PARSE_BLOCK;
         }
 
+        if (block.label_type == IR_OPERAND_TYPE_LABEL)
+        {
+            IR_FIST_ERROR_HANDLE(
+                ir_label_intern(labels, label, &block.label_num),
+                fist_dtor(fist);
+                munmap(text, text_size);
+            );
+        }
+
         FIST_ERROR_HANDLE_(
             fist_push(fist, handled_block_cnt++, &block),
             fist_dtor(fist);
@@ -138,7 +219,8 @@ enum IrFistError ir_fist_ctor(fist_t* fist, const char* const filename)
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_CALL_FUNCTION(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_CALL_FUNCTION(ir_block_t* const block, char* const label,
+                                            const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
@@ -150,7 +232,7 @@ static enum IrFistError parse_CALL_FUNCTION(ir_block_t* const block, const char*
     int read_sym_cnt = 0;
 
     if (sscanf(*cur_text_pos, "RingRing(tmp%zu, %128[^)]%*[^\n]%n", 
-            &block->ret_num, block->label_str, &read_sym_cnt) 
+            &block->ret_num, label, &read_sym_cnt) 
         >= 2)
     {
         block->ret_type = IR_OPERAND_TYPE_TMP;
@@ -166,7 +248,8 @@ static enum IrFistError parse_CALL_FUNCTION(ir_block_t* const block, const char*
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_FUNCTION_BODY(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_FUNCTION_BODY(ir_block_t* const block, char* const label,
+                                            const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
@@ -178,7 +261,7 @@ static enum IrFistError parse_FUNCTION_BODY(ir_block_t* const block, const char*
     int read_sym_cnt = 0;
 
     if (sscanf(*cur_text_pos, "Gyat(%128[^,], %zu, %zu%*[^\n]%n", 
-            block->label_str, &block->operand1_num, &block->operand2_num, &read_sym_cnt) 
+            label, &block->operand1_num, &block->operand2_num, &read_sym_cnt) 
         >= 3)
     {
         block->label_type = IR_OPERAND_TYPE_LABEL;
@@ -196,7 +279,8 @@ static enum IrFistError parse_FUNCTION_BODY(ir_block_t* const block, const char*
 
 }
 
-static enum IrFistError parse_COND_JUMP(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_COND_JUMP(ir_block_t* const block, char* const label,
+                                        const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
@@ -208,7 +292,7 @@ static enum IrFistError parse_COND_JUMP(ir_block_t* const block, const char** co
     int read_sym_cnt = 0;
 
     if (sscanf(*cur_text_pos, "Frog(%128[^,], tmp%zu%*[^\n]%n", 
-            block->label_str, &block->operand1_num, &read_sym_cnt) 
+            label, &block->operand1_num, &read_sym_cnt) 
         >= 2)
     {
         block->label_type = IR_OPERAND_TYPE_LABEL;
@@ -216,7 +300,7 @@ static enum IrFistError parse_COND_JUMP(ir_block_t* const block, const char** co
     }
     else 
     if (sscanf(*cur_text_pos, "Frog(%128[^,], %zu%*[^\n]%n", 
-            block->label_str, &block->operand1_num, &read_sym_cnt) 
+            label, &block->operand1_num, &read_sym_cnt) 
         >= 2)
     {
         block->label_type = IR_OPERAND_TYPE_LABEL;
@@ -232,11 +316,13 @@ static enum IrFistError parse_COND_JUMP(ir_block_t* const block, const char** co
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_ASSIGNMENT(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_ASSIGNMENT(ir_block_t* const block, char* const label,
+                                         const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
     lassert(!is_invalid_ptr(*cur_text_pos), "");
+    (void)label;
     // fprintf(stderr, "assign func\n");
 
     block->type = IR_OP_BLOCK_TYPE_ASSIGNMENT;
@@ -294,11 +380,13 @@ static enum IrFistError parse_ASSIGNMENT(ir_block_t* const block, const char** c
 
 }
 
-static enum IrFistError parse_OPERATION(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_OPERATION(ir_block_t* const block, char* const label,
+                                        const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
     lassert(!is_invalid_ptr(*cur_text_pos), "");
+    (void)label;
     // fprintf(stderr, "op func\n");
 
     block->type = IR_OP_BLOCK_TYPE_OPERATION;
@@ -325,11 +413,13 @@ static enum IrFistError parse_OPERATION(ir_block_t* const block, const char** co
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_RETURN(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_RETURN(ir_block_t* const block, char* const label,
+                                     const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
     lassert(!is_invalid_ptr(*cur_text_pos), "");
+    (void)label;
     // fprintf(stderr, "ret func\n");
 
     block->type = IR_OP_BLOCK_TYPE_RETURN;
@@ -352,7 +442,8 @@ static enum IrFistError parse_RETURN(ir_block_t* const block, const char** const
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_LABEL(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_LABEL(ir_block_t* const block, char* const label,
+                                    const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
@@ -364,7 +455,7 @@ static enum IrFistError parse_LABEL(ir_block_t* const block, const char** const
     int read_sym_cnt = 0;
 
     if (sscanf(*cur_text_pos, "Viperr(%128[^)]%*[^\n]%n", 
-            block->label_str, &read_sym_cnt) 
+            label, &read_sym_cnt) 
         >= 1)
     {
         block->label_type = IR_OPERAND_TYPE_LABEL;
@@ -379,7 +470,8 @@ static enum IrFistError parse_LABEL(ir_block_t* const block, const char** const
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_SYSCALL(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_SYSCALL(ir_block_t* const block, char* const label,
+                                      const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
@@ -391,19 +483,13 @@ static enum IrFistError parse_SYSCALL(ir_block_t* const block, const char** cons
     int read_sym_cnt = 0;
 
     if (sscanf(*cur_text_pos, "Bobb(tmp%zu, %128[^,], %zu%*[^\n]%n", 
-            &block->ret_num, block->label_str, &block->operand1_num, &read_sym_cnt) 
+            &block->ret_num, label, &block->operand1_num, &read_sym_cnt) 
         >= 3)
     {
-        block->operand2_num = 0;
-        for (; block->operand2_num < kIR_SYS_CALL_NUMBER; ++block->operand2_num)
-        {
-            if (strcmp(block->label_str, kIR_SYS_CALL_ARRAY[block->operand2_num].Name) == 0)
-            {
-                break;
-            }
-        }
-        
-        block->ret_num = IR_OPERAND_TYPE_TMP;
+        block->operand2_num = syscall_index_(label);
+
+
+        block->ret_type = IR_OPERAND_TYPE_TMP;
         block->label_type = IR_OPERAND_TYPE_LABEL;
         block->operand1_type = IR_OPERAND_TYPE_NUM;
         block->operand2_type = IR_OPERAND_TYPE_NUM;
@@ -418,11 +504,13 @@ static enum IrFistError parse_SYSCALL(ir_block_t* const block, const char** cons
     return IR_FIST_ERROR_SUCCESS;
 }
 
-static enum IrFistError parse_GLOBAL_VARS(ir_block_t* const block, const char** const cur_text_pos)
+static enum IrFistError parse_GLOBAL_VARS(ir_block_t* const block, char* const label,
+                                          const char** const cur_text_pos)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(cur_text_pos), "");
     lassert(!is_invalid_ptr(*cur_text_pos), "");
+    (void)label;
 
     block->type = IR_OP_BLOCK_TYPE_GLOBAL_VARS;
 
@@ -506,4 +594,128 @@ static int str_size_from_file_(size_t* const str_size, const int fd)
     *str_size = (size_t)fd_stat.st_size;
 
     return 0;
-}
\ No newline at end of file
+}
+
+static size_t syscall_index_(const char* const name)
+{
+    lassert(!is_invalid_ptr(name), "");
+
+    size_t syscall_ind = 0;
+    for (; syscall_ind < kIR_SYS_CALL_NUMBER; ++syscall_ind)
+    {
+        if (strcmp(name, kIR_SYS_CALL_ARRAY[syscall_ind].Name) == 0)
+        {
+            break;
+        }
+    }
+
+    return syscall_ind;
+}
+
+enum IrFistError ir_label_intern(interner_t* const labels, const char* const name, size_t* const id)
+{
+    lassert(!is_invalid_ptr(labels), "");
+    lassert(!is_invalid_ptr(name), "");
+    lassert(!is_invalid_ptr(id), "");
+
+    wchar_t wname[MAX_LABEL_NAME_SIZE + 1] = {};
+    const size_t wname_len = mbstowcs(wname, name, MAX_LABEL_NAME_SIZE);
+    if (wname_len == (size_t)-1)
+    {
+        fprintf(stderr, "Invalid label name '%s'\n", name);
+        return IR_FIST_ERROR_INTERNER;
+    }
+
+    const enum InternerError interner_error = interner_intern(labels, wname, wname_len, id);
+    if (interner_error)
+    {
+        fprintf(stderr, "Can't intern label '%s'. Error: %s\n", name, interner_strerror(interner_error));
+        return IR_FIST_ERROR_INTERNER;
+    }
+
+    return IR_FIST_ERROR_SUCCESS;
+}
+
+static enum IrFistError ir_fist_from_bin_(fist_t* const fist, interner_t* const labels,
+                                          const char* const data, const size_t data_size)
+{
+    lassert(!is_invalid_ptr(fist), "");
+    lassert(!is_invalid_ptr(labels), "");
+    lassert(!is_invalid_ptr(data), "");
+
+    pyam_bin_header_t header = {};
+    memcpy(&header, data, sizeof(header));
+
+    if (header.version      != PYAM_BIN_VERSION
+     || header.record_size  != sizeof(pyam_bin_record_t)
+     || header.records_offset > data_size
+     || header.records_cnt    > (data_size - header.records_offset) / sizeof(pyam_bin_record_t)
+     || header.strings_offset > data_size
+     || header.strings_size   > data_size - header.strings_offset
+     || (header.strings_size && data[header.strings_offset + header.strings_size - 1] != '\0'))
+    {
+        fprintf(stderr, "Invalid binary IR header\n");
+        return IR_FIST_ERROR_INVALID_BIN;
+    }
+
+    const pyam_bin_view_t view = {
+        .records      = (const pyam_bin_record_t*)(data + header.records_offset),
+        .records_cnt  = header.records_cnt,
+        .strings      = data + header.strings_offset,
+        .strings_size = header.strings_size
+    };
+
+    IR_FIST_ERROR_HANDLE(ir_fist_from_view(fist, labels, view));
+
+    return IR_FIST_ERROR_SUCCESS;
+}
+
+enum IrFistError ir_fist_from_view(fist_t* const fist, interner_t* const labels, const pyam_bin_view_t view)
+{
+    lassert(!is_invalid_ptr(fist), "");
+    lassert(!is_invalid_ptr(labels), "");
+    lassert(!view.records_cnt  || !is_invalid_ptr(view.records), "");
+    lassert(!view.strings_size || !is_invalid_ptr(view.strings), "");
+
+    for (size_t record_ind = 0; record_ind < view.records_cnt; ++record_ind)
+    {
+        const pyam_bin_record_t* const record = view.records + record_ind;
+
+        ir_block_t block = {};
+        IR_FIST_ERROR_HANDLE(ir_block_init(&block));
+
+        block.type              = (enum IrOpBlockType)record->type;
+        block.ret_type          = (enum IrOperandType)record->ret_type;
+        block.label_type        = (enum IrOperandType)record->label_type;
+        block.operation_type    = (enum IrOperandType)record->operation_type;
+        block.operand1_type     = (enum IrOperandType)record->operand1_type;
+        block.operand2_type     = (enum IrOperandType)record->operand2_type;
+
+        block.ret_num           = record->ret_num;
+        block.operation_num     = (enum IrOpType)record->operation_num;
+        block.operand1_num      = record->operand1_num;
+        block.operand2_num      = record->operand2_num;
+
+        if (record->label_offset != PYAM_BIN_NO_LABEL)
+        {
+            if (record->label_offset >= view.strings_size)
+            {
+                fprintf(stderr, "Invalid label offset in binary IR record %zu\n", record_ind);
+                return IR_FIST_ERROR_INVALID_BIN;
+            }
+
+            const char* const label = view.strings + record->label_offset;
+
+            if (block.type == IR_OP_BLOCK_TYPE_SYSCALL)
+            {
+                block.operand2_num = syscall_index_(label);
+            }
+
+            IR_FIST_ERROR_HANDLE(ir_label_intern(labels, label, &block.label_num));
+        }
+
+        FIST_ERROR_HANDLE_(fist_push(fist, record_ind, &block));
+    }
+
+    return IR_FIST_ERROR_SUCCESS;
+}
@@ -1,12 +1,30 @@
 #ifndef MASIK_BACKEND_IR_FIST_FUNCS_FUNCS_H
 #define MASIK_BACKEND_IR_FIST_FUNCS_FUNCS_H
 
+#include <stdbool.h>
+
 #include "ir_fist/verification/verification.h"
 #include "hash_table/libs/list_on_array/libfist.h"
 #include "ir_fist/structs.h"
+#include "utils/src/pyam_bin/structs.h"
+#include "utils/src/interner/interner.h"
 
 enum IrFistError ir_block_init(ir_block_t* const block);
 
-enum IrFistError ir_fist_ctor(fist_t* fist, const char* const filename);
+// tmps read by the block, at most 2 of them
+size_t ir_block_use_tmps(const ir_block_t* const block, size_t* const tmps);
+
+// syscalls of masik runtime (memo_*) aren't in PYAM syscalls table, all of them have ret val
+bool ir_block_syscall_have_ret_val(const ir_block_t* const block);
+
+// label names are interned to labels, label_num of blocks are their ids
+enum IrFistError ir_fist_ctor(fist_t* fist, interner_t* const labels, const char* const filename);
+
+// binary IR records already lying in memory, e.g. right from the midlend
+enum IrFistError ir_fist_from_view(fist_t* const fist, interner_t* const labels,
+                                   const pyam_bin_view_t view);
+
+// id of label name, that isn't from IR, e.g. of runtime function
+enum IrFistError ir_label_intern(interner_t* const labels, const char* const name, size_t* const id);
 
 #endif /*MASIK_BACKEND_IR_FIST_FUNCS_FUNCS_H*/
\ No newline at end of file
@@ -1,10 +1,14 @@
 #ifndef MASIK_BACKEND_SRC_IR_FIST_STRUCTS_H
 #define MASIK_BACKEND_SRC_IR_FIST_STRUCTS_H
 
+#include <assert.h>
+
 #include "PYAM_IR/include/libpyam_ir.h"
 
 #define MAX_LABEL_NAME_SIZE (128)
 
+// label_num is id of the label name in labels interner, that is filled by the parser,
+// so the block fits in one cache line
 typedef struct IrBlock
 {
     enum IrOpBlockType type;
@@ -13,13 +17,14 @@ typedef struct IrBlock
     enum IrOperandType operation_type;
     enum IrOperandType operand1_type;
     enum IrOperandType operand2_type;
+    enum IrOpType operation_num;
 
     size_t ret_num;
-    char label_str[MAX_LABEL_NAME_SIZE];
-    enum IrOpType operation_num;
+    size_t label_num;
     size_t operand1_num;
     size_t operand2_num;
 } ir_block_t;
+static_assert(sizeof(ir_block_t) <= 64, "");
 
 
 #endif /*MASIK_BACKEND_SRC_IR_FIST_STRUCTS_H*/
\ No newline at end of file
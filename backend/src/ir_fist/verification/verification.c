@@ -9,6 +9,8 @@ const char* ir_fist_strerror(const enum IrFistError error)
         CASE_ENUM_TO_STRING_(IR_FIST_ERROR_STANDARD_ERRNO);
         CASE_ENUM_TO_STRING_(IR_FIST_ERROR_PARSE_BLOCK);
         CASE_ENUM_TO_STRING_(IR_FIST_ERROR_FIST);
+        CASE_ENUM_TO_STRING_(IR_FIST_ERROR_INVALID_BIN);
+        CASE_ENUM_TO_STRING_(IR_FIST_ERROR_INTERNER);
         default:
             return "UNKNOWN_IR_FIST_ERROR";
     }
@@ -9,6 +9,8 @@ enum IrFistError
     IR_FIST_ERROR_STANDARD_ERRNO        = 1,
     IR_FIST_ERROR_PARSE_BLOCK           = 2,
     IR_FIST_ERROR_FIST                  = 3,
+    IR_FIST_ERROR_INVALID_BIN           = 4,
+    IR_FIST_ERROR_INTERNER              = 5,
 };
 static_assert(IR_FIST_ERROR_SUCCESS == 0, "");
 
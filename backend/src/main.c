@@ -8,6 +8,7 @@
 #include "translation/funcs/funcs.h"
 #include "ir_fist/funcs/funcs.h"
 #include "ir_fist/structs.h"
+#include "utils/src/interner/interner.h"
 
 int init_all(flags_objs_t* const flags_objs, const int argc, char* const * argv);
 int dtor_all(flags_objs_t* const flags_objs);
@@ -28,23 +29,29 @@ int main(const int argc, char* const argv[])
     FIST_ERROR_HANDLE(FIST_CTOR(&fist, sizeof(ir_block_t), 10),
                                                                               dtor_all(&flags_objs);
     );
-    IR_FIST_ERROR_HANDLE(ir_fist_ctor(&fist, flags_objs.in_filename),
+    interner_t labels = {};
+    INTERNER_ERROR_HANDLE(interner_ctor(&labels),
                                                              dtor_all(&flags_objs);fist_dtor(&fist);
     );
+    IR_FIST_ERROR_HANDLE(ir_fist_ctor(&fist, &labels, flags_objs.in_filename),
+                                    dtor_all(&flags_objs);fist_dtor(&fist);interner_dtor(&labels);
+    );
 
-    TRANSLATION_ERROR_HANDLE(translate_splu(&fist, flags_objs.splu_out),
-                                                             dtor_all(&flags_objs);fist_dtor(&fist);
+    TRANSLATION_ERROR_HANDLE(translate_splu(&fist, &labels, flags_objs.splu_out),
+                                    dtor_all(&flags_objs);fist_dtor(&fist);interner_dtor(&labels);
     );
 
-    TRANSLATION_ERROR_HANDLE(translate_nasm(&fist, flags_objs.nasm_out),
-                                                             dtor_all(&flags_objs);fist_dtor(&fist);
+    TRANSLATION_ERROR_HANDLE(translate_nasm(&fist, &labels, flags_objs.nasm_out),
+                                    dtor_all(&flags_objs);fist_dtor(&fist);interner_dtor(&labels);
     );
 
-    TRANSLATION_ERROR_HANDLE(translate_elf(&fist, flags_objs.elf_out),
-                                                             dtor_all(&flags_objs);fist_dtor(&fist);
+    const elf_opts_t elf_opts = {.regalloc = flags_objs.regalloc, .report = false};
+    TRANSLATION_ERROR_HANDLE(translate_elf(&fist, &labels, flags_objs.elf_out, elf_opts),
+                                    dtor_all(&flags_objs);fist_dtor(&fist);interner_dtor(&labels);
     );
 
 
+    interner_dtor(&labels);
     fist_dtor(&fist);
     
     if (dtor_all(&flags_objs))
@@ -0,0 +1,330 @@
+#include <stdint.h>
+
+#include "utils/utils.h"
+#include "ir_fist/structs.h"
+#include "ir_fist/funcs/funcs.h"
+#include "branch.h"
+
+// Branch lowering looks at the blocks in list order:
+// - comparison, whose tmp is read only by the jump right after it, is fused with it to cmp + jcc,
+// - jump on constant becomes jmp or disappears,
+// - jump to the label, that is followed by jmp, goes to the target of that jmp,
+// - jump to the label right after it disappears, and jcc over jmp to such label is inverted.
+
+#define THREAD_DEPTH_MAX_   64
+#define NO_POS_             SIZE_MAX
+
+typedef struct BranchScratch
+{
+    size_t blocks_cnt;
+    size_t* elem_inds;      // by pos in list
+    size_t* tmp_uses;
+    size_t labels_cnt;
+    size_t* label_poses;    // by label_num, NO_POS_ - label isn't in the list
+} branch_scratch_t;
+
+#define BLOCK_(pos_)    ((const ir_block_t*)fist->data + scratch->elem_inds[pos_])
+#define BRANCH_(pos_)   (branches->blocks + scratch->elem_inds[pos_])
+
+static size_t label_pos_(const branch_scratch_t* const scratch, const size_t label_num)
+{
+    lassert(!is_invalid_ptr(scratch), "");
+    lassert(label_num < scratch->labels_cnt, "");
+
+    return scratch->label_poses[label_num];
+}
+
+static bool is_jmp_block_(const ir_block_t* const block)
+{
+    lassert(!is_invalid_ptr(block), "");
+
+    return block->type == IR_OP_BLOCK_TYPE_COND_JUMP
+        && block->operand1_type == IR_OPERAND_TYPE_NUM
+        && block->operand1_num;
+}
+
+// first pos, from which some code is emitted
+static size_t run_end_(const branches_t* const branches, const fist_t* const fist,
+                       const branch_scratch_t* const scratch, size_t pos)
+{
+    lassert(!is_invalid_ptr(branches), "");
+    lassert(!is_invalid_ptr(scratch), "");
+
+    while (pos < scratch->blocks_cnt
+        && (BLOCK_(pos)->type == IR_OP_BLOCK_TYPE_LABEL || BRANCH_(pos)->kind == BRANCH_KIND_SKIP))
+    {
+        ++pos;
+    }
+
+    return pos;
+}
+
+// jump from pos to target is the same as going on to the next block
+static bool is_fall_through_(const branches_t* const branches, const fist_t* const fist,
+                             const branch_scratch_t* const scratch, const size_t pos,
+                             const size_t target)
+{
+    lassert(!is_invalid_ptr(branches), "");
+    lassert(!is_invalid_ptr(scratch), "");
+
+    const size_t target_pos = label_pos_(scratch, target);
+
+    return target_pos != NO_POS_
+        && target_pos > pos
+        && target_pos < run_end_(branches, fist, scratch, pos + 1);
+}
+
+static size_t thread_target_(const branches_t* const branches, const fist_t* const fist,
+                             const branch_scratch_t* const scratch, size_t target)
+{
+    lassert(!is_invalid_ptr(branches), "");
+    lassert(!is_invalid_ptr(scratch), "");
+
+    for (size_t depth = 0; depth < THREAD_DEPTH_MAX_; ++depth)
+    {
+        const size_t pos = label_pos_(scratch, target);
+        if (pos == NO_POS_)
+            break;
+
+        const size_t landing = run_end_(branches, fist, scratch, pos);
+        if (landing == scratch->blocks_cnt || !is_jmp_block_(BLOCK_(landing)))
+            break;
+
+        target = BLOCK_(landing)->label_num;
+    }
+
+    return target;
+}
+
+static bool cmp_jcc_(const enum IrOpType operation, enum OpCode* const jcc)
+{
+    lassert(!is_invalid_ptr(jcc), "");
+
+    switch (operation)
+    {
+        case IR_OP_TYPE_EQ:         *jcc = OP_CODE_JE;  return true;
+        case IR_OP_TYPE_NEQ:        *jcc = OP_CODE_JNE; return true;
+        case IR_OP_TYPE_LESS:       *jcc = OP_CODE_JL;  return true;
+        case IR_OP_TYPE_LESSEQ:     *jcc = OP_CODE_JLE; return true;
+        case IR_OP_TYPE_GREAT:      *jcc = OP_CODE_JG;  return true;
+        case IR_OP_TYPE_GREATEQ:    *jcc = OP_CODE_JGE; return true;
+
+        case IR_OP_TYPE_SUM:
+        case IR_OP_TYPE_SUB:
+        case IR_OP_TYPE_MUL:
+        case IR_OP_TYPE_DIV:
+        case IR_OP_TYPE_INVALID_OPERATION:
+        default:
+            return false;
+    }
+
+    return false;
+}
+
+// jcc opcodes go in pairs, that differ only in the lowest bit
+static enum OpCode invert_jcc_(const enum OpCode jcc)
+{
+    return (enum OpCode)(jcc ^ 1);
+}
+
+static void lower_jumps_(branches_t* const branches, const fist_t* const fist,
+                         const branch_scratch_t* const scratch)
+{
+    lassert(!is_invalid_ptr(branches), "");
+    lassert(!is_invalid_ptr(scratch), "");
+
+    for (size_t pos = 0; pos < scratch->blocks_cnt; ++pos)
+    {
+        const ir_block_t* const block = BLOCK_(pos);
+        branch_block_t* const branch = BRANCH_(pos);
+
+        if (block->type == IR_OP_BLOCK_TYPE_OPERATION)
+        {
+            enum OpCode jcc = OP_CODE_JNE;
+            if (pos + 1 < scratch->blocks_cnt
+             && cmp_jcc_(block->operation_num, &jcc)
+             && scratch->tmp_uses[block->ret_num] == 1
+             && BLOCK_(pos + 1)->type == IR_OP_BLOCK_TYPE_COND_JUMP
+             && BLOCK_(pos + 1)->operand1_type == IR_OPERAND_TYPE_TMP
+             && BLOCK_(pos + 1)->operand1_num == block->ret_num)
+            {
+                *branch = (branch_block_t){.kind = BRANCH_KIND_CMP, .jcc = jcc, .target = 0};
+            }
+            continue;
+        }
+
+        if (block->type != IR_OP_BLOCK_TYPE_COND_JUMP)
+            continue;
+
+        branch->target = block->label_num;
+
+        if (block->operand1_type == IR_OPERAND_TYPE_NUM)
+        {
+            branch->kind = block->operand1_num ? BRANCH_KIND_JMP : BRANCH_KIND_SKIP;
+        }
+        else if (pos && BRANCH_(pos - 1)->kind == BRANCH_KIND_CMP)
+        {
+            branch->kind = BRANCH_KIND_JCC;
+            branch->jcc  = BRANCH_(pos - 1)->jcc;
+        }
+        else
+        {
+            branch->kind = BRANCH_KIND_TEST;
+            branch->jcc  = OP_CODE_JNE;
+        }
+    }
+
+    for (size_t pos = 0; pos < scratch->blocks_cnt; ++pos)
+    {
+        branch_block_t* const branch = BRANCH_(pos);
+
+        if (branch->kind == BRANCH_KIND_JMP || branch->kind == BRANCH_KIND_JCC
+         || branch->kind == BRANCH_KIND_TEST)
+            branch->target = thread_target_(branches, fist, scratch, branch->target);
+    }
+
+    // from the end, so blocks after pos are already final
+    for (size_t pos = scratch->blocks_cnt; pos--; )
+    {
+        branch_block_t* const branch = BRANCH_(pos);
+
+        if (branch->kind == BRANCH_KIND_JMP && is_fall_through_(branches, fist, scratch, pos, branch->target))
+        {
+            branch->kind = BRANCH_KIND_SKIP;
+            continue;
+        }
+
+        if (branch->kind != BRANCH_KIND_JCC && branch->kind != BRANCH_KIND_TEST)
+            continue;
+
+        branch_block_t* const next = (pos + 1 < scratch->blocks_cnt) ? BRANCH_(pos + 1) : NULL;
+        if (next && next->kind == BRANCH_KIND_JMP
+         && is_fall_through_(branches, fist, scratch, pos + 1, branch->target))
+        {
+            // TEST has to stay, as in stack mode it pops the condition
+            branch->jcc    = invert_jcc_(branch->jcc);
+            branch->target = next->target;
+            next->kind     = BRANCH_KIND_SKIP;
+        }
+
+        if (branch->kind == BRANCH_KIND_JCC && is_fall_through_(branches, fist, scratch, pos, branch->target))
+        {
+            branch->kind = BRANCH_KIND_SKIP;
+        }
+    }
+}
+
+#undef BLOCK_
+#undef BRANCH_
+
+#define CUR_BLOCK_ ((const ir_block_t*)fist->data + elem_ind)
+
+static void branch_scratch_dtor_(branch_scratch_t* const scratch)
+{
+    lassert(!is_invalid_ptr(scratch), "");
+
+    free(scratch->elem_inds);   IF_DEBUG(scratch->elem_inds = NULL;)
+    free(scratch->tmp_uses);    IF_DEBUG(scratch->tmp_uses  = NULL;)
+    free(scratch->label_poses); IF_DEBUG(scratch->label_poses = NULL;)
+}
+
+static enum TranslationError branch_scratch_ctor_(branch_scratch_t* const scratch,
+                                                  branches_t* const branches, const fist_t* const fist)
+{
+    lassert(!is_invalid_ptr(scratch), "");
+    lassert(!is_invalid_ptr(branches), "");
+
+    size_t tmps_cnt = 0;
+    for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind])
+    {
+        ++scratch->blocks_cnt;
+        branches->blocks_cnt = MAX(branches->blocks_cnt, elem_ind + 1);
+
+        size_t used[2] = {};
+        const size_t used_cnt = ir_block_use_tmps(CUR_BLOCK_, used);
+        for (size_t used_ind = 0; used_ind < used_cnt; ++used_ind)
+        {
+            tmps_cnt = MAX(tmps_cnt, used[used_ind] + 1);
+        }
+
+        if (CUR_BLOCK_->type == IR_OP_BLOCK_TYPE_OPERATION)
+            tmps_cnt = MAX(tmps_cnt, CUR_BLOCK_->ret_num + 1);
+
+        if (CUR_BLOCK_->label_type == IR_OPERAND_TYPE_LABEL)
+            scratch->labels_cnt = MAX(scratch->labels_cnt, CUR_BLOCK_->label_num + 1);
+    }
+
+    branches->blocks     = calloc(branches->blocks_cnt + 1,  sizeof(*branches->blocks));
+    scratch->elem_inds   = calloc(scratch->blocks_cnt + 1,   sizeof(*scratch->elem_inds));
+    scratch->tmp_uses    = calloc(tmps_cnt + 1,              sizeof(*scratch->tmp_uses));
+    scratch->label_poses = calloc(scratch->labels_cnt + 1,   sizeof(*scratch->label_poses));
+
+    if (!branches->blocks || !scratch->elem_inds || !scratch->tmp_uses || !scratch->label_poses)
+    {
+        perror("Can't calloc branches arrays");
+        branch_scratch_dtor_(scratch);
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    for (size_t label_num = 0; label_num < scratch->labels_cnt; ++label_num)
+    {
+        scratch->label_poses[label_num] = NO_POS_;
+    }
+
+    size_t pos = 0;
+    for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind], ++pos)
+    {
+        scratch->elem_inds[pos] = elem_ind;
+
+        size_t used[2] = {};
+        const size_t used_cnt = ir_block_use_tmps(CUR_BLOCK_, used);
+        for (size_t used_ind = 0; used_ind < used_cnt; ++used_ind)
+        {
+            ++scratch->tmp_uses[used[used_ind]];
+        }
+
+        if (CUR_BLOCK_->type == IR_OP_BLOCK_TYPE_LABEL)
+            scratch->label_poses[CUR_BLOCK_->label_num] = pos;
+    }
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+#undef CUR_BLOCK_
+
+enum TranslationError branches_ctor(branches_t* const branches, const fist_t* const fist)
+{
+    lassert(!is_invalid_ptr(branches), "");
+    FIST_VERIFY_ASSERT(fist, NULL);
+
+    branches->blocks_cnt = 0;
+    branches->blocks     = NULL;
+
+    branch_scratch_t scratch = {};
+    TRANSLATION_ERROR_HANDLE(branch_scratch_ctor_(&scratch, branches, fist),
+                                                                        branches_dtor(branches););
+
+    lower_jumps_(branches, fist, &scratch);
+
+    branch_scratch_dtor_(&scratch);
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+void branches_dtor(branches_t* const branches)
+{
+    lassert(!is_invalid_ptr(branches), "");
+
+    free(branches->blocks); IF_DEBUG(branches->blocks = NULL;)
+}
+
+const branch_block_t* branches_get(const branches_t* const branches, const size_t elem_ind)
+{
+    lassert(!is_invalid_ptr(branches), "");
+    lassert(elem_ind < branches->blocks_cnt, "");
+
+    return branches->blocks + elem_ind;
+}
+
+#undef THREAD_DEPTH_MAX_
+#undef NO_POS_
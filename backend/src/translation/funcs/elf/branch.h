@@ -0,0 +1,37 @@
+#ifndef MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_BRANCH_H
+#define MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_BRANCH_H
+
+#include "hash_table/libs/list_on_array/libfist.h"
+#include "translation/funcs/elf/structs.h"
+#include "translation/verification/verification.h"
+#include "write_lib.h"
+
+enum BranchKind
+{
+    BRANCH_KIND_NONE    = 0, // block is translated as is
+    BRANCH_KIND_SKIP    = 1, // nothing is emitted
+    BRANCH_KIND_CMP     = 2, // comparison only sets flags for the jcc right after it
+    BRANCH_KIND_JCC     = 3, // jcc on flags of the comparison right before it
+    BRANCH_KIND_TEST    = 4, // test of the condition tmp, then jcc
+    BRANCH_KIND_JMP     = 5,
+};
+
+typedef struct BranchBlock
+{
+    enum BranchKind kind;
+    enum OpCode jcc;
+    size_t target; // label_num after threading
+} branch_block_t;
+
+typedef struct Branches
+{
+    size_t blocks_cnt;
+    branch_block_t* blocks; // by fist elem ind
+} branches_t;
+
+enum TranslationError branches_ctor(branches_t* const branches, const fist_t* const fist);
+void                  branches_dtor(branches_t* const branches);
+
+const branch_block_t* branches_get(const branches_t* const branches, const size_t elem_ind);
+
+#endif /*MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_BRANCH_H*/
@@ -0,0 +1,63 @@
+#include "utils/utils.h"
+#include "ir_fist/structs.h"
+#include "callconv.h"
+
+// Functions take the first args in registers in System V order, the rest stay on the stack, where
+// the caller pushed them, and are removed by it. Result is in rax. Callee keeps rbp, rsp and
+// r12-r15 (saved by regalloc), every other register is clobbered by calls.
+//
+// Call block doesn't keep the count of args, so it is taken from the body of the callee.
+
+static const enum RegNum kARG_REGS_[CALLCONV_REG_ARGS_CNT] =
+{
+    REG_NUM_RDI, REG_NUM_RSI, REG_NUM_RDX, REG_NUM_RCX, REG_NUM_R8, REG_NUM_R9
+};
+
+#define CUR_BLOCK_ ((const ir_block_t*)fist->data + elem_ind)
+
+enum TranslationError callconv_ctor(callconv_t* const callconv, const fist_t* const fist,
+                                    const size_t labels_cnt)
+{
+    lassert(!is_invalid_ptr(callconv), "");
+    FIST_VERIFY_ASSERT(fist, NULL);
+
+    callconv->labels_cnt = labels_cnt;
+    callconv->args_cnts = calloc(labels_cnt + 1, sizeof(*callconv->args_cnts));
+    if (!callconv->args_cnts)
+    {
+        perror("Can't calloc callconv->args_cnts");
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind])
+    {
+        if (CUR_BLOCK_->type == IR_OP_BLOCK_TYPE_FUNCTION_BODY && CUR_BLOCK_->label_num < labels_cnt)
+            callconv->args_cnts[CUR_BLOCK_->label_num] = CUR_BLOCK_->operand1_num;
+    }
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+#undef CUR_BLOCK_
+
+void callconv_dtor(callconv_t* const callconv)
+{
+    lassert(!is_invalid_ptr(callconv), "");
+
+    free(callconv->args_cnts); IF_DEBUG(callconv->args_cnts = NULL;)
+}
+
+size_t callconv_args_cnt(const callconv_t* const callconv, const size_t label_num)
+{
+    lassert(!is_invalid_ptr(callconv), "");
+    lassert(label_num < callconv->labels_cnt, "");
+
+    return callconv->args_cnts[label_num];
+}
+
+enum RegNum callconv_arg_reg(const size_t arg_ind)
+{
+    lassert(arg_ind < CALLCONV_REG_ARGS_CNT, "");
+
+    return kARG_REGS_[arg_ind];
+}
\ No newline at end of file
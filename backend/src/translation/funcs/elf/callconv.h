@@ -0,0 +1,25 @@
+#ifndef MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_CALLCONV_H
+#define MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_CALLCONV_H
+
+#include "hash_table/libs/list_on_array/libfist.h"
+#include "translation/funcs/elf/structs.h"
+#include "translation/verification/verification.h"
+#include "write_lib.h"
+
+#define CALLCONV_REG_ARGS_CNT   (6)
+#define CALLCONV_RED_ZONE_SIZE  (128)
+
+typedef struct CallConv
+{
+    size_t labels_cnt;
+    size_t* args_cnts; // by label_num of function body
+} callconv_t;
+
+enum TranslationError callconv_ctor(callconv_t* const callconv, const fist_t* const fist,
+                                    const size_t labels_cnt);
+void                  callconv_dtor(callconv_t* const callconv);
+
+size_t      callconv_args_cnt(const callconv_t* const callconv, const size_t label_num);
+enum RegNum callconv_arg_reg (const size_t arg_ind);
+
+#endif /*MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_CALLCONV_H*/
\ No newline at end of file
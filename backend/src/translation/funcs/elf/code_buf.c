@@ -0,0 +1,70 @@
+#include <string.h>
+
+#include "utils/utils.h"
+#include "code_buf.h"
+
+enum TranslationError code_buf_ctor(code_buf_t* const buf, const size_t capacity)
+{
+    lassert(!is_invalid_ptr(buf), "");
+    lassert(capacity, "");
+
+    buf->data = calloc(capacity, sizeof(*buf->data));
+    if (!buf->data)
+    {
+        perror("Can't calloc buf->data");
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    buf->size = 0;
+    buf->capacity = capacity;
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+void code_buf_dtor(code_buf_t* const buf)
+{
+    lassert(!is_invalid_ptr(buf), "");
+
+    free(buf->data); IF_DEBUG(buf->data = NULL;)
+    buf->size = 0;
+    buf->capacity = 0;
+}
+
+static enum TranslationError code_buf_grow_(code_buf_t* const buf, const size_t min_capacity)
+{
+    lassert(!is_invalid_ptr(buf), "");
+
+    size_t capacity = buf->capacity;
+    while (capacity < min_capacity)
+    {
+        capacity *= 2;
+    }
+
+    uint8_t* const data = realloc(buf->data, capacity * sizeof(*buf->data));
+    if (!data)
+    {
+        perror("Can't realloc buf->data");
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    buf->data = data;
+    buf->capacity = capacity;
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+enum TranslationError code_buf_append(code_buf_t* const buf, const void* const bytes, const size_t size)
+{
+    lassert(!is_invalid_ptr(buf), "");
+    lassert(!size || !is_invalid_ptr(bytes), "");
+
+    if (buf->size + size > buf->capacity)
+    {
+        TRANSLATION_ERROR_HANDLE(code_buf_grow_(buf, buf->size + size));
+    }
+
+    memcpy(buf->data + buf->size, bytes, size);
+    buf->size += size;
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,22 @@
+#ifndef MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_CODE_BUF_H
+#define MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_CODE_BUF_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#include "translation/verification/verification.h"
+
+// text of the program, grows twice, when it is full
+typedef struct CodeBuf
+{
+    uint8_t* data;
+    size_t size;
+    size_t capacity;
+} code_buf_t;
+
+enum TranslationError code_buf_ctor(code_buf_t* const buf, const size_t capacity);
+void                  code_buf_dtor(code_buf_t* const buf);
+
+enum TranslationError code_buf_append(code_buf_t* const buf, const void* const bytes, const size_t size);
+
+#endif /*MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_CODE_BUF_H*/
\ No newline at end of file
@@ -1,3 +1,4 @@
+#include <stdint.h>
 #include <unistd.h>
 #include <elf.h>
 
@@ -7,10 +8,14 @@
 #include "ir_fist/funcs/funcs.h"
 #include "ir_fist/structs.h"
 #include "translation/funcs/elf/structs.h"
-#include "map_utils.h"
 #include "write_lib.h"
 #include "labels.h"
 #include "headers.h"
+#include "regalloc.h"
+#include "branch.h"
+#include "imm.h"
+#include "relax.h"
+#include "callconv.h"
 
 #define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
     do {                                                                                            \
@@ -24,63 +29,103 @@
         }                                                                                           \
     } while(0)
 
-#define STACK_CODE_BEGIN_CAPACITY_ 5000
-#define SMASH_MAP_SIZE_ 101
-static enum TranslationError translator_ctor_(elf_translator_t* const translator)
+static const char* const kRUNTIME_LABEL_NAMES[RUNTIME_LABELS_CNT] =
+{
+    [RUNTIME_LABEL_BSS]         = "bss",
+    [RUNTIME_LABEL_OUT_FLUSH]   = "out_flush",
+    [RUNTIME_LABEL_OUT_DIGITS]  = "out_digits",
+    [RUNTIME_LABEL_MEMO_SLOT]   = "memo_slot",
+    [RUNTIME_LABEL_HLT]         = "hlt",
+    [RUNTIME_LABEL_IN]          = "in",
+    [RUNTIME_LABEL_OUT]         = "out",
+    [RUNTIME_LABEL_POW]         = "pow",
+    [RUNTIME_LABEL_MEMO_GET]    = MEMO_GET_NAME,
+    [RUNTIME_LABEL_MEMO_VAL]    = MEMO_VAL_NAME,
+    [RUNTIME_LABEL_MEMO_PUT]    = MEMO_PUT_NAME,
+};
+
+#define CODE_BEGIN_CAPACITY_ 0x10000
+static enum TranslationError translator_ctor_(elf_translator_t* const translator, interner_t* const labels)
 {
     lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(labels), "");
 
-    SMASH_MAP_ERROR_HANDLE_(
-        SMASH_MAP_CTOR(
-            &translator->labels_map, 
-            SMASH_MAP_SIZE_, 
-            sizeof(label_t), 
-            sizeof(labels_val_t), 
-            func_hash_func,
-            map_key_to_str,
-            map_val_to_str
-        )
-    );
+    // syscalls of ir are already there, so the runtime gets the same label_num
+    for (size_t runtime_label = 0; runtime_label < RUNTIME_LABELS_CNT; ++runtime_label)
+    {
+        if (ir_label_intern(labels, kRUNTIME_LABEL_NAMES[runtime_label],
+                            translator->runtime_labels + runtime_label))
+        {
+            fprintf(stderr, "Can't intern runtime label '%s'\n", kRUNTIME_LABEL_NAMES[runtime_label]);
+            return TRANSLATION_ERROR_INTERNER;
+        }
+    }
+
+    translator->labels      = labels;
+    translator->labels_cnt  = labels->size;
+    translator->label_addrs = calloc(translator->labels_cnt, sizeof(*translator->label_addrs));
+    if (!translator->label_addrs)
+    {
+        perror("Can't calloc translator->label_addrs");
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    TRANSLATION_ERROR_HANDLE(code_buf_ctor(&translator->text, CODE_BEGIN_CAPACITY_),
+                                                                free(translator->label_addrs););
 
-    STACK_ERROR_HANDLE_(STACK_CTOR(&translator->text, sizeof(uint8_t), STACK_CODE_BEGIN_CAPACITY_));
+    STACK_ERROR_HANDLE_(STACK_CTOR(&translator->fixups, sizeof(label_fixup_t), 1),
+                                free(translator->label_addrs); code_buf_dtor(&translator->text););
 
-    STACK_ERROR_HANDLE_(STACK_CTOR(&translator->labels_stack, sizeof(label_t), 1));
+    STACK_ERROR_HANDLE_(STACK_CTOR(&translator->jumps, sizeof(relax_jump_t), 1),
+                                free(translator->label_addrs); code_buf_dtor(&translator->text);
+                                stack_dtor(&translator->fixups););
 
     translator->cur_block = NULL;
+    translator->next_block = NULL;
+    translator->regalloc = NULL;
+    translator->branches = NULL;
+    translator->cur_branch = NULL;
+    translator->callconv = NULL;
+
+    translator->has_frame = true;
+    translator->is_arg_in_reg = false;
 
     translator->cur_addr = ENTRY_ADDR_;
 
     return TRANSLATION_ERROR_SUCCESS;
 }
-#undef SMASH_MAP_SIZE_
-#undef STACK_CODE_BEGIN_CAPACITY_
+#undef CODE_BEGIN_CAPACITY_
 
 static void translator_dtor_(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    for (size_t label_ind = 0; label_ind < stack_size(translator->labels_stack); ++label_ind)
-    {
-        label_t* label_key = stack_get(translator->labels_stack, label_ind);
-        
-        labels_val_t* labels_val = smash_map_get_val(&translator->labels_map, label_key);
-
-        stack_dtor(&labels_val->insert_addrs);
-    }
-    
-    smash_map_dtor(&translator->labels_map);
-    
-    stack_dtor(&translator->labels_stack);
-    stack_dtor(&translator->text);
+    free(translator->label_addrs); IF_DEBUG(translator->label_addrs = NULL;)
+    stack_dtor(&translator->fixups);
+    stack_dtor(&translator->jumps);
+    code_buf_dtor(&translator->text);
 }
 
+#define RUNTIME_LABEL_(name_) (translator->runtime_labels[RUNTIME_LABEL_##name_])
+
+#define FRAME_REG_ (translator->has_frame ? REG_NUM_RBP : REG_NUM_RSP)
+
 static enum TranslationError translate_text_(elf_translator_t* const translator, const fist_t* const fist);
+static enum TranslationError translate_bss_(elf_translator_t* const translator);
 
 static enum TranslationError translate_syscall_hlt_(elf_translator_t* const translator);
 static enum TranslationError translate_syscall_in_(elf_translator_t* const translator);
 static enum TranslationError translate_syscall_out_(elf_translator_t* const translator);
 static enum TranslationError translate_syscall_pow_(elf_translator_t* const translator);
 
+static enum TranslationError translate_out_flush_(elf_translator_t* const translator);
+static enum TranslationError translate_out_digits_(elf_translator_t* const translator);
+
+static enum TranslationError translate_memo_get_(elf_translator_t* const translator);
+static enum TranslationError translate_memo_val_(elf_translator_t* const translator);
+static enum TranslationError translate_memo_put_(elf_translator_t* const translator);
+static enum TranslationError translate_memo_slot_(elf_translator_t* const translator);
+
 
 #define IR_OP_BLOCK_HANDLE(num_, name_, ...)                                                        \
         static enum TranslationError translate_##name_(elf_translator_t* const translator);
@@ -90,39 +135,166 @@ static enum TranslationError translate_syscall_pow_(elf_translator_t* const tran
 #undef IR_OP_BLOCK_HANDLE
 
 
-enum TranslationError translate_elf(const fist_t* const fist, FILE* out)
+static enum TranslationError write_load_(elf_translator_t* const translator, const enum RegNum reg,
+                                         const location_t location)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    switch (location.type)
+    {
+        case LOCATION_TYPE_STACK:
+            return write_pop_r(translator, reg);
+        case LOCATION_TYPE_REG:
+            return location.reg == reg ? TRANSLATION_ERROR_SUCCESS 
+                                       : write_mov_r_r(translator, reg, location.reg);
+        case LOCATION_TYPE_FRAME:
+            return write_mov_r_irm(translator, reg, FRAME_REG_, location.offset);
+
+        case LOCATION_TYPE_NONE:
+        default:
+            fprintf(stderr, "Can't load operand without location\n");
+            return TRANSLATION_ERROR_INVALID_OPERAND;
+    }
+
+    return TRANSLATION_ERROR_INVALID_OPERAND;
+}
+
+static enum TranslationError write_store_(elf_translator_t* const translator, const location_t location,
+                                          const enum RegNum reg)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    switch (location.type)
+    {
+        case LOCATION_TYPE_STACK:
+            return write_push_r(translator, reg);
+        case LOCATION_TYPE_REG:
+            return location.reg == reg ? TRANSLATION_ERROR_SUCCESS 
+                                       : write_mov_r_r(translator, location.reg, reg);
+        case LOCATION_TYPE_FRAME:
+            return write_mov_irm_r(translator, FRAME_REG_, location.offset, reg);
+        case LOCATION_TYPE_NONE:
+            return TRANSLATION_ERROR_SUCCESS;
+
+        default:
+            fprintf(stderr, "Invalid location type\n");
+            return TRANSLATION_ERROR_INVALID_OPERAND;
+    }
+
+    return TRANSLATION_ERROR_INVALID_OPERAND;
+}
+
+// in stack mode the arg is already on the stack
+static enum TranslationError write_push_loc_(elf_translator_t* const translator, const location_t location)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    switch (location.type)
+    {
+        case LOCATION_TYPE_STACK:
+            return TRANSLATION_ERROR_SUCCESS;
+        case LOCATION_TYPE_REG:
+            return write_push_r(translator, location.reg);
+        case LOCATION_TYPE_FRAME:
+            return write_push_irm(translator, FRAME_REG_, location.offset);
+
+        case LOCATION_TYPE_NONE:
+        default:
+            fprintf(stderr, "Can't push operand without location\n");
+            return TRANSLATION_ERROR_INVALID_OPERAND;
+    }
+
+    return TRANSLATION_ERROR_INVALID_OPERAND;
+}
+
+#define TMP_LOC_(tmp_num_) regalloc_tmp(translator->regalloc, (tmp_num_))
+#define VAR_LOC_(var_num_) regalloc_var(translator->regalloc, (var_num_))
+
+
+enum TranslationError translate_elf(const fist_t* const fist, interner_t* const labels, FILE* out,
+                                    const elf_opts_t opts)
 {
     FIST_VERIFY_ASSERT(fist, NULL);
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
 
     elf_translator_t translator = {};
-    TRANSLATION_ERROR_HANDLE(translator_ctor_(&translator));
+    TRANSLATION_ERROR_HANDLE(translator_ctor_(&translator, labels));
+
+    regalloc_t regalloc = {};
+    TRANSLATION_ERROR_HANDLE(
+        regalloc_ctor(&regalloc, fist, opts.regalloc),
+        translator_dtor_(&translator);
+    );
+    translator.regalloc = &regalloc;
+
+    branches_t branches = {};
+    TRANSLATION_ERROR_HANDLE(
+        branches_ctor(&branches, fist),
+        translator_dtor_(&translator); regalloc_dtor(&regalloc);
+    );
+    translator.branches = &branches;
+
+    imms_t imms = {};
+    TRANSLATION_ERROR_HANDLE(
+        imms_ctor(&imms, fist),
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+    );
+    translator.imms = &imms;
+
+    callconv_t callconv = {};
+    TRANSLATION_ERROR_HANDLE(
+        callconv_ctor(&callconv, fist, translator.labels_cnt),
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+        imms_dtor(&imms);
+    );
+    translator.callconv = &callconv;
 
 
     TRANSLATION_ERROR_HANDLE(
         translate_text_(&translator, fist),
-        translator_dtor_(&translator);
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+        imms_dtor(&imms); callconv_dtor(&callconv);
+    );
+
+    TRANSLATION_ERROR_HANDLE(
+        relax_jumps(&translator, opts.report),
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+        imms_dtor(&imms); callconv_dtor(&callconv);
+    );
+
+    TRANSLATION_ERROR_HANDLE(
+        translate_bss_(&translator),
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+        imms_dtor(&imms); callconv_dtor(&callconv);
     );
 
     TRANSLATION_ERROR_HANDLE(
         labels_processing(&translator),
-        translator_dtor_(&translator);
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+        imms_dtor(&imms); callconv_dtor(&callconv);
     );
 
     elf_headers_t elf_headers = {};
 
     TRANSLATION_ERROR_HANDLE(
         elf_headers_ctor(&translator, &elf_headers),
-        translator_dtor_(&translator);
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+        imms_dtor(&imms); callconv_dtor(&callconv);
     );
 
     TRANSLATION_ERROR_HANDLE(
         write_elf(&translator, &elf_headers, out),
-        translator_dtor_(&translator);
+        translator_dtor_(&translator); regalloc_dtor(&regalloc); branches_dtor(&branches);
+        imms_dtor(&imms); callconv_dtor(&callconv);
     );
 
     translator_dtor_(&translator);
+    regalloc_dtor(&regalloc);
+    branches_dtor(&branches);
+    imms_dtor(&imms);
+    callconv_dtor(&callconv);
 
     return TRANSLATION_ERROR_SUCCESS;
 }
@@ -136,9 +308,19 @@ static enum TranslationError translate_text_(elf_translator_t* const translator,
 {
     lassert(!is_invalid_ptr(translator), "");
 
+    const regalloc_region_t* const top_region = regalloc_cur_region(translator->regalloc);
+    if (top_region && top_region->spills_cnt)
+    {
+        TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RBP, REG_NUM_RSP));
+        TRANSLATION_ERROR_HANDLE(write_sub_r_i(translator, REG_NUM_RSP, 8 * (int64_t)top_region->spills_cnt));
+    }
+
     for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind])
     {
         translator->cur_block = (ir_block_t*)fist->data + elem_ind;
+        translator->next_block = fist->next[elem_ind] ? (ir_block_t*)fist->data + fist->next[elem_ind] : NULL;
+        translator->cur_branch = branches_get(translator->branches, elem_ind);
+        translator->cur_imm = imms_get(translator->imms, elem_ind);
         switch (translator->cur_block->type)
         {
     
@@ -154,117 +336,543 @@ static enum TranslationError translate_text_(elf_translator_t* const translator,
     TRANSLATION_ERROR_HANDLE(translate_syscall_in_(translator));
     TRANSLATION_ERROR_HANDLE(translate_syscall_out_(translator));
     TRANSLATION_ERROR_HANDLE(translate_syscall_pow_(translator));
-
-    translator->cur_addr += ALIGN_ - translator->cur_addr % ALIGN_;
+    TRANSLATION_ERROR_HANDLE(translate_out_flush_(translator));
+    TRANSLATION_ERROR_HANDLE(translate_out_digits_(translator));
+    TRANSLATION_ERROR_HANDLE(translate_memo_get_(translator));
+    TRANSLATION_ERROR_HANDLE(translate_memo_val_(translator));
+    TRANSLATION_ERROR_HANDLE(translate_memo_put_(translator));
+    TRANSLATION_ERROR_HANDLE(translate_memo_slot_(translator));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
 #undef IR_OP_BLOCK_HANDLE
 
+// text size is final only after relax_jumps
+static enum TranslationError translate_bss_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    translator->cur_addr += ALIGN_ - translator->cur_addr % ALIGN_;
+
+    // bss segment starts right after the text one
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(BSS)));
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
 
 static enum TranslationError translate_CALL_FUNCTION(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    label_t func = {};
-    if (!strncpy(func.name, translator->cur_block->label_str, sizeof(func.name)))
+    const size_t args_cnt = callconv_args_cnt(translator->callconv, translator->cur_block->label_num);
+
+    if (args_cnt <= CALLCONV_REG_ARGS_CNT)
     {
-        perror("Can't strncpy block->label_str in func.name");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
+        // args are pushed in order, the last one is on the top
+        for (size_t arg_ind = args_cnt - translator->is_arg_in_reg; arg_ind > 0; --arg_ind)
+        {
+            TRANSLATION_ERROR_HANDLE(write_pop_r(translator, callconv_arg_reg(arg_ind - 1)));
+        }
+    }
+    else
+    {
+        for (size_t arg_ind = 0; arg_ind < CALLCONV_REG_ARGS_CNT; ++arg_ind)
+        {
+            TRANSLATION_ERROR_HANDLE(
+                write_mov_r_irm(translator, callconv_arg_reg(arg_ind), REG_NUM_RSP,
+                                8 * (int64_t)(args_cnt - 1 - arg_ind))
+            );
+        }
     }
+    translator->is_arg_in_reg = false;
 
-    // fprintf(stderr, "func_name: %s\n", func.name);
-    TRANSLATION_ERROR_HANDLE(add_not_handle_addr(translator, &func, translator->cur_addr + 1));
+    TRANSLATION_ERROR_HANDLE(
+        add_not_handle_addr(translator, translator->cur_block->label_num, translator->cur_addr + 1)
+    );
     TRANSLATION_ERROR_HANDLE(write_call_addr(translator, 0));
 
-    TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RAX));
+    if (args_cnt > CALLCONV_REG_ARGS_CNT)
+    {
+        TRANSLATION_ERROR_HANDLE(write_add_r_i(translator, REG_NUM_RSP, 8 * (int64_t)args_cnt));
+    }
+
+    TRANSLATION_ERROR_HANDLE(write_store_(translator, TMP_LOC_(translator->cur_block->ret_num), REG_NUM_RAX));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_FUNCTION_BODY(elf_translator_t* const translator)
+typedef struct RegMove
+{
+    enum RegNum dst;
+    enum RegNum src;
+} reg_move_t;
+
+// moves are done as if at once, rax breaks cycles
+static enum TranslationError write_reg_moves_(elf_translator_t* const translator,
+                                              reg_move_t* const moves, size_t moves_cnt)
 {
     lassert(!is_invalid_ptr(translator), "");
+    lassert(!moves_cnt || !is_invalid_ptr(moves), "");
 
-    label_t func = {};
-    if (!strncpy(func.name, translator->cur_block->label_str, sizeof(func.name)))
+    while (moves_cnt)
     {
-        perror("Can't strncpy translator->cur_block-label_str in func.name");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
+        size_t free_move = moves_cnt;
+        for (size_t move_ind = 0; move_ind < moves_cnt && free_move == moves_cnt; ++move_ind)
+        {
+            free_move = move_ind;
+            for (size_t other_ind = 0; other_ind < moves_cnt; ++other_ind)
+            {
+                if (other_ind != move_ind && moves[other_ind].src == moves[move_ind].dst)
+                {
+                    free_move = moves_cnt;
+                    break;
+                }
+            }
+        }
+
+        if (free_move == moves_cnt)
+        {
+            const enum RegNum busy = moves[0].dst;
+            TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RAX, busy));
+
+            for (size_t move_ind = 0; move_ind < moves_cnt; ++move_ind)
+            {
+                if (moves[move_ind].src == busy)
+                    moves[move_ind].src = REG_NUM_RAX;
+            }
+
+            continue;
+        }
+
+        if (moves[free_move].dst != moves[free_move].src)
+        {
+            TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, moves[free_move].dst, moves[free_move].src));
+        }
+
+        moves[free_move] = moves[--moves_cnt];
+    }
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+// arg var_ind is var var_ind, it is placed to the location of the var
+static enum TranslationError write_take_args_(elf_translator_t* const translator, const size_t args_cnt)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    reg_move_t moves[CALLCONV_REG_ARGS_CNT] = {};
+    size_t moves_cnt = 0;
+
+    for (size_t var_ind = 0; var_ind < MIN(args_cnt, CALLCONV_REG_ARGS_CNT); ++var_ind)
+    {
+        const location_t var = VAR_LOC_(var_ind);
+
+        if (var.type == LOCATION_TYPE_REG)
+        {
+            moves[moves_cnt++] = (reg_move_t){.dst = var.reg, .src = callconv_arg_reg(var_ind)};
+        }
+        else
+        {
+            TRANSLATION_ERROR_HANDLE(write_store_(translator, var, callconv_arg_reg(var_ind)));
+        }
+    }
+
+    TRANSLATION_ERROR_HANDLE(write_reg_moves_(translator, moves, moves_cnt));
+
+    // above the ret addr and the old rbp
+    for (size_t var_ind = CALLCONV_REG_ARGS_CNT; var_ind < args_cnt; ++var_ind)
+    {
+        const location_t var = VAR_LOC_(var_ind);
+        const enum RegNum var_reg = (var.type == LOCATION_TYPE_REG) ? var.reg : REG_NUM_RAX;
+
+        TRANSLATION_ERROR_HANDLE(
+            write_mov_r_irm(translator, var_reg, REG_NUM_RBP, 16 + 8 * (int64_t)(args_cnt - 1 - var_ind))
+        );
+        TRANSLATION_ERROR_HANDLE(write_store_(translator, var, var_reg));
     }
 
-    TRANSLATION_ERROR_HANDLE(add_label(translator, &func));
+    return TRANSLATION_ERROR_SUCCESS;
+}
 
-    TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RAX)); // save ret addr
-    TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RBX, REG_NUM_RBP)); // save old rbp
+// callee-saved regs of the function are kept in the frame right after spills
+static enum TranslationError write_saved_regs_(elf_translator_t* const translator, const bool is_restore)
+{
+    lassert(!is_invalid_ptr(translator), "");
 
-    // rbp = rsp + arg_cnt
-    TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RBP, REG_NUM_RSP));
-    TRANSLATION_ERROR_HANDLE(write_add_r_i(translator, REG_NUM_RBP, 8 * (int64_t)translator->cur_block->operand1_num));
+    const regalloc_region_t* const region = regalloc_cur_region(translator->regalloc);
 
-    // rsp = rbp - local_vars_cnt
-    TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RSP, REG_NUM_RBP));
-    TRANSLATION_ERROR_HANDLE(write_sub_r_i(translator, REG_NUM_RSP, 8 * (int64_t)translator->cur_block->operand2_num));
+    for (size_t saved_ind = 0; region && saved_ind < region->saved_cnt; ++saved_ind)
+    {
+        const int64_t offset = -8 * (int64_t)(region->locals_cnt + region->spills_cnt + saved_ind + 1);
 
-    TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RAX)); // ret addr
-    TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RBX)); // old rbp
+        if (is_restore)
+        {
+            TRANSLATION_ERROR_HANDLE(write_mov_r_irm(translator, region->saved_regs[saved_ind], FRAME_REG_, offset));
+        }
+        else
+        {
+            TRANSLATION_ERROR_HANDLE(write_mov_irm_r(translator, FRAME_REG_, offset, region->saved_regs[saved_ind]));
+        }
+    }
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
+static enum TranslationError translate_FUNCTION_BODY(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(add_label(translator, translator->cur_block->label_num));
+
+    regalloc_next_region(translator->regalloc);
+    const regalloc_region_t* const region = regalloc_cur_region(translator->regalloc);
+
+    const size_t args_cnt = translator->cur_block->operand1_num;
+    const size_t frame_size = translator->cur_block->operand2_num
+                            + (region ? region->spills_cnt + region->saved_cnt : 0);
+
+    // leaf function doesn't move rsp, its frame is in the red zone. Without regalloc tmps are pushed
+    translator->has_frame = !region || region->has_call || args_cnt > CALLCONV_REG_ARGS_CNT
+                         || 8 * frame_size > CALLCONV_RED_ZONE_SIZE;
+
+    if (translator->has_frame)
+    {
+        TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RBP));
+        TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RBP, REG_NUM_RSP));
+
+        if (frame_size)
+        {
+            TRANSLATION_ERROR_HANDLE(write_sub_r_i(translator, REG_NUM_RSP, 8 * (int64_t)frame_size));
+        }
+    }
+
+    TRANSLATION_ERROR_HANDLE(write_saved_regs_(translator, false));
+
+    return write_take_args_(translator, args_cnt);
+}
+
 static enum TranslationError translate_COND_JUMP(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    if (translator->cur_block->operand1_type == IR_OPERAND_TYPE_NUM)
+    const branch_block_t* const branch = translator->cur_branch;
+
+    if (branch->kind == BRANCH_KIND_SKIP)
+        return TRANSLATION_ERROR_SUCCESS;
+
+    if (branch->kind == BRANCH_KIND_JMP)
+        return write_label_jmp(translator, branch->target, OP_CODE_JMP);
+
+    // JCC uses flags of the cmp right before it
+    if (branch->kind == BRANCH_KIND_TEST)
     {
-        TRANSLATION_ERROR_HANDLE(write_mov_r_i(translator, REG_NUM_RBX, (int64_t)translator->cur_block->operand1_num));
+        const location_t cond = TMP_LOC_(translator->cur_block->operand1_num);
+        const enum RegNum cond_reg = (cond.type == LOCATION_TYPE_REG) ? cond.reg : REG_NUM_RBX;
+
+        TRANSLATION_ERROR_HANDLE(write_load_(translator, cond_reg, cond));
+        TRANSLATION_ERROR_HANDLE(write_test_r_r(translator, cond_reg, cond_reg));
     }
-    else
+
+    return write_label_jmp(translator, branch->target, branch->jcc);
+}
+
+// arg, that is given right before the call, goes straight to its register, others are pushed
+static bool is_last_reg_arg_(const elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    const ir_block_t* const next = translator->next_block;
+    if (!next || next->type != IR_OP_BLOCK_TYPE_CALL_FUNCTION)
+        return false;
+
+    const size_t args_cnt = callconv_args_cnt(translator->callconv, next->label_num);
+
+    return args_cnt <= CALLCONV_REG_ARGS_CNT && translator->cur_block->ret_num + 1 == args_cnt;
+}
+
+static enum TranslationError translate_ASSIGNMENT(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    const ir_block_t* const block = translator->cur_block;
+
+    if (block->ret_type == IR_OPERAND_TYPE_TMP && block->operand1_type == IR_OPERAND_TYPE_VAR)
     {
-        TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RBX));
+        const location_t tmp = TMP_LOC_(block->ret_num);
+        const location_t var = VAR_LOC_(block->operand1_num);
+
+        if (tmp.type == LOCATION_TYPE_STACK && var.type == LOCATION_TYPE_FRAME)
+        {
+            TRANSLATION_ERROR_HANDLE(write_push_irm(translator, FRAME_REG_, var.offset));
+        }
+        else if (tmp.type == LOCATION_TYPE_REG)
+        {
+            TRANSLATION_ERROR_HANDLE(write_load_(translator, tmp.reg, var));
+        }
+        else if (tmp.type != LOCATION_TYPE_NONE)
+        {
+            TRANSLATION_ERROR_HANDLE(write_load_(translator, REG_NUM_RBX, var));
+            TRANSLATION_ERROR_HANDLE(write_store_(translator, tmp, REG_NUM_RBX));
+        }
     }
+    else if (block->ret_type == IR_OPERAND_TYPE_TMP && block->operand1_type == IR_OPERAND_TYPE_NUM)
+    {
+        if (translator->cur_imm->kind == IMM_KIND_FOLDED)
+            return TRANSLATION_ERROR_SUCCESS;
+
+        const location_t tmp = TMP_LOC_(block->ret_num);
 
-    TRANSLATION_ERROR_HANDLE(write_test_r_r(translator, REG_NUM_RBX, REG_NUM_RBX));
+        const int64_t num = (int64_t)block->operand1_num;
 
-    label_t func = {};
-    if (!strncpy(func.name, translator->cur_block->label_str, sizeof(func.name)))
+        // push sign-extends imm32 only
+        if (tmp.type == LOCATION_TYPE_STACK && num >= INT32_MIN && num <= INT32_MAX)
+        {
+            TRANSLATION_ERROR_HANDLE(write_push_i(translator, num));
+        }
+        else if (tmp.type == LOCATION_TYPE_STACK)
+        {
+            TRANSLATION_ERROR_HANDLE(write_mov_r_i(translator, REG_NUM_RBX, num));
+            TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RBX));
+        }
+        else if (tmp.type == LOCATION_TYPE_REG)
+        {
+            TRANSLATION_ERROR_HANDLE(write_mov_r_i(translator, tmp.reg, num));
+        }
+        else if (tmp.type != LOCATION_TYPE_NONE)
+        {
+            TRANSLATION_ERROR_HANDLE(write_mov_r_i(translator, REG_NUM_RBX, num));
+            TRANSLATION_ERROR_HANDLE(write_store_(translator, tmp, REG_NUM_RBX));
+        }
+    }
+    else if (block->ret_type == IR_OPERAND_TYPE_VAR && block->operand1_type == IR_OPERAND_TYPE_TMP)
     {
-        perror("Can't strncpy block->label_str in func.name");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
+        const location_t tmp = TMP_LOC_(block->operand1_num);
+        const location_t var = VAR_LOC_(block->ret_num);
+
+        if (tmp.type == LOCATION_TYPE_STACK && var.type == LOCATION_TYPE_FRAME)
+        {
+            TRANSLATION_ERROR_HANDLE(write_pop_irm(translator, FRAME_REG_, var.offset));
+        }
+        else if (tmp.type == LOCATION_TYPE_REG)
+        {
+            TRANSLATION_ERROR_HANDLE(write_store_(translator, var, tmp.reg));
+        }
+        else
+        {
+            TRANSLATION_ERROR_HANDLE(write_load_(translator, REG_NUM_RBX, tmp));
+            TRANSLATION_ERROR_HANDLE(write_store_(translator, var, REG_NUM_RBX));
+        }
+    }
+    else if (block->ret_type == IR_OPERAND_TYPE_ARG && block->operand1_type == IR_OPERAND_TYPE_TMP)
+    {
+        if (is_last_reg_arg_(translator))
+        {
+            translator->is_arg_in_reg = true;
+            TRANSLATION_ERROR_HANDLE(
+                write_load_(translator, callconv_arg_reg(block->ret_num), TMP_LOC_(block->operand1_num))
+            );
+        }
+        else
+        {
+            TRANSLATION_ERROR_HANDLE(write_push_loc_(translator, TMP_LOC_(block->operand1_num)));
+        }
+    }
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static uint64_t abs_u64_(const int64_t num)
+{
+    return num < 0 ? -(uint64_t)num : (uint64_t)num;
+}
+
+// rbx *= factor
+static enum TranslationError write_mul_imm_(elf_translator_t* const translator, const int64_t factor)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    if (factor == 0)
+        return write_xor_r_r(translator, REG_NUM_RBX, REG_NUM_RBX);
+
+    const uint64_t abs_factor = abs_u64_(factor);
+    const int shift = __builtin_ctzll(abs_factor);
+    const uint64_t odd = abs_factor >> shift;
+
+    // factor is 1, 3, 5 or 9 shifted by some bits, so lea and shl do it
+    if (odd == 1 || odd == 3 || odd == 5 || odd == 9)
+    {
+        if (odd != 1)
+        {
+            const enum SIBScale scale = (odd == 3) ? SIB_SCALE2 : (odd == 5) ? SIB_SCALE4 : SIB_SCALE8;
+            TRANSLATION_ERROR_HANDLE(write_lea_r_rr(translator, REG_NUM_RBX, REG_NUM_RBX, REG_NUM_RBX, scale));
+        }
+
+        if (shift)
+        {
+            TRANSLATION_ERROR_HANDLE(write_shl_r_i(translator, REG_NUM_RBX, shift));
+        }
+
+        if (factor < 0)
+        {
+            TRANSLATION_ERROR_HANDLE(write_neg_r(translator, REG_NUM_RBX));
+        }
+
+        return TRANSLATION_ERROR_SUCCESS;
     }
 
-    TRANSLATION_ERROR_HANDLE(add_not_handle_addr(translator, &func, translator->cur_addr + 2));
-    TRANSLATION_ERROR_HANDLE(write_cond_jmp(translator, OP_CODE_JNE, 0));
+    if (factor >= INT32_MIN && factor <= INT32_MAX)
+        return write_imul_r_r_i(translator, REG_NUM_RBX, REG_NUM_RBX, factor);
+
+    TRANSLATION_ERROR_HANDLE(write_mov_r_i(translator, REG_NUM_RAX, factor));
+    TRANSLATION_ERROR_HANDLE(write_imul_r_r(translator, REG_NUM_RBX, REG_NUM_RAX));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_ASSIGNMENT(elf_translator_t* const translator)
+// Magic number and shift for signed division by the divisor, that isn't a power of 2 by modulo
+// (Hacker's Delight, 10-4): quotient is the high half of dividend * magic, shifted right.
+static void div_magic_(const int64_t divisor, int64_t* const magic, int64_t* const shift)
+{
+    lassert(!is_invalid_ptr(magic), "");
+    lassert(!is_invalid_ptr(shift), "");
+
+    const uint64_t two63        = 1ull << 63;
+    const uint64_t abs_divisor  = abs_u64_(divisor);
+    const uint64_t max_dividend = two63 + ((uint64_t)divisor >> 63);
+    const uint64_t abs_nc       = max_dividend - 1 - max_dividend % abs_divisor;
+
+    uint64_t q1 = two63 / abs_nc;
+    uint64_t r1 = two63 - q1 * abs_nc;
+    uint64_t q2 = two63 / abs_divisor;
+    uint64_t r2 = two63 - q2 * abs_divisor;
+    uint64_t delta = 0;
+
+    int64_t power = 63;
+    do {
+        ++power;
+
+        q1 *= 2;
+        r1 *= 2;
+        if (r1 >= abs_nc)
+        {
+            ++q1;
+            r1 -= abs_nc;
+        }
+
+        q2 *= 2;
+        r2 *= 2;
+        if (r2 >= abs_divisor)
+        {
+            ++q2;
+            r2 -= abs_divisor;
+        }
+
+        delta = abs_divisor - r2;
+    } while (q1 < delta || (q1 == delta && r1 == 0));
+
+    *magic = (int64_t)(q2 + 1);
+    if (divisor < 0)
+        *magic = -*magic;
+
+    *shift = power - 64;
+}
+
+// rbx /= divisor with rounding towards zero, as idiv does
+static enum TranslationError write_div_imm_(elf_translator_t* const translator, const int64_t divisor)
 {
     lassert(!is_invalid_ptr(translator), "");
+    lassert(divisor != 0, "");
+
+    const uint64_t abs_divisor = abs_u64_(divisor);
 
-    if (translator->cur_block->ret_type      == IR_OPERAND_TYPE_TMP 
-     && translator->cur_block->operand1_type == IR_OPERAND_TYPE_VAR)
+    if ((abs_divisor & (abs_divisor - 1)) == 0)
     {
-        TRANSLATION_ERROR_HANDLE(
-            write_push_irm(translator, REG_NUM_RBP, (int64_t)(-8 * ((int64_t)translator->cur_block->operand1_num + 1)))
-        );
+        const int shift = __builtin_ctzll(abs_divisor);
+
+        // negative dividend is biased by divisor - 1, so that sar rounds it towards zero
+        if (shift)
+        {
+            TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RAX, REG_NUM_RBX));
+            TRANSLATION_ERROR_HANDLE(write_sar_r_i(translator, REG_NUM_RAX, 63));
+            TRANSLATION_ERROR_HANDLE(write_shr_r_i(translator, REG_NUM_RAX, 64 - shift));
+            TRANSLATION_ERROR_HANDLE(write_add_r_r(translator, REG_NUM_RBX, REG_NUM_RAX));
+            TRANSLATION_ERROR_HANDLE(write_sar_r_i(translator, REG_NUM_RBX, shift));
+        }
+
+        if (divisor < 0)
+        {
+            TRANSLATION_ERROR_HANDLE(write_neg_r(translator, REG_NUM_RBX));
+        }
+
+        return TRANSLATION_ERROR_SUCCESS;
     }
-    else if (translator->cur_block->ret_type      == IR_OPERAND_TYPE_TMP 
-          && translator->cur_block->operand1_type == IR_OPERAND_TYPE_NUM)
+
+    int64_t magic = 0;
+    int64_t shift = 0;
+    div_magic_(divisor, &magic, &shift);
+
+    TRANSLATION_ERROR_HANDLE(write_mov_r_i(translator, REG_NUM_RAX, magic));
+    TRANSLATION_ERROR_HANDLE(write_imul_r(translator, REG_NUM_RBX));
+
+    if (divisor > 0 && magic < 0)
     {
-        TRANSLATION_ERROR_HANDLE(write_push_i(translator, (int64_t)translator->cur_block->operand1_num));
+        TRANSLATION_ERROR_HANDLE(write_add_r_r(translator, REG_NUM_RDX, REG_NUM_RBX));
     }
-    else if (translator->cur_block->ret_type      == IR_OPERAND_TYPE_VAR 
-          && translator->cur_block->operand1_type == IR_OPERAND_TYPE_TMP)
+    if (divisor < 0 && magic > 0)
     {
-        TRANSLATION_ERROR_HANDLE(
-            write_pop_irm(translator, REG_NUM_RBP, (int64_t)(-8 * ((int64_t)translator->cur_block->ret_num + 1)))
-        );
+        TRANSLATION_ERROR_HANDLE(write_sub_r_r(translator, REG_NUM_RDX, REG_NUM_RBX));
+    }
+
+    if (shift)
+    {
+        TRANSLATION_ERROR_HANDLE(write_sar_r_i(translator, REG_NUM_RDX, shift));
+    }
+
+    // quotient is rounded down, negative one is incremented
+    TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RBX, REG_NUM_RDX));
+    TRANSLATION_ERROR_HANDLE(write_shr_r_i(translator, REG_NUM_RDX, 63));
+    TRANSLATION_ERROR_HANDLE(write_add_r_r(translator, REG_NUM_RBX, REG_NUM_RDX));
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum TranslationError translate_imm_operation_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    const imm_block_t* const imm = translator->cur_imm;
+
+    TRANSLATION_ERROR_HANDLE(write_load_(translator, REG_NUM_RBX, TMP_LOC_(imm->tmp_num)));
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+
+    switch (translator->cur_block->operation_num)
+    {
+        case IR_OP_TYPE_SUM:
+            TRANSLATION_ERROR_HANDLE(write_add_r_i(translator, REG_NUM_RBX, imm->imm));
+            break;
+        case IR_OP_TYPE_SUB:
+            TRANSLATION_ERROR_HANDLE(write_sub_r_i(translator, REG_NUM_RBX, imm->imm));
+            break;
+        case IR_OP_TYPE_MUL:
+            TRANSLATION_ERROR_HANDLE(write_mul_imm_(translator, imm->imm));
+            break;
+        case IR_OP_TYPE_DIV:
+            TRANSLATION_ERROR_HANDLE(write_div_imm_(translator, imm->imm));
+            break;
+
+        default:
+            fprintf(stderr, "Invalid IR_OP_TYPE with imm\n");
+            return TRANSLATION_ERROR_INVALID_OP_TYPE;
     }
 
+#pragma GCC diagnostic pop
+
+    TRANSLATION_ERROR_HANDLE(write_store_(translator, TMP_LOC_(translator->cur_block->ret_num), REG_NUM_RBX));
+
     return TRANSLATION_ERROR_SUCCESS;
 }
 
@@ -272,72 +880,83 @@ static enum TranslationError translate_OPERATION(elf_translator_t* const transla
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RCX));
-    TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RBX));
+    if (translator->cur_imm->kind == IMM_KIND_OPERAND)
+        return translate_imm_operation_(translator);
+
+    // op2 is on the top of the stack
+    const location_t op2 = TMP_LOC_(translator->cur_block->operand2_num);
+    const enum RegNum op2_reg = (op2.type == LOCATION_TYPE_REG) ? op2.reg : REG_NUM_RCX;
+
+    TRANSLATION_ERROR_HANDLE(write_load_(translator, op2_reg, op2));
+    TRANSLATION_ERROR_HANDLE(write_load_(translator, REG_NUM_RBX, TMP_LOC_(translator->cur_block->operand1_num)));
+
+    // result is only read by the jcc right after it
+    if (translator->cur_branch->kind == BRANCH_KIND_CMP)
+        return write_cmp_r_r(translator, REG_NUM_RBX, op2_reg);
 
     switch(translator->cur_block->operation_num)
     {
         case IR_OP_TYPE_SUM:
         {
-            TRANSLATION_ERROR_HANDLE(write_add_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_add_r_r(translator, REG_NUM_RBX, op2_reg));
             break;
         }
         case IR_OP_TYPE_SUB:
         {
-            TRANSLATION_ERROR_HANDLE(write_sub_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_sub_r_r(translator, REG_NUM_RBX, op2_reg));
             break;
         }
         case IR_OP_TYPE_MUL:
         {
-            TRANSLATION_ERROR_HANDLE(write_imul_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_imul_r_r(translator, REG_NUM_RBX, op2_reg));
             break;
         }
         case IR_OP_TYPE_DIV:
         {
-            TRANSLATION_ERROR_HANDLE(write_xor_r_r(translator, REG_NUM_RDX, REG_NUM_RDX));
             TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RAX, REG_NUM_RBX));
-            TRANSLATION_ERROR_HANDLE(write_idiv_r(translator, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_cqo(translator));
+            TRANSLATION_ERROR_HANDLE(write_idiv_r(translator, op2_reg));
             TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RBX, REG_NUM_RAX));
             break;
         }
         case IR_OP_TYPE_EQ:
         {
-            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, op2_reg));
             TRANSLATION_ERROR_HANDLE(write_cond_set(translator, OP_CODE_SETE, REG_NUM_RBX)); //bl
             TRANSLATION_ERROR_HANDLE(write_movzx(translator, REG_NUM_RBX, REG_NUM_RBX)); // second reg - bl
             break;
         }
         case IR_OP_TYPE_NEQ:
         {
-            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, op2_reg));
             TRANSLATION_ERROR_HANDLE(write_cond_set(translator, OP_CODE_SETNE, REG_NUM_RBX)); //bl
             TRANSLATION_ERROR_HANDLE(write_movzx(translator, REG_NUM_RBX, REG_NUM_RBX)); // second reg - bl
             break;
         }
         case IR_OP_TYPE_LESS:
         {
-            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, op2_reg));
             TRANSLATION_ERROR_HANDLE(write_cond_set(translator, OP_CODE_SETL, REG_NUM_RBX)); //bl
             TRANSLATION_ERROR_HANDLE(write_movzx(translator, REG_NUM_RBX, REG_NUM_RBX)); // second reg - bl
             break;
         }
         case IR_OP_TYPE_LESSEQ:
         {
-            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, op2_reg));
             TRANSLATION_ERROR_HANDLE(write_cond_set(translator, OP_CODE_SETLE, REG_NUM_RBX)); //bl
             TRANSLATION_ERROR_HANDLE(write_movzx(translator, REG_NUM_RBX, REG_NUM_RBX)); // second reg - bl
             break;
         }
         case IR_OP_TYPE_GREAT:
         {
-            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, op2_reg));
             TRANSLATION_ERROR_HANDLE(write_cond_set(translator, OP_CODE_SETG, REG_NUM_RBX)); //bl
             TRANSLATION_ERROR_HANDLE(write_movzx(translator, REG_NUM_RBX, REG_NUM_RBX)); // second reg - bl
             break;
         }
         case IR_OP_TYPE_GREATEQ:
         {
-            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, REG_NUM_RCX));
+            TRANSLATION_ERROR_HANDLE(write_cmp_r_r(translator, REG_NUM_RBX, op2_reg));
             TRANSLATION_ERROR_HANDLE(write_cond_set(translator, OP_CODE_SETGE, REG_NUM_RBX)); //bl
             TRANSLATION_ERROR_HANDLE(write_movzx(translator, REG_NUM_RBX, REG_NUM_RBX)); // second reg - bl
             break;
@@ -351,7 +970,7 @@ static enum TranslationError translate_OPERATION(elf_translator_t* const transla
         }
     }
 
-    TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RBX));
+    TRANSLATION_ERROR_HANDLE(write_store_(translator, TMP_LOC_(translator->cur_block->ret_num), REG_NUM_RBX));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
@@ -360,14 +979,15 @@ static enum TranslationError translate_RETURN(elf_translator_t* const translator
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RAX)); // ret val
-    TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RBX)); // rbp val
-    TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RCX)); // ret addr
+    TRANSLATION_ERROR_HANDLE(write_load_(translator, REG_NUM_RAX, TMP_LOC_(translator->cur_block->ret_num))); // ret val
+    TRANSLATION_ERROR_HANDLE(write_saved_regs_(translator, true));
 
-    TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RSP, REG_NUM_RBP));
-    TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RBP, REG_NUM_RBX));
+    if (translator->has_frame)
+    {
+        TRANSLATION_ERROR_HANDLE(write_mov_r_r(translator, REG_NUM_RSP, REG_NUM_RBP));
+        TRANSLATION_ERROR_HANDLE(write_pop_r(translator, REG_NUM_RBP));
+    }
 
-    TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RCX));
     TRANSLATION_ERROR_HANDLE(write_ret(translator));
 
     return TRANSLATION_ERROR_SUCCESS;
@@ -376,14 +996,7 @@ static enum TranslationError translate_RETURN(elf_translator_t* const translator
 static enum TranslationError translate_LABEL(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
-    label_t func = {};
-    if (!strncpy(func.name, translator->cur_block->label_str, sizeof(func.name)))
-    {
-        perror("Can't strncpy translator->cur_block-label_str in func.name");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
-
-    TRANSLATION_ERROR_HANDLE(add_label(translator, &func));
+    TRANSLATION_ERROR_HANDLE(add_label(translator, translator->cur_block->label_num));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
@@ -392,21 +1005,16 @@ static enum TranslationError translate_SYSCALL(elf_translator_t* const translato
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    label_t func = {};
-    if (!strncpy(func.name, translator->cur_block->label_str, sizeof(func.name)))
-    {
-        perror("Can't strncpy block->label_str in func.name");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
-
-    TRANSLATION_ERROR_HANDLE(add_not_handle_addr(translator, &func, translator->cur_addr + 1));
+    TRANSLATION_ERROR_HANDLE(
+        add_not_handle_addr(translator, translator->cur_block->label_num, translator->cur_addr + 1)
+    );
     TRANSLATION_ERROR_HANDLE(write_call_addr(translator, 0));
 
     TRANSLATION_ERROR_HANDLE(write_add_r_i(translator, REG_NUM_RSP, 8 * (int64_t)translator->cur_block->operand1_num));
 
-    if (kIR_SYS_CALL_ARRAY[translator->cur_block->operand2_num].HaveRetVal)
+    if (ir_block_syscall_have_ret_val(translator->cur_block))
     {
-        TRANSLATION_ERROR_HANDLE(write_push_r(translator, REG_NUM_RAX)); // ret val
+        TRANSLATION_ERROR_HANDLE(write_store_(translator, TMP_LOC_(translator->cur_block->ret_num), REG_NUM_RAX)); // ret val
     }
 
     return TRANSLATION_ERROR_SUCCESS;
@@ -419,13 +1027,61 @@ static enum TranslationError translate_GLOBAL_VARS(elf_translator_t* const trans
     return TRANSLATION_ERROR_SUCCESS;
 }
 
+typedef struct RuntimeFixup
+{
+    enum RuntimeLabel label;
+    size_t offset;
+    uint32_t addend;
+} runtime_fixup_t;
+
+// runtime code is written as bytes, rel32 fields in it are filled in labels_processing.
+// Field keeps the addend, so bss label with BSS_* addend points to the runtime data
+static enum TranslationError write_runtime_(elf_translator_t* const translator, 
+                                            uint8_t* const bytes, const size_t bytes_size,
+                                            const runtime_fixup_t* const fixups, const size_t fixups_cnt)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(bytes), "");
+    lassert(!fixups_cnt || !is_invalid_ptr(fixups), "");
+
+    for (size_t fixup_ind = 0; fixup_ind < fixups_cnt; ++fixup_ind)
+    {
+        lassert(fixups[fixup_ind].offset + sizeof(uint32_t) <= bytes_size, "");
+
+        memcpy(bytes + fixups[fixup_ind].offset, &fixups[fixup_ind].addend, sizeof(uint32_t));
+
+        TRANSLATION_ERROR_HANDLE(
+            add_not_handle_addr(translator, translator->runtime_labels[fixups[fixup_ind].label],
+                                translator->cur_addr + fixups[fixup_ind].offset)
+        );
+    }
+
+    TRANSLATION_ERROR_HANDLE(write_arr_text(translator, bytes, bytes_size));
+
+    translator->cur_addr += bytes_size;
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum TranslationError write_call_out_flush_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(
+        add_not_handle_addr(translator, RUNTIME_LABEL_(OUT_FLUSH), translator->cur_addr + 1)
+    );
+    TRANSLATION_ERROR_HANDLE(write_call_addr(translator, 0));
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
 static enum TranslationError translate_syscall_hlt_(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    label_t func = {.name = "hlt"};
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(HLT)));
 
-    TRANSLATION_ERROR_HANDLE(add_label(translator, &func));
+    TRANSLATION_ERROR_HANDLE(write_call_out_flush_(translator));
 
     TRANSLATION_ERROR_HANDLE(write_mov_r_irm(translator, REG_NUM_RDI, REG_NUM_RSP, 8));
     TRANSLATION_ERROR_HANDLE(write_mov_r_i(translator, REG_NUM_RAX, 60));
@@ -434,160 +1090,292 @@ static enum TranslationError translate_syscall_hlt_(elf_translator_t* const tran
     return TRANSLATION_ERROR_SUCCESS;
 }
 
+// Input is read by IN_BUF_SIZE_ chunks into in_buf, that keeps the rest of the chunk for the
+// next calls. Number is optional sign and digits after whitespaces, it ends on the first
+// non-digit. Token without digits is skipped and read as 0, so is EOF.
 static enum TranslationError translate_syscall_in_(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    label_t func_out = {.name = "in"};
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(IN)));
 
-    TRANSLATION_ERROR_HANDLE(add_label(translator, &func_out));
+    // prompt, that is printed before reading, has to be seen
+    TRANSLATION_ERROR_HANDLE(write_call_out_flush_(translator));
 
     uint8_t bytes[] = 
     {
-        0xba, 0x20, 0x00, 0x00, 0x00,         // mov    $0x20,%edx
-        0x41, 0xba, 0x0a, 0x00, 0x00, 0x00,   // mov    $0xa,%r10d
-        0x48, 0x29, 0xd4,                     // sub    %rdx,%rsp
-        0x48, 0x89, 0xe6,                     // mov    %rsp,%rsi
-        0x48, 0x31, 0xc0,                     // xor    %rax,%rax
-        0x48, 0x31, 0xff,                     // xor    %rdi,%rdi
-        0x0f, 0x05,                           // syscall
-        0x48, 0x85, 0xc0,                     // test   %rax,%rax
-        0x7e, 0x48,                           // jle    4010c0 <in.ExitError>
-
-        0x48, 0x89, 0xc1,                     // mov    %rax,%rcx
-        0x48, 0xff, 0xc9,                     // dec    %rcx
-        0x48, 0x31, 0xc0,                     // xor    %rax,%rax
-        0x48, 0x31, 0xff,                     // xor    %rdi,%rdi
-        0x8a, 0x1e,                           // mov    (%rsi),%bl
-        0x80, 0xfb, 0x2d,                     // cmp    $0x2d,%bl
-        0x75, 0x0b,                           // jne    401096 <in.CheckDigit>
-        0x48, 0xff, 0xc7,                     // inc    %rdi
-        0x48, 0xff, 0xc6,                     // inc    %rsi
-        0x48, 0xff, 0xc9,                     // dec    %rcx
-        0x74, 0x2a,                           // je     4010c0 <in.ExitError>
-
-        // in.CheckDigit:
-        0x8a, 0x1e,                           // mov    (%rsi),%bl
-        0x80, 0xeb, 0x30,                     // sub    $0x30,%bl
-        0x80, 0xfb, 0x09,                     // cmp    $0x9,%bl
-        0x77, 0x20,                           // ja     4010c0 <in.ExitError>
-
-        // in.ConvertLoop:
-        0x8a, 0x1e,                           // mov    (%rsi),%bl
-        0x80, 0xeb, 0x30,                     // sub    $0x30,%bl
-        0x49, 0x0f, 0xaf, 0xc2,               // imul   %r10,%rax
-        0x48, 0x01, 0xd8,                     // add    %rbx,%rax
-        0x48, 0xff, 0xc6,                     // inc    %rsi
-        0x48, 0xff, 0xc9,                     // dec    %rcx
-        0x75, 0xec,                           // jne    4010a0 <in.ConvertLoop>
-
-        0x48, 0x85, 0xff,                     // test   %rdi,%rdi
-        0x74, 0x03,                           // je     4010bc <in.ExitSuccess>
-        0x48, 0xf7, 0xd8,                     // neg    %rax
-
-        // in.ExitSuccess:
-        0x48, 0x01, 0xd4,                     // add    %rdx,%rsp
-        0xc3,                                 // ret
-
-        // in.ExitError:
-        0x48, 0x01, 0xd4,                     // add    %rdx,%rsp
-        0x48, 0x31, 0xc0,                     // xor    %rax,%rax
-        0xc3                                  // ret
+        0x45, 0x31, 0xc0,                           // xor    %r8d,%r8d         (number)
+        0x45, 0x31, 0xc9,                           // xor    %r9d,%r9d         (is negative)
+        0x45, 0x31, 0xd2,                           // xor    %r10d,%r10d       (digits cnt)
+        0x48, 0x8d, 0x35, 0x00, 0x00, 0x00, 0x00,   // lea    in_buf(%rip),%rsi
+        0x48, 0x8b, 0x15, 0x00, 0x00, 0x00, 0x00,   // mov    in_pos(%rip),%rdx
+        0x48, 0x8b, 0x3d, 0x00, 0x00, 0x00, 0x00,   // mov    in_end(%rip),%rdi
+
+        // in.SkipSpaces:
+        0x48, 0x39, 0xfa,                           // cmp    %rdi,%rdx
+        0x72, 0x07,                                 // jb     in.CheckSpace
+        0xe8, 0x76, 0x00, 0x00, 0x00,               // call   in.Fill
+        0x74, 0x61,                                 // je     in.Exit
+
+        // in.CheckSpace:
+        0x80, 0x3c, 0x16, 0x20,                     // cmpb   $0x20,(%rsi,%rdx)
+        0x77, 0x05,                                 // ja     in.Sign
+        0x48, 0xff, 0xc2,                           // inc    %rdx
+        0xeb, 0xe9,                                 // jmp    in.SkipSpaces
+
+        // in.Sign:
+        0x0f, 0xb6, 0x04, 0x16,                     // movzbl (%rsi,%rdx),%eax
+        0x3c, 0x2b,                                 // cmp    $0x2b,%al
+        0x74, 0x07,                                 // je     in.SkipSign
+        0x3c, 0x2d,                                 // cmp    $0x2d,%al
+        0x75, 0x06,                                 // jne    in.Digits
+        0x41, 0xff, 0xc1,                           // inc    %r9d
+
+        // in.SkipSign:
+        0x48, 0xff, 0xc2,                           // inc    %rdx
+
+        // in.Digits:
+        0x48, 0x39, 0xfa,                           // cmp    %rdi,%rdx
+        0x72, 0x07,                                 // jb     in.Digit
+        0xe8, 0x4d, 0x00, 0x00, 0x00,               // call   in.Fill
+        0x74, 0x1c,                                 // je     in.NumberEnd
+
+        // in.Digit:
+        0x0f, 0xb6, 0x04, 0x16,                     // movzbl (%rsi,%rdx),%eax
+        0x83, 0xe8, 0x30,                           // sub    $0x30,%eax
+        0x83, 0xf8, 0x09,                           // cmp    $0x9,%eax
+        0x77, 0x10,                                 // ja     in.NumberEnd
+        0x4f, 0x8d, 0x04, 0x80,                     // lea    (%r8,%r8,4),%r8
+        0x4e, 0x8d, 0x04, 0x40,                     // lea    (%rax,%r8,2),%r8
+        0x41, 0xff, 0xc2,                           // inc    %r10d
+        0x48, 0xff, 0xc2,                           // inc    %rdx
+        0xeb, 0xd8,                                 // jmp    in.Digits
+
+        // in.NumberEnd:
+        0x45, 0x85, 0xd2,                           // test   %r10d,%r10d
+        0x75, 0x17,                                 // jne    in.Exit
+
+        // in.SkipToken:
+        0x48, 0x39, 0xfa,                           // cmp    %rdi,%rdx
+        0x72, 0x07,                                 // jb     in.CheckToken
+        0xe8, 0x20, 0x00, 0x00, 0x00,               // call   in.Fill
+        0x74, 0x0b,                                 // je     in.Exit
+
+        // in.CheckToken:
+        0x80, 0x3c, 0x16, 0x20,                     // cmpb   $0x20,(%rsi,%rdx)
+        0x76, 0x05,                                 // jbe    in.Exit
+        0x48, 0xff, 0xc2,                           // inc    %rdx
+        0xeb, 0xe9,                                 // jmp    in.SkipToken
+
+        // in.Exit:
+        0x48, 0x89, 0x15, 0x00, 0x00, 0x00, 0x00,   // mov    %rdx,in_pos(%rip)
+        0x4c, 0x89, 0xc0,                           // mov    %r8,%rax
+        0x45, 0x85, 0xc9,                           // test   %r9d,%r9d
+        0x74, 0x03,                                 // je     in.Ret
+        0x48, 0xf7, 0xd8,                           // neg    %rax
+
+        // in.Ret:
+        0xc3,                                       // ret
+
+        // in.Fill: rsi = in_buf, rdx = 0, rdi = bytes read, ZF on EOF or error
+        0x31, 0xc0,                                 // xor    %eax,%eax
+        0x31, 0xff,                                 // xor    %edi,%edi
+        0x48, 0x8d, 0x35, 0x00, 0x00, 0x00, 0x00,   // lea    in_buf(%rip),%rsi
+        0xba, 0x00, 0x00, 0x01, 0x00,               // mov    $0x10000,%edx
+        0x0f, 0x05,                                 // syscall
+        0x48, 0x85, 0xc0,                           // test   %rax,%rax
+        0x7f, 0x02,                                 // jg     in.Filled
+        0x31, 0xc0,                                 // xor    %eax,%eax
+
+        // in.Filled:
+        0x48, 0x89, 0xc7,                           // mov    %rax,%rdi
+        0x48, 0x89, 0x05, 0x00, 0x00, 0x00, 0x00,   // mov    %rax,in_end(%rip)
+        0x31, 0xd2,                                 // xor    %edx,%edx
+        0x48, 0x85, 0xff,                           // test   %rdi,%rdi
+        0xc3                                        // ret
     };
+    static_assert(IN_BUF_SIZE_ == 0x10000, "in_buf size is hardcoded in in bytes");
 
-    const size_t bytes_size = sizeof(bytes);
-
-    TRANSLATION_ERROR_HANDLE(write_arr_text(translator, bytes, bytes_size));
+    const runtime_fixup_t fixups[] =
+    {
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x0c, .addend = BSS_IN_BUF_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x13, .addend = BSS_IN_POS_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x1a, .addend = BSS_IN_END_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x8e, .addend = BSS_IN_POS_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0xa5, .addend = BSS_IN_BUF_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0xbd, .addend = BSS_IN_END_},
+    };
 
-    translator->cur_addr += bytes_size;
+    TRANSLATION_ERROR_HANDLE(write_runtime_(translator, bytes, sizeof(bytes),
+                                            fixups, sizeof(fixups) / sizeof(*fixups)));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
+// Number is formatted by two digits from out_digits table, division by 100 is done with
+// multiplication by reciprocal. Text is appended to out_buf, that is flushed only when it
+// can't hold one more number, on in and on hlt.
 static enum TranslationError translate_syscall_out_(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    label_t func_out = {.name = "out"};
-
-    TRANSLATION_ERROR_HANDLE(add_label(translator, &func_out));
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(OUT)));
 
     uint8_t bytes[] = 
     {
-        0x48, 0x8b, 0x44, 0x24, 0x08,      // mov    0x8(%rsp),%rax
-        0x41, 0xbb, 0x0a, 0x00, 0x00, 0x00, // mov    $0xa,%r11d
-        0x48, 0x89, 0xc7,                  // mov    %rax,%rdi
-        0x48, 0x31, 0xc9,                  // xor    %rcx,%rcx
-        0x48, 0xff, 0xcc,                  // dec    %rsp
-        0xc6, 0x04, 0x24, 0x0a,            // movb   $0xa,(%rsp)
-        0x48, 0xff, 0xc1,                  // inc    %rcx
-        0x48, 0x85, 0xc0,                  // test   %rax,%rax
-        0x78, 0x0e,                        // js     out.Negative
-        0x75, 0x0f,                        // jne    out.Convertion
-        0x48, 0xff, 0xcc,                  // dec    %rsp
-        0xc6, 0x04, 0x24, 0x30,            // movb   $0x30,(%rsp)
-        0x48, 0xff, 0xc1,                  // inc    %rcx
-        0xeb, 0x36,                        // jmp    out.Print
-    
-        // out.Negative:
-        0x48, 0xf7, 0xd8,                  // neg    %rax
-    
+        0x48, 0x8b, 0x3d, 0x00, 0x00, 0x00, 0x00,   // mov    out_cnt(%rip),%rdi
+        0x48, 0x81, 0xff, 0xe8, 0xff, 0x00, 0x00,   // cmp    $0xffe8,%rdi
+        0x76, 0x07,                                 // jbe    out.Append
+        0xe8, 0x00, 0x00, 0x00, 0x00,               // call   out_flush
+        0x31, 0xff,                                 // xor    %edi,%edi
+
+        // out.Append:
+        0x48, 0x8d, 0x35, 0x00, 0x00, 0x00, 0x00,   // lea    out_buf(%rip),%rsi
+        0x48, 0x01, 0xfe,                           // add    %rdi,%rsi
+        0x4c, 0x8b, 0x5c, 0x24, 0x08,               // mov    0x8(%rsp),%r11
+        0x4d, 0x85, 0xdb,                           // test   %r11,%r11
+        0x79, 0x09,                                 // jns    out.Convertion
+        0xc6, 0x06, 0x2d,                           // movb   $0x2d,(%rsi)
+        0x48, 0xff, 0xc6,                           // inc    %rsi
+        0x49, 0xf7, 0xdb,                           // neg    %r11
+
         // out.Convertion:
-        0x48, 0x31, 0xd2,                  // xor    %rdx,%rdx
-        0x49, 0xf7, 0xf3,                  // div    %r11
-        0x48, 0x83, 0xfa, 0x0a,            // cmp    $0xa,%rdx
-        0x72, 0x06,                        // jb     out.below_10
-        0x48, 0x83, 0xc2, 0x37,            // add    $0x37,%rdx
-        0xeb, 0x04,                        // jmp    out.push_char
-    
-        // out.below_10:
-        0x48, 0x83, 0xc2, 0x30,            // add    $0x30,%rdx
-    
-        // out.push_char:
-        0x48, 0xff, 0xcc,                  // dec    %rsp
-        0x88, 0x14, 0x24,                  // mov    %dl,(%rsp)
-        0x48, 0xff, 0xc1,                  // inc    %rcx
-        0x48, 0x85, 0xc0,                  // test   %rax,%rax
-        0x75, 0xdc,                        // jne    out.Convertion
-        0x48, 0x85, 0xff,                  // test   %rdi,%rdi
-        0x79, 0x0a,                        // jns    out.Print
-        0x48, 0xff, 0xcc,                  // dec    %rsp
-        0xc6, 0x04, 0x24, 0x2d,            // movb   $0x2d,(%rsp)
-        0x48, 0xff, 0xc1,                  // inc    %rcx
-    
-        // out.Print:
-        0x48, 0x89, 0xca,                  // mov    %rcx,%rdx
-        0x48, 0x89, 0xe6,                  // mov    %rsp,%rsi
-        0xbf, 0x01, 0x00, 0x00, 0x00,      // mov    $0x1,%edi
-        0xb8, 0x01, 0x00, 0x00, 0x00,      // mov    $0x1,%eax
-        0x0f, 0x05,                        // syscall
-        0x48, 0x01, 0xd4,                  // add    %rdx,%rsp
-        0x48, 0x85, 0xc0,                  // test   %rax,%rax
-        0x74, 0x03,                        // je     out.Exit
-    
-        // out.ExitSuccess:
-        0x48, 0x31, 0xc0,                  // xor    %rax,%rax
-    
-        // out.Exit:
-        0xc3                               // ret
+        0x48, 0x83, 0xec, 0x18,                     // sub    $0x18,%rsp
+        0x48, 0x8d, 0x4c, 0x24, 0x18,               // lea    0x18(%rsp),%rcx
+        0x4c, 0x8d, 0x0d, 0x00, 0x00, 0x00, 0x00,   // lea    out_digits(%rip),%r9
+        0x49, 0xba, 0xc3, 0xf5, 0x28, 0x5c,
+                    0x8f, 0xc2, 0xf5, 0x28,         // movabs $0x28f5c28f5c28f5c3,%r10
+
+        // out.Loop100:
+        0x49, 0x83, 0xfb, 0x63,                     // cmp    $0x63,%r11
+        0x76, 0x26,                                 // jbe    out.Tail
+        0x4c, 0x89, 0xd8,                           // mov    %r11,%rax
+        0x48, 0xc1, 0xe8, 0x02,                     // shr    $0x2,%rax
+        0x49, 0xf7, 0xe2,                           // mul    %r10
+        0x48, 0xc1, 0xea, 0x02,                     // shr    $0x2,%rdx         (rdx = r11 / 100)
+        0x48, 0x6b, 0xc2, 0x64,                     // imul   $0x64,%rdx,%rax
+        0x49, 0x29, 0xc3,                           // sub    %rax,%r11
+        0x43, 0x0f, 0xb7, 0x04, 0x59,               // movzwl (%r9,%r11,2),%eax
+        0x48, 0x83, 0xe9, 0x02,                     // sub    $0x2,%rcx
+        0x66, 0x89, 0x01,                           // mov    %ax,(%rcx)
+        0x49, 0x89, 0xd3,                           // mov    %rdx,%r11
+        0xeb, 0xd4,                                 // jmp    out.Loop100
+
+        // out.Tail:
+        0x49, 0x83, 0xfb, 0x0a,                     // cmp    $0xa,%r11
+        0x72, 0x0e,                                 // jb     out.OneDigit
+        0x43, 0x0f, 0xb7, 0x04, 0x59,               // movzwl (%r9,%r11,2),%eax
+        0x48, 0x83, 0xe9, 0x02,                     // sub    $0x2,%rcx
+        0x66, 0x89, 0x01,                           // mov    %ax,(%rcx)
+        0xeb, 0x0a,                                 // jmp    out.Copy
+
+        // out.OneDigit:
+        0x41, 0x83, 0xc3, 0x30,                     // add    $0x30,%r11d
+        0x48, 0xff, 0xc9,                           // dec    %rcx
+        0x44, 0x88, 0x19,                           // mov    %r11b,(%rcx)
+
+        // out.Copy:
+        0x48, 0x8d, 0x54, 0x24, 0x18,               // lea    0x18(%rsp),%rdx
+        0x48, 0x29, 0xca,                           // sub    %rcx,%rdx
+        0x48, 0x89, 0xf7,                           // mov    %rsi,%rdi
+        0x48, 0x89, 0xce,                           // mov    %rcx,%rsi
+        0x48, 0x89, 0xd1,                           // mov    %rdx,%rcx
+        0xf3, 0xa4,                                 // rep movsb
+        0xc6, 0x07, 0x0a,                           // movb   $0xa,(%rdi)
+        0x48, 0xff, 0xc7,                           // inc    %rdi
+        0x48, 0x83, 0xc4, 0x18,                     // add    $0x18,%rsp
+        0x48, 0x8d, 0x05, 0x00, 0x00, 0x00, 0x00,   // lea    out_buf(%rip),%rax
+        0x48, 0x29, 0xc7,                           // sub    %rax,%rdi
+        0x48, 0x89, 0x3d, 0x00, 0x00, 0x00, 0x00,   // mov    %rdi,out_cnt(%rip)
+        0x31, 0xc0,                                 // xor    %eax,%eax
+        0xc3                                        // ret
     };
+    static_assert(OUT_BUF_SIZE_ == 0x10000, "out_buf size is hardcoded in out bytes");
 
-    const size_t bytes_size = sizeof(bytes);
+    const runtime_fixup_t fixups[] =
+    {
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x03, .addend = BSS_OUT_CNT_},
+        {.label = RUNTIME_LABEL_OUT_FLUSH,  .offset = 0x11, .addend = 0},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x1a, .addend = BSS_OUT_BUF_},
+        {.label = RUNTIME_LABEL_OUT_DIGITS, .offset = 0x40, .addend = 0},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0xb8, .addend = BSS_OUT_BUF_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0xc2, .addend = BSS_OUT_CNT_},
+    };
 
-    TRANSLATION_ERROR_HANDLE(write_arr_text(translator, bytes, bytes_size));
+    TRANSLATION_ERROR_HANDLE(write_runtime_(translator, bytes, sizeof(bytes),
+                                            fixups, sizeof(fixups) / sizeof(*fixups)));
 
-    translator->cur_addr += bytes_size;
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum TranslationError translate_out_flush_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(OUT_FLUSH)));
+
+    uint8_t bytes[] = 
+    {
+        0x48, 0x8b, 0x15, 0x00, 0x00, 0x00, 0x00,   // mov    out_cnt(%rip),%rdx
+        0x48, 0x8d, 0x35, 0x00, 0x00, 0x00, 0x00,   // lea    out_buf(%rip),%rsi
+
+        // out_flush.Loop:
+        0x48, 0x85, 0xd2,                           // test   %rdx,%rdx
+        0x7e, 0x19,                                 // jle    out_flush.Exit
+        0xbf, 0x01, 0x00, 0x00, 0x00,               // mov    $0x1,%edi
+        0xb8, 0x01, 0x00, 0x00, 0x00,               // mov    $0x1,%eax
+        0x0f, 0x05,                                 // syscall
+        0x48, 0x85, 0xc0,                           // test   %rax,%rax
+        0x7e, 0x08,                                 // jle    out_flush.Exit
+        0x48, 0x01, 0xc6,                           // add    %rax,%rsi
+        0x48, 0x29, 0xc2,                           // sub    %rax,%rdx
+        0xeb, 0xe2,                                 // jmp    out_flush.Loop
+
+        // out_flush.Exit:
+        0x31, 0xc0,                                 // xor    %eax,%eax
+        0x48, 0x89, 0x05, 0x00, 0x00, 0x00, 0x00,   // mov    %rax,out_cnt(%rip)
+        0xc3                                        // ret
+    };
+
+    const runtime_fixup_t fixups[] =
+    {
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x03, .addend = BSS_OUT_CNT_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x0a, .addend = BSS_OUT_BUF_},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x31, .addend = BSS_OUT_CNT_},
+    };
+
+    TRANSLATION_ERROR_HANDLE(write_runtime_(translator, bytes, sizeof(bytes),
+                                            fixups, sizeof(fixups) / sizeof(*fixups)));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_syscall_pow_(elf_translator_t* const translator)
+// "00" "01" ... "99"
+static enum TranslationError translate_out_digits_(elf_translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    label_t func_out = {.name = "pow"};
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(OUT_DIGITS)));
 
-    TRANSLATION_ERROR_HANDLE(add_label(translator, &func_out));
+    uint8_t digits[200] = {};
+    for (size_t num = 0; num < 100; ++num)
+    {
+        digits[2 * num]     = (uint8_t)('0' + num / 10);
+        digits[2 * num + 1] = (uint8_t)('0' + num % 10);
+    }
+
+    TRANSLATION_ERROR_HANDLE(write_arr_text(translator, digits, sizeof(digits)));
+
+    translator->cur_addr += sizeof(digits);
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum TranslationError translate_syscall_pow_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(POW)));
 
     uint8_t bytes[] = 
     {
@@ -634,4 +1422,136 @@ static enum TranslationError translate_syscall_pow_(elf_translator_t* const tran
     translator->cur_addr += bytes_size;
 
     return TRANSLATION_ERROR_SUCCESS;
-}
\ No newline at end of file
+}
+
+static enum TranslationError translate_memo_get_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(MEMO_GET)));
+
+    uint8_t bytes[] =
+    {
+        0xe8, 0x00, 0x00, 0x00, 0x00,               // call   memo_slot
+        0x31, 0xc0,                                 // xor    %eax,%eax
+        0x49, 0x39, 0x30,                           // cmp    %rsi,(%r8)
+        0x75, 0x19,                                 // jne    memo_get.Exit
+        0x49, 0x39, 0x48, 0x08,                     // cmp    %rcx,0x8(%r8)
+        0x75, 0x13,                                 // jne    memo_get.Exit
+        0x49, 0x39, 0x50, 0x10,                     // cmp    %rdx,0x10(%r8)
+        0x75, 0x0d,                                 // jne    memo_get.Exit
+        0x49, 0x8b, 0x50, 0x18,                     // mov    0x18(%r8),%rdx
+        0x48, 0x89, 0x15, 0x00, 0x00, 0x00, 0x00,   // mov    %rdx,memo_found(%rip)
+        0xff, 0xc0,                                 // inc    %eax
+
+        // memo_get.Exit:
+        0xc3                                        // ret
+    };
+
+    const runtime_fixup_t fixups[] =
+    {
+        {.label = RUNTIME_LABEL_MEMO_SLOT,  .offset = 0x01, .addend = 0},
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x1f, .addend = BSS_MEMO_VAL_},
+    };
+
+    TRANSLATION_ERROR_HANDLE(write_runtime_(translator, bytes, sizeof(bytes),
+                                            fixups, sizeof(fixups) / sizeof(*fixups)));
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum TranslationError translate_memo_val_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(MEMO_VAL)));
+
+    uint8_t bytes[] =
+    {
+        0x48, 0x8b, 0x05, 0x00, 0x00, 0x00, 0x00,   // mov    memo_found(%rip),%rax
+        0xc3                                        // ret
+    };
+
+    const runtime_fixup_t fixups[] =
+    {
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x03, .addend = BSS_MEMO_VAL_},
+    };
+
+    TRANSLATION_ERROR_HANDLE(write_runtime_(translator, bytes, sizeof(bytes),
+                                            fixups, sizeof(fixups) / sizeof(*fixups)));
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum TranslationError translate_memo_put_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(MEMO_PUT)));
+
+    uint8_t bytes[] =
+    {
+        0xe8, 0x00, 0x00, 0x00, 0x00,               // call   memo_slot
+        0x49, 0x89, 0x30,                           // mov    %rsi,(%r8)
+        0x49, 0x89, 0x48, 0x08,                     // mov    %rcx,0x8(%r8)
+        0x49, 0x89, 0x50, 0x10,                     // mov    %rdx,0x10(%r8)
+        0x48, 0x8b, 0x44, 0x24, 0x20,               // mov    0x20(%rsp),%rax   (val)
+        0x49, 0x89, 0x40, 0x18,                     // mov    %rax,0x18(%r8)
+        0xc3                                        // ret
+    };
+
+    const runtime_fixup_t fixups[] =
+    {
+        {.label = RUNTIME_LABEL_MEMO_SLOT,  .offset = 0x01, .addend = 0},
+    };
+
+    TRANSLATION_ERROR_HANDLE(write_runtime_(translator, bytes, sizeof(bytes),
+                                            fixups, sizeof(fixups) / sizeof(*fixups)));
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+// Called by memo_get and memo_put, so key is above two ret addrs.
+// Exit: r8 - entry of the key, rsi - id + 1, rcx - arg0, rdx - arg1
+static enum TranslationError translate_memo_slot_(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(add_label(translator, RUNTIME_LABEL_(MEMO_SLOT)));
+
+    uint8_t bytes[] =
+    {
+        0x48, 0x8b, 0x74, 0x24, 0x20,               // mov    0x20(%rsp),%rsi   (id)
+        0x48, 0xff, 0xc6,                           // inc    %rsi
+        0x48, 0x8b, 0x4c, 0x24, 0x18,               // mov    0x18(%rsp),%rcx   (arg0)
+        0x48, 0x8b, 0x54, 0x24, 0x10,               // mov    0x10(%rsp),%rdx   (arg1)
+        0x48, 0xbf, 0x15, 0x7c, 0x4a, 0x7f,
+                    0xb9, 0x79, 0x37, 0x9e,         // movabs $0x9e3779b97f4a7c15,%rdi
+        0x48, 0x89, 0xf0,                           // mov    %rsi,%rax
+        0x48, 0x0f, 0xaf, 0xc7,                     // imul   %rdi,%rax
+        0x48, 0x31, 0xc8,                           // xor    %rcx,%rax
+        0x48, 0x0f, 0xaf, 0xc7,                     // imul   %rdi,%rax
+        0x48, 0x31, 0xd0,                           // xor    %rdx,%rax
+        0x48, 0x0f, 0xaf, 0xc7,                     // imul   %rdi,%rax
+        0x48, 0xc1, 0xe8, 0x34,                     // shr    $0x34,%rax        (entry ind)
+        0x48, 0xc1, 0xe0, 0x05,                     // shl    $0x5,%rax
+        0x4c, 0x8d, 0x05, 0x00, 0x00, 0x00, 0x00,   // lea    memo_cache(%rip),%r8
+        0x49, 0x01, 0xc0,                           // add    %rax,%r8
+        0xc3                                        // ret
+    };
+    static_assert(MEMO_HASH_MUL == 0x9E3779B97F4A7C15ul, "hash mul is hardcoded in memo_slot bytes");
+    static_assert(MEMO_ENTRIES_LOG == 12, "memo entries cnt is hardcoded in memo_slot bytes");
+    static_assert(MEMO_ENTRY_SIZE_ == 32, "memo entry size is hardcoded in memo_slot bytes");
+
+    const runtime_fixup_t fixups[] =
+    {
+        {.label = RUNTIME_LABEL_BSS,        .offset = 0x3c, .addend = BSS_MEMO_},
+    };
+
+    TRANSLATION_ERROR_HANDLE(write_runtime_(translator, bytes, sizeof(bytes),
+                                            fixups, sizeof(fixups) / sizeof(*fixups)));
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+#undef RUNTIME_LABEL_
@@ -1,3 +1,7 @@
+#include <stdint.h>
+#include <errno.h>
+#include <sys/uio.h>
+
 #include "headers.h"
 
 enum TranslationError elf_headers_ctor(elf_translator_t* const translator, elf_headers_t* const elf_headers)
@@ -5,18 +9,20 @@ enum TranslationError elf_headers_ctor(elf_translator_t* const translator, elf_h
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elf_headers), "");
 
-    const size_t text_size = stack_size(translator->text);
+    const size_t text_size = translator->text.size;
     const size_t text_align_size = text_size + ALIGN_ - text_size % ALIGN_;
 
     const char* shstrtab = 
         "\0"
         ".shstrtab\0"
-        ".text"; 
+        ".text\0"
+        ".bss"; 
 
     const size_t shstrtab_size = sizeof(
         "\0"
         ".shstrtab\0"
-        ".text"
+        ".text\0"
+        ".bss"
     );
 
     Elf64_Ehdr elf_header =
@@ -27,13 +33,13 @@ enum TranslationError elf_headers_ctor(elf_translator_t* const translator, elf_h
         .e_version = EV_CURRENT,
         .e_entry = ENTRY_ADDR_,
         .e_phoff = sizeof(Elf64_Ehdr),              
-        .e_shoff = ALIGN_ + text_align_size,
+        .e_shoff = ALIGN_ + text_align_size + shstrtab_size,
         .e_flags = 0,
         .e_ehsize = sizeof(Elf64_Ehdr),
         .e_phentsize = sizeof(Elf64_Phdr),
-        .e_phnum = 1,
+        .e_phnum = 2,
         .e_shentsize = sizeof(Elf64_Shdr),
-        .e_shnum = 3,
+        .e_shnum = 4,
         .e_shstrndx = 1,
     }; 
 
@@ -49,6 +55,19 @@ enum TranslationError elf_headers_ctor(elf_translator_t* const translator, elf_h
         .p_align = ALIGN_,
     };
 
+    // runtime data, nothing of it is in the file
+    Elf64_Phdr elf_prog_header_bss =
+    {
+        .p_type = PT_LOAD,
+        .p_flags = PF_W | PF_R,
+        .p_offset = ALIGN_ + text_align_size,
+        .p_vaddr = ENTRY_ADDR_ + text_align_size,
+        .p_paddr = ENTRY_ADDR_ + text_align_size,
+        .p_filesz = 0,
+        .p_memsz = BSS_SIZE_,
+        .p_align = ALIGN_,
+    };
+
     Elf64_Shdr section_headers[] = {
         // Null section
         {
@@ -64,13 +83,13 @@ enum TranslationError elf_headers_ctor(elf_translator_t* const translator, elf_h
             .sh_entsize = 0
         },
         
-        // .shstrtab
+        // .shstrtab, after the padding of text, so text can fill up its last page
         {
             .sh_name = 1,
             .sh_type = SHT_STRTAB,
             .sh_flags = SHF_STRINGS,
             .sh_addr = 0,
-            .sh_offset = elf_header.e_shoff - shstrtab_size,
+            .sh_offset = ALIGN_ + text_align_size,
             .sh_size = shstrtab_size,
             .sh_link = 0,
             .sh_info = 0,
@@ -91,10 +110,25 @@ enum TranslationError elf_headers_ctor(elf_translator_t* const translator, elf_h
             .sh_addralign = ALIGN_,
             .sh_entsize = 0
         },
+
+        // .bss
+        {
+            .sh_name = 17,
+            .sh_type = SHT_NOBITS,
+            .sh_flags = SHF_ALLOC | SHF_WRITE,
+            .sh_addr = ENTRY_ADDR_ + text_align_size,
+            .sh_offset = ALIGN_ + text_align_size,
+            .sh_size = BSS_SIZE_,
+            .sh_link = 0,
+            .sh_info = 0,
+            .sh_addralign = ALIGN_,
+            .sh_entsize = 0
+        },
     };
 
     elf_headers->ehdr = elf_header;
     elf_headers->phdr_text = elf_prog_header_text;
+    elf_headers->phdr_bss = elf_prog_header_bss;
 
     elf_headers->shstrtab = shstrtab;
     elf_headers->shstrtab_size = shstrtab_size;
@@ -102,85 +136,105 @@ enum TranslationError elf_headers_ctor(elf_translator_t* const translator, elf_h
     elf_headers->shdr_zero = section_headers[0];
     elf_headers->shdr_shstrtab = section_headers[1];
     elf_headers->shdr_text = section_headers[2];
+    elf_headers->shdr_bss = section_headers[3];
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-enum TranslationError write_elf(const elf_translator_t* const translator, 
-                                 const elf_headers_t* const elf_headers,
-                                 FILE* out)
+// writev writes a part of iovs, if a signal comes after some bytes or the disk is full, and
+// nothing, if it comes before them (EINTR). Both are retried, no progress at all is an error
+static enum TranslationError writev_all_(const int fd, struct iovec* iovs, size_t iovs_cnt)
 {
-    lassert(!is_invalid_ptr(translator), "");
-    lassert(!is_invalid_ptr(elf_headers), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!is_invalid_ptr(iovs), "");
 
-    if(fwrite(&elf_headers->ehdr, sizeof(elf_headers->ehdr), 1, out) != 1)
+    while (iovs_cnt)
     {
-        perror("Can't fwrite elf_header in out");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
+        ssize_t written = writev(fd, iovs, (int)iovs_cnt);
+        if (written < 0 && errno == EINTR)
+            continue;
 
-    if(fwrite(&elf_headers->phdr_text, sizeof(elf_headers->phdr_text), 1, out) != 1)
-    {
-        perror("Can't fwrite elf_prog_header_text in out");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
+        if (written < 0)
+        {
+            perror("Can't writev elf in out");
+            return TRANSLATION_ERROR_STANDARD_ERRNO;
+        }
 
-    uint8_t* align_zero_arr = calloc(ALIGN_, sizeof(*align_zero_arr));
+        if (written == 0)
+        {
+            fprintf(stderr, "Can't writev elf in out: nothing is written\n");
+            return TRANSLATION_ERROR_STANDARD_ERRNO;
+        }
 
-    const size_t first_align_zero_cnt 
-        = ALIGN_ - sizeof(elf_headers->ehdr) - sizeof(elf_headers->phdr_text);
+        while (iovs_cnt && (size_t)written >= iovs->iov_len)
+        {
+            written -= (ssize_t)iovs->iov_len;
+            ++iovs;
+            --iovs_cnt;
+        }
 
-    if(fwrite(align_zero_arr, sizeof(*align_zero_arr), first_align_zero_cnt, out) 
-       != first_align_zero_cnt)
-    {
-        perror("Can't fwrite first align_zero_arr in out");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
+        if (iovs_cnt)
+        {
+            iovs->iov_base = (uint8_t*)iovs->iov_base + written;
+            iovs->iov_len -= (size_t)written;
+        }
     }
 
-    if (fwrite(stack_begin(translator->text), sizeof(uint8_t), stack_size(translator->text), out)
-        < stack_size(translator->text))
-    {
-        perror("Can't fwrite .text code in output file");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
+    return TRANSLATION_ERROR_SUCCESS;
+}
 
-    const size_t second_align_zero_cnt 
-        = elf_headers->ehdr.e_shoff - elf_headers->shstrtab_size - stack_size(translator->text) - ALIGN_;
+// writev only reads iov_base, that isn't const
+static void* iov_base_(const void* const ptr)
+{
+    return (void*)(uintptr_t)ptr;
+}
 
-    if (fwrite(align_zero_arr, sizeof(*align_zero_arr), second_align_zero_cnt, out) 
-        != second_align_zero_cnt)
-    {
-        perror("Can't fwrite second align_zero_arr in out");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
+// whole file goes by one writev, text is taken right from the code buffer
+enum TranslationError write_elf(const elf_translator_t* const translator, 
+                                 const elf_headers_t* const elf_headers,
+                                 FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(elf_headers), "");
+    lassert(!is_invalid_ptr(out), "");
 
-    free(align_zero_arr);
+    static const uint8_t align_zero_arr[ALIGN_] = {};
 
-    if (fwrite(elf_headers->shstrtab, sizeof(*elf_headers->shstrtab), elf_headers->shstrtab_size, out) 
-       != elf_headers->shstrtab_size)
-    {
-        perror("Can't fwrite shstrtab in out");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
+    const size_t first_align_zero_cnt 
+        = ALIGN_ - sizeof(elf_headers->ehdr) - sizeof(elf_headers->phdr_text) - sizeof(elf_headers->phdr_bss);
+
+    const size_t second_align_zero_cnt 
+        = elf_headers->shdr_shstrtab.sh_offset - translator->text.size - ALIGN_;
 
-    if (fwrite(&elf_headers->shdr_zero, sizeof(elf_headers->shdr_zero), 1, out) != 1)
+    struct iovec iovs[] =
     {
-        perror("Can't fwrite section_header zero in out");
-        return TRANSLATION_ERROR_STANDARD_ERRNO;
-    }
+        {.iov_base = iov_base_(&elf_headers->ehdr),              .iov_len = sizeof(elf_headers->ehdr)},
+        {.iov_base = iov_base_(&elf_headers->phdr_text),         .iov_len = sizeof(elf_headers->phdr_text)},
+        {.iov_base = iov_base_(&elf_headers->phdr_bss),          .iov_len = sizeof(elf_headers->phdr_bss)},
+        {.iov_base = iov_base_(align_zero_arr),                  .iov_len = first_align_zero_cnt},
+        {.iov_base = translator->text.data,                      .iov_len = translator->text.size},
+        {.iov_base = iov_base_(align_zero_arr),                  .iov_len = second_align_zero_cnt},
+        {.iov_base = iov_base_(elf_headers->shstrtab),           .iov_len = elf_headers->shstrtab_size},
+        {.iov_base = iov_base_(&elf_headers->shdr_zero),         .iov_len = sizeof(elf_headers->shdr_zero)},
+        {.iov_base = iov_base_(&elf_headers->shdr_shstrtab),     .iov_len = sizeof(elf_headers->shdr_shstrtab)},
+        {.iov_base = iov_base_(&elf_headers->shdr_text),         .iov_len = sizeof(elf_headers->shdr_text)},
+        {.iov_base = iov_base_(&elf_headers->shdr_bss),          .iov_len = sizeof(elf_headers->shdr_bss)},
+    };
 
-    if (fwrite(&elf_headers->shdr_shstrtab, sizeof(elf_headers->shdr_shstrtab), 1, out) != 1)
+    // nothing of out may stay in its buffer, as writev goes by fd
+    if (fflush(out))
     {
-        perror("Can't fwrite section_header shstrtab in out");
+        perror("Can't fflush out");
         return TRANSLATION_ERROR_STANDARD_ERRNO;
     }
 
-    if (fwrite(&elf_headers->shdr_text, sizeof(elf_headers->shdr_text), 1, out) != 1)
+    const int fd = fileno(out);
+    if (fd < 0)
     {
-        perror("Can't fwrite section_header .text in out");
+        perror("Can't fileno out");
         return TRANSLATION_ERROR_STANDARD_ERRNO;
     }
 
+    TRANSLATION_ERROR_HANDLE(writev_all_(fd, iovs, sizeof(iovs) / sizeof(*iovs)));
+
     return TRANSLATION_ERROR_SUCCESS;
 }
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include <stdint.h>
+
+#include "utils/utils.h"
+#include "ir_fist/structs.h"
+#include "ir_fist/funcs/funcs.h"
+#include "imm.h"
+
+// Operation takes its constant operand as imm, when the constant is assigned to the tmp right
+// before it. Then nothing is between the load and the use, so in stack mode skipped push doesn't
+// shift other operands. Constant first operand is taken only by mul, if the second one is loaded
+// by the single block between them.
+
+#define BLOCK_(elem_ind_) ((const ir_block_t*)fist->data + (elem_ind_))
+
+static bool is_const_def_(const ir_block_t* const block, const size_t tmp_num)
+{
+    lassert(!is_invalid_ptr(block), "");
+
+    return block->type == IR_OP_BLOCK_TYPE_ASSIGNMENT
+        && block->ret_type == IR_OPERAND_TYPE_TMP
+        && block->operand1_type == IR_OPERAND_TYPE_NUM
+        && block->ret_num == tmp_num;
+}
+
+// load of var or num, that doesn't use other tmps
+static bool is_load_def_(const ir_block_t* const block, const size_t tmp_num)
+{
+    lassert(!is_invalid_ptr(block), "");
+
+    return block->type == IR_OP_BLOCK_TYPE_ASSIGNMENT
+        && block->ret_type == IR_OPERAND_TYPE_TMP
+        && block->operand1_type != IR_OPERAND_TYPE_TMP
+        && block->ret_num == tmp_num;
+}
+
+static bool is_imm_op_(const enum IrOpType operation, const int64_t imm)
+{
+    switch (operation)
+    {
+        case IR_OP_TYPE_SUM:
+        case IR_OP_TYPE_SUB:
+            return imm >= INT32_MIN && imm <= INT32_MAX;
+        case IR_OP_TYPE_MUL:
+            return true;
+        case IR_OP_TYPE_DIV:
+            return imm != 0;
+
+        case IR_OP_TYPE_EQ:
+        case IR_OP_TYPE_NEQ:
+        case IR_OP_TYPE_LESS:
+        case IR_OP_TYPE_LESSEQ:
+        case IR_OP_TYPE_GREAT:
+        case IR_OP_TYPE_GREATEQ:
+        case IR_OP_TYPE_INVALID_OPERATION:
+        default:
+            return false;
+    }
+
+    return false;
+}
+
+static void fold_operation_(imms_t* const imms, const fist_t* const fist, const size_t elem_ind,
+                            const size_t prev, const size_t prev_prev)
+{
+    lassert(!is_invalid_ptr(imms), "");
+
+    const ir_block_t* const block = BLOCK_(elem_ind);
+
+    size_t const_ind = 0;
+    size_t tmp_num = 0;
+
+    if (prev && is_const_def_(BLOCK_(prev), block->operand2_num))
+    {
+        const_ind = prev;
+        tmp_num = block->operand1_num;
+    }
+    else if (prev_prev && block->operation_num == IR_OP_TYPE_MUL
+          && is_const_def_(BLOCK_(prev_prev), block->operand1_num)
+          && is_load_def_(BLOCK_(prev), block->operand2_num))
+    {
+        const_ind = prev_prev;
+        tmp_num = block->operand2_num;
+    }
+    else
+    {
+        return;
+    }
+
+    const int64_t imm = (int64_t)BLOCK_(const_ind)->operand1_num;
+    if (!is_imm_op_(block->operation_num, imm))
+        return;
+
+    imms->blocks[const_ind] = (imm_block_t){.kind = IMM_KIND_FOLDED, .imm = imm, .tmp_num = 0};
+    imms->blocks[elem_ind]  = (imm_block_t){.kind = IMM_KIND_OPERAND, .imm = imm, .tmp_num = tmp_num};
+}
+
+enum TranslationError imms_ctor(imms_t* const imms, const fist_t* const fist)
+{
+    lassert(!is_invalid_ptr(imms), "");
+    FIST_VERIFY_ASSERT(fist, NULL);
+
+    imms->blocks_cnt = 0;
+    for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind])
+    {
+        imms->blocks_cnt = MAX(imms->blocks_cnt, elem_ind + 1);
+    }
+
+    imms->blocks = calloc(imms->blocks_cnt + 1, sizeof(*imms->blocks));
+    if (!imms->blocks)
+    {
+        perror("Can't calloc imms->blocks");
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    size_t prev = 0;
+    size_t prev_prev = 0;
+    for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind])
+    {
+        if (BLOCK_(elem_ind)->type == IR_OP_BLOCK_TYPE_OPERATION)
+            fold_operation_(imms, fist, elem_ind, prev, prev_prev);
+
+        prev_prev = prev;
+        prev = elem_ind;
+    }
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+#undef BLOCK_
+
+void imms_dtor(imms_t* const imms)
+{
+    lassert(!is_invalid_ptr(imms), "");
+
+    free(imms->blocks); IF_DEBUG(imms->blocks = NULL;)
+}
+
+const imm_block_t* imms_get(const imms_t* const imms, const size_t elem_ind)
+{
+    lassert(!is_invalid_ptr(imms), "");
+    lassert(elem_ind < imms->blocks_cnt, "");
+
+    return imms->blocks + elem_ind;
+}
@@ -0,0 +1,33 @@
+#ifndef MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_IMM_H
+#define MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_IMM_H
+
+#include "hash_table/libs/list_on_array/libfist.h"
+#include "translation/funcs/elf/structs.h"
+#include "translation/verification/verification.h"
+
+enum ImmKind
+{
+    IMM_KIND_NONE       = 0, // block is translated as is
+    IMM_KIND_FOLDED     = 1, // constant is not loaded, operation right after it takes it as imm
+    IMM_KIND_OPERAND    = 2, // operation of tmp_num and imm
+};
+
+typedef struct ImmBlock
+{
+    enum ImmKind kind;
+    int64_t imm;
+    size_t tmp_num;
+} imm_block_t;
+
+typedef struct Imms
+{
+    size_t blocks_cnt;
+    imm_block_t* blocks; // by fist elem ind
+} imms_t;
+
+enum TranslationError imms_ctor(imms_t* const imms, const fist_t* const fist);
+void                  imms_dtor(imms_t* const imms);
+
+const imm_block_t* imms_get(const imms_t* const imms, const size_t elem_ind);
+
+#endif /*MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_IMM_H*/
@@ -1,83 +0,0 @@
-#include <stdio.h>
-#include <stdlib.h>
-#include <stdint.h>
-
-#include "translation/funcs/elf/structs.h"
-#include "map_utils.h"
-
-#define HASH_KEY_ 31
-size_t func_hash_func(const void* const string)
-{
-    lassert(!is_invalid_ptr(string), "");
-
-    size_t hash_result = 0;
- 
-    for (const char* it = (const char*)string; *it; ++it)
-    {
-        hash_result = (size_t)(((HASH_KEY_ * hash_result) % INT64_MAX + (size_t)*it) % INT64_MAX);
-    }
- 
-    return hash_result;
-}
-#undef HASH_KEY_
-
-int map_key_to_str (const void* const elem, const size_t   elem_size,
-                            char* const *     str,  const size_t mx_str_size)
-{
-    if (is_invalid_ptr(str))  return -1;
-    if (is_invalid_ptr(*str)) return -1;
-    (void)elem_size;
-
-    if (elem && *(const char*)elem)
-    {
-        if (snprintf(*str, mx_str_size, "'%s'", 
-                                        ((const label_t*)elem)->name) 
-            <= 0)
-        {
-            perror("Can't snprintf key to str");
-            return -1;
-        }
-    }
-    else
-    {
-        if (snprintf(*str, mx_str_size, "(nul)") < 0)
-        {
-            perror("Can't snprintf key (nul) to str");
-            return -1;
-        }
-    }
-
-    return 0;
-}
-
-int map_val_to_str (const void* const elem, const size_t   elem_size,
-                            char* const *     str,  const size_t mx_str_size)
-{
-    if (is_invalid_ptr(str))  return -1;
-    if (is_invalid_ptr(*str)) return -1;
-    (void)elem_size;
-
-    if (elem)
-    {
-        if (snprintf(*str, mx_str_size, "'%zu, %zu'", 
-                                                ((const labels_val_t*)elem)->label_addr,
-                                                ((const labels_val_t*)elem)->insert_addrs) 
-            <= 0)
-        {
-            perror("Can't snprintf val to str");
-            return -1;
-        }
-    
-    }
-    else
-    {
-        if (snprintf(*str, mx_str_size, "(nul)") < 0)
-        {
-            perror("Can't snprintf key (nul) to str");
-            return -1;
-        }
-    }
-
-    return 0;
-}
-
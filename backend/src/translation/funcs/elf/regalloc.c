@@ -0,0 +1,478 @@
+#include <string.h>
+
+#include "utils/utils.h"
+#include "ir_fist/structs.h"
+#include "ir_fist/funcs/funcs.h"
+#include "regalloc.h"
+
+// Tmps are written by the midlend in the order they are computed and each of them is used only
+// inside of the straight-line code around its definition, so linear scan over the block order
+// gives exact live intervals.
+//
+// Calls keep only callee-saved r12-r15, so the tmp, that is alive during a call, is placed in the
+// frame slot. Vars of function with calls are kept in callee-saved regs, vars of leaf function
+// take caller-saved ones first. Tmps take caller-saved regs first too, so that leaf function
+// rarely has to save something.
+
+static const enum RegNum kREGALLOC_REGS_[REGALLOC_REGS_CNT] =
+{
+    REG_NUM_R8,  REG_NUM_R9,  REG_NUM_R10, REG_NUM_R11, REG_NUM_RSI,
+    REG_NUM_RDI, REG_NUM_R12, REG_NUM_R13, REG_NUM_R14, REG_NUM_R15
+};
+
+#define CALLER_SAVED_CNT_   (REGALLOC_REGS_CNT - REGALLOC_SAVED_CNT)
+
+#define TMP_REGS_MIN_   4
+#define VAR_REFS_MIN_   2
+#define NO_OWNER_       SIZE_MAX
+
+#define CUR_BLOCK_ ((const ir_block_t*)fist->data + elem_ind)
+
+static bool is_call_block_(const ir_block_t* const block)
+{
+    lassert(!is_invalid_ptr(block), "");
+
+    return block->type == IR_OP_BLOCK_TYPE_CALL_FUNCTION
+        || block->type == IR_OP_BLOCK_TYPE_SYSCALL;
+}
+
+static size_t block_def_tmp_(const ir_block_t* const block)
+{
+    lassert(!is_invalid_ptr(block), "");
+
+    if (block->type == IR_OP_BLOCK_TYPE_CALL_FUNCTION || block->type == IR_OP_BLOCK_TYPE_OPERATION)
+        return block->ret_num;
+
+    if (block->type == IR_OP_BLOCK_TYPE_SYSCALL)
+        return ir_block_syscall_have_ret_val(block) ? block->ret_num : NO_OWNER_;
+
+    if (block->type == IR_OP_BLOCK_TYPE_ASSIGNMENT && block->ret_type == IR_OPERAND_TYPE_TMP)
+        return block->ret_num;
+
+    return NO_OWNER_;
+}
+
+static size_t block_use_vars_(const ir_block_t* const block, size_t* const vars)
+{
+    lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(vars), "");
+
+    if (block->type != IR_OP_BLOCK_TYPE_ASSIGNMENT)
+        return 0;
+
+    size_t vars_cnt = 0;
+
+    if (block->ret_type == IR_OPERAND_TYPE_VAR)
+        vars[vars_cnt++] = block->ret_num;
+
+    if (block->operand1_type == IR_OPERAND_TYPE_VAR)
+        vars[vars_cnt++] = block->operand1_num;
+
+    return vars_cnt;
+}
+
+typedef struct RegAllocScratch
+{
+    size_t vars_cnt;
+    size_t* var_refs;
+    size_t* slot_owners;
+} regalloc_scratch_t;
+
+static void liveness_region_(regalloc_t* const regalloc, const fist_t* const fist,
+                             const size_t begin, const size_t end,
+                             regalloc_region_t* const region, regalloc_scratch_t* const scratch)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+    lassert(!is_invalid_ptr(region), "");
+    lassert(!is_invalid_ptr(scratch), "");
+
+    memset(scratch->var_refs, 0, scratch->vars_cnt * sizeof(*scratch->var_refs));
+
+    size_t pos = 0;
+    size_t last_call_pos = 0;
+    for (size_t elem_ind = begin; elem_ind != end; elem_ind = fist->next[elem_ind])
+    {
+        ++pos;
+
+        if (CUR_BLOCK_->type == IR_OP_BLOCK_TYPE_FUNCTION_BODY)
+        {
+            region->args_cnt   = CUR_BLOCK_->operand1_num;
+            region->locals_cnt = CUR_BLOCK_->operand2_num;
+        }
+
+        size_t used[2] = {};
+        const size_t used_cnt = ir_block_use_tmps(CUR_BLOCK_, used);
+        for (size_t used_ind = 0; used_ind < used_cnt; ++used_ind)
+        {
+            regalloc_tmp_t* const tmp = regalloc->tmps + used[used_ind];
+
+            tmp->last_use_pos = pos;
+            tmp->is_cross_call |= (last_call_pos > tmp->def_pos);
+        }
+
+        if (is_call_block_(CUR_BLOCK_))
+        {
+            last_call_pos = pos;
+            region->has_call = true;
+        }
+
+        const size_t def = block_def_tmp_(CUR_BLOCK_);
+        if (def != NO_OWNER_)
+        {
+            regalloc->tmps[def].def_pos = pos;
+        }
+
+        size_t vars[2] = {};
+        const size_t vars_cnt = block_use_vars_(CUR_BLOCK_, vars);
+        for (size_t var_ind = 0; var_ind < vars_cnt; ++var_ind)
+        {
+            ++scratch->var_refs[vars[var_ind]];
+        }
+    }
+}
+
+// reg of the next var: leaf function takes caller-saved ones down from rdi, so tmps keep r8 and up,
+// function with calls takes callee-saved ones
+static size_t var_reg_ind_(const regalloc_region_t* const region)
+{
+    lassert(!is_invalid_ptr(region), "");
+
+    if (region->has_call)
+        return CALLER_SAVED_CNT_ + region->vars_cnt;
+
+    lassert(region->vars_cnt < CALLER_SAVED_CNT_, "");
+
+    return CALLER_SAVED_CNT_ - 1 - region->vars_cnt;
+}
+
+static void promote_vars_(regalloc_region_t* const region, regalloc_scratch_t* const scratch,
+                          bool* const is_var_reg)
+{
+    lassert(!is_invalid_ptr(region), "");
+    lassert(!is_invalid_ptr(scratch), "");
+    lassert(!is_invalid_ptr(is_var_reg), "");
+
+    const size_t vars_max = region->has_call ? REGALLOC_SAVED_CNT : REGALLOC_REGS_CNT - TMP_REGS_MIN_;
+
+    while (region->vars_cnt < vars_max)
+    {
+        size_t hot_var = NO_OWNER_;
+        for (size_t var = 0; var < scratch->vars_cnt; ++var)
+        {
+            if (scratch->var_refs[var] >= VAR_REFS_MIN_
+             && (hot_var == NO_OWNER_ || scratch->var_refs[var] > scratch->var_refs[hot_var]))
+            {
+                hot_var = var;
+            }
+        }
+
+        if (hot_var == NO_OWNER_)
+            break;
+
+        scratch->var_refs[hot_var] = 0;
+
+        const size_t reg_ind = var_reg_ind_(region);
+
+        region->var_nums[region->vars_cnt] = hot_var;
+        region->var_regs[region->vars_cnt] = kREGALLOC_REGS_[reg_ind];
+        is_var_reg[reg_ind] = true;
+
+        ++region->vars_cnt;
+    }
+}
+
+static void spill_tmp_(regalloc_t* const regalloc, const size_t tmp_num,
+                       regalloc_region_t* const region, regalloc_scratch_t* const scratch)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+    lassert(!is_invalid_ptr(region), "");
+    lassert(!is_invalid_ptr(scratch), "");
+
+    size_t slot = 0;
+    while (slot < region->spills_cnt && scratch->slot_owners[slot] != NO_OWNER_)
+    {
+        ++slot;
+    }
+
+    if (slot == region->spills_cnt)
+    {
+        ++region->spills_cnt;
+    }
+
+    scratch->slot_owners[slot] = tmp_num;
+
+    regalloc->tmps[tmp_num].location = (location_t){
+        .type   = LOCATION_TYPE_FRAME,
+        .reg    = REG_NUM_RAX,
+        .offset = -8 * (int64_t)(region->locals_cnt + slot + 1)
+    };
+}
+
+static void linear_scan_region_(regalloc_t* const regalloc, const fist_t* const fist,
+                                const size_t begin, const size_t end,
+                                regalloc_region_t* const region, regalloc_scratch_t* const scratch,
+                                const bool* const is_var_reg, bool* const is_used_reg)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+    lassert(!is_invalid_ptr(region), "");
+    lassert(!is_invalid_ptr(scratch), "");
+    lassert(!is_invalid_ptr(is_var_reg), "");
+    lassert(!is_invalid_ptr(is_used_reg), "");
+
+    size_t reg_owners[REGALLOC_REGS_CNT] = {};
+    for (size_t reg_ind = 0; reg_ind < REGALLOC_REGS_CNT; ++reg_ind)
+    {
+        reg_owners[reg_ind] = NO_OWNER_;
+    }
+
+    size_t pos = 0;
+    for (size_t elem_ind = begin; elem_ind != end; elem_ind = fist->next[elem_ind])
+    {
+        ++pos;
+
+        for (size_t reg_ind = 0; reg_ind < REGALLOC_REGS_CNT; ++reg_ind)
+        {
+            if (reg_owners[reg_ind] != NO_OWNER_
+             && regalloc->tmps[reg_owners[reg_ind]].last_use_pos <= pos)
+            {
+                reg_owners[reg_ind] = NO_OWNER_;
+            }
+        }
+
+        for (size_t slot = 0; slot < region->spills_cnt; ++slot)
+        {
+            if (scratch->slot_owners[slot] != NO_OWNER_
+             && regalloc->tmps[scratch->slot_owners[slot]].last_use_pos <= pos)
+            {
+                scratch->slot_owners[slot] = NO_OWNER_;
+            }
+        }
+
+        const size_t def = block_def_tmp_(CUR_BLOCK_);
+        if (def == NO_OWNER_)
+            continue;
+
+        regalloc_tmp_t* const tmp = regalloc->tmps + def;
+
+        if (tmp->last_use_pos <= tmp->def_pos)
+        {
+            tmp->location.type = LOCATION_TYPE_NONE;
+            continue;
+        }
+
+        if (tmp->is_cross_call)
+        {
+            spill_tmp_(regalloc, def, region, scratch);
+            continue;
+        }
+
+        size_t free_reg = NO_OWNER_;
+        size_t victim_reg = NO_OWNER_;
+        for (size_t reg_ind = 0; reg_ind < REGALLOC_REGS_CNT; ++reg_ind)
+        {
+            if (is_var_reg[reg_ind])
+                continue;
+
+            if (reg_owners[reg_ind] == NO_OWNER_)
+            {
+                free_reg = reg_ind;
+                break;
+            }
+
+            if (victim_reg == NO_OWNER_
+             || regalloc->tmps[reg_owners[reg_ind]].last_use_pos
+              > regalloc->tmps[reg_owners[victim_reg]].last_use_pos)
+            {
+                victim_reg = reg_ind;
+            }
+        }
+
+        if (free_reg == NO_OWNER_)
+        {
+            if (victim_reg == NO_OWNER_
+             || regalloc->tmps[reg_owners[victim_reg]].last_use_pos <= tmp->last_use_pos)
+            {
+                spill_tmp_(regalloc, def, region, scratch);
+                continue;
+            }
+
+            spill_tmp_(regalloc, reg_owners[victim_reg], region, scratch);
+            free_reg = victim_reg;
+        }
+
+        reg_owners[free_reg] = def;
+        is_used_reg[free_reg] = true;
+        tmp->location = (location_t){
+            .type = LOCATION_TYPE_REG,
+            .reg = kREGALLOC_REGS_[free_reg],
+            .offset = 0
+        };
+    }
+}
+
+static void alloc_region_(regalloc_t* const regalloc, const fist_t* const fist,
+                          const size_t begin, const size_t end, const size_t region_ind,
+                          regalloc_scratch_t* const scratch)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+    lassert(!is_invalid_ptr(scratch), "");
+    lassert(region_ind < regalloc->regions_cnt, "");
+
+    regalloc_region_t* const region = regalloc->regions + region_ind;
+
+    liveness_region_(regalloc, fist, begin, end, region, scratch);
+
+    bool is_var_reg[REGALLOC_REGS_CNT] = {};
+    bool is_used_reg[REGALLOC_REGS_CNT] = {};
+
+    if (region_ind != 0)
+    {
+        promote_vars_(region, scratch, is_var_reg);
+    }
+
+    linear_scan_region_(regalloc, fist, begin, end, region, scratch, is_var_reg, is_used_reg);
+
+    // top level code is never returned from
+    for (size_t reg_ind = CALLER_SAVED_CNT_; region_ind != 0 && reg_ind < REGALLOC_REGS_CNT; ++reg_ind)
+    {
+        if (is_var_reg[reg_ind] || is_used_reg[reg_ind])
+            region->saved_regs[region->saved_cnt++] = kREGALLOC_REGS_[reg_ind];
+    }
+}
+
+enum TranslationError regalloc_ctor(regalloc_t* const regalloc, const fist_t* const fist,
+                                    const bool is_enabled)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+    FIST_VERIFY_ASSERT(fist, NULL);
+
+    regalloc->is_enabled    = is_enabled;
+    regalloc->tmps_cnt      = 0;
+    regalloc->tmps          = NULL;
+    regalloc->regions_cnt   = 1;
+    regalloc->regions       = NULL;
+    regalloc->cur_region    = 0;
+
+    if (!is_enabled)
+        return TRANSLATION_ERROR_SUCCESS;
+
+    regalloc_scratch_t scratch = {};
+
+    for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind])
+    {
+        regalloc->regions_cnt += (CUR_BLOCK_->type == IR_OP_BLOCK_TYPE_FUNCTION_BODY);
+
+        size_t used[2] = {};
+        const size_t used_cnt = ir_block_use_tmps(CUR_BLOCK_, used);
+        for (size_t used_ind = 0; used_ind < used_cnt; ++used_ind)
+        {
+            regalloc->tmps_cnt = MAX(regalloc->tmps_cnt, used[used_ind] + 1);
+        }
+
+        const size_t def = block_def_tmp_(CUR_BLOCK_);
+        if (def != NO_OWNER_)
+        {
+            regalloc->tmps_cnt = MAX(regalloc->tmps_cnt, def + 1);
+        }
+
+        size_t vars[2] = {};
+        const size_t vars_cnt = block_use_vars_(CUR_BLOCK_, vars);
+        for (size_t var_ind = 0; var_ind < vars_cnt; ++var_ind)
+        {
+            scratch.vars_cnt = MAX(scratch.vars_cnt, vars[var_ind] + 1);
+        }
+    }
+
+    regalloc->tmps      = calloc(regalloc->tmps_cnt + 1,    sizeof(*regalloc->tmps));
+    regalloc->regions   = calloc(regalloc->regions_cnt,     sizeof(*regalloc->regions));
+    scratch.var_refs    = calloc(scratch.vars_cnt + 1,      sizeof(*scratch.var_refs));
+    scratch.slot_owners = calloc(regalloc->tmps_cnt + 1,    sizeof(*scratch.slot_owners));
+
+    if (!regalloc->tmps || !regalloc->regions || !scratch.var_refs || !scratch.slot_owners)
+    {
+        perror("Can't calloc regalloc arrays");
+        free(scratch.var_refs);
+        free(scratch.slot_owners);
+        regalloc_dtor(regalloc);
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    for (size_t tmp_num = 0; tmp_num < regalloc->tmps_cnt; ++tmp_num)
+    {
+        regalloc->tmps[tmp_num].location.type = LOCATION_TYPE_NONE;
+    }
+
+    size_t region_begin = fist->next[0];
+    size_t region_ind = 0;
+    for (size_t elem_ind = fist->next[0]; elem_ind; elem_ind = fist->next[elem_ind])
+    {
+        if (CUR_BLOCK_->type == IR_OP_BLOCK_TYPE_FUNCTION_BODY)
+        {
+            alloc_region_(regalloc, fist, region_begin, elem_ind, region_ind++, &scratch);
+            region_begin = elem_ind;
+        }
+    }
+    alloc_region_(regalloc, fist, region_begin, 0, region_ind, &scratch);
+
+    free(scratch.var_refs);
+    free(scratch.slot_owners);
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+void regalloc_dtor(regalloc_t* const regalloc)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+
+    free(regalloc->tmps);       IF_DEBUG(regalloc->tmps     = NULL;)
+    free(regalloc->regions);    IF_DEBUG(regalloc->regions  = NULL;)
+}
+
+void regalloc_next_region(regalloc_t* const regalloc)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+
+    if (!regalloc->is_enabled)
+        return;
+
+    ++regalloc->cur_region;
+    lassert(regalloc->cur_region < regalloc->regions_cnt, "");
+}
+
+const regalloc_region_t* regalloc_cur_region(const regalloc_t* const regalloc)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+
+    if (!regalloc->is_enabled)
+        return NULL;
+
+    return regalloc->regions + regalloc->cur_region;
+}
+
+location_t regalloc_tmp(const regalloc_t* const regalloc, const size_t tmp_num)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+
+    if (!regalloc->is_enabled)
+        return (location_t){.type = LOCATION_TYPE_STACK, .reg = REG_NUM_RAX, .offset = 0};
+
+    if (tmp_num >= regalloc->tmps_cnt)
+        return (location_t){.type = LOCATION_TYPE_NONE, .reg = REG_NUM_RAX, .offset = 0};
+
+    return regalloc->tmps[tmp_num].location;
+}
+
+location_t regalloc_var(const regalloc_t* const regalloc, const size_t var_num)
+{
+    lassert(!is_invalid_ptr(regalloc), "");
+
+    const regalloc_region_t* const region = regalloc_cur_region(regalloc);
+
+    for (size_t var_ind = 0; region && var_ind < region->vars_cnt; ++var_ind)
+    {
+        if (region->var_nums[var_ind] == var_num)
+            return (location_t){.type = LOCATION_TYPE_REG, .reg = region->var_regs[var_ind], .offset = 0};
+    }
+
+    return (location_t){.type = LOCATION_TYPE_FRAME, .reg = REG_NUM_RBP, .offset = -8 * ((int64_t)var_num + 1)};
+}
@@ -0,0 +1,75 @@
+#ifndef MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_REGALLOC_H
+#define MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_REGALLOC_H
+
+#include <stdbool.h>
+
+#include "hash_table/libs/list_on_array/libfist.h"
+#include "translation/funcs/elf/structs.h"
+#include "translation/verification/verification.h"
+#include "write_lib.h"
+
+#define REGALLOC_REGS_CNT   (10)
+#define REGALLOC_SAVED_CNT  (4)
+
+enum LocationType
+{
+    LOCATION_TYPE_STACK     = 0, // push/pop stack machine
+    LOCATION_TYPE_REG       = 1,
+    LOCATION_TYPE_FRAME     = 2, // [rbp + offset]
+    LOCATION_TYPE_NONE      = 3, // value is never used
+};
+
+typedef struct Location
+{
+    enum LocationType type;
+    enum RegNum reg;
+    int64_t offset;
+} location_t;
+
+typedef struct RegAllocTmp
+{
+    location_t location;
+
+    size_t def_pos;
+    size_t last_use_pos;
+    bool is_cross_call;
+} regalloc_tmp_t;
+
+typedef struct RegAllocRegion
+{
+    size_t args_cnt;
+    size_t locals_cnt;
+    size_t spills_cnt;
+    bool has_call;
+
+    size_t vars_cnt;
+    size_t var_nums[REGALLOC_REGS_CNT];
+    enum RegNum var_regs[REGALLOC_REGS_CNT];
+
+    size_t saved_cnt;                           // callee-saved regs, that are used by function
+    enum RegNum saved_regs[REGALLOC_SAVED_CNT]; // kept in the frame right after spills
+} regalloc_region_t;
+
+typedef struct RegAlloc
+{
+    bool is_enabled;
+
+    size_t tmps_cnt;
+    regalloc_tmp_t* tmps;
+
+    size_t regions_cnt;
+    regalloc_region_t* regions;
+    size_t cur_region;
+} regalloc_t;
+
+enum TranslationError regalloc_ctor(regalloc_t* const regalloc, const fist_t* const fist,
+                                    const bool is_enabled);
+void                  regalloc_dtor(regalloc_t* const regalloc);
+
+void regalloc_next_region(regalloc_t* const regalloc);
+const regalloc_region_t* regalloc_cur_region(const regalloc_t* const regalloc);
+
+location_t regalloc_tmp(const regalloc_t* const regalloc, const size_t tmp_num);
+location_t regalloc_var(const regalloc_t* const regalloc, const size_t var_num);
+
+#endif /*MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_REGALLOC_H*/
@@ -0,0 +1,272 @@
+#include <string.h>
+
+#include "utils/utils.h"
+#include "labels.h"
+#include "relax.h"
+
+// Jumps are written in rel32 form. Relaxation starts with all of them long and makes short every
+// jump, whose target is in rel8 range in the current layout. Shortening only brings code closer,
+// so short jumps stay in range, and passes go until nothing changes. Then the text is rebuilt,
+// labels and fixups are moved to the new addresses.
+
+#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
+    do {                                                                                            \
+        const enum StackError stack_error_handler = call_func;                                      \
+        if (stack_error_handler)                                                                    \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Stack error: %s\n",                               \
+                            stack_strerror(stack_error_handler));                                   \
+            __VA_ARGS__                                                                             \
+            return TRANSLATION_ERROR_STACK;                                                         \
+        }                                                                                           \
+    } while(0)
+
+#define JMP_SIZE_       5
+#define JCC_SIZE_       6
+#define SHORT_SIZE_     2
+
+enum TranslationError write_label_jmp(elf_translator_t* const translator, const size_t label_num,
+                                      const enum OpCode jcc)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    const bool is_jmp = (jcc == OP_CODE_JMP);
+
+    const relax_jump_t jump = {
+        .addr       = translator->cur_addr,
+        .label_num  = label_num,
+        .fixup_ind  = stack_size(translator->fixups),
+        .jcc        = (uint8_t)jcc,
+        .is_short   = false,
+    };
+    STACK_ERROR_HANDLE_(stack_push(&translator->jumps, &jump));
+
+    TRANSLATION_ERROR_HANDLE(
+        add_not_handle_addr(translator, label_num, translator->cur_addr + (is_jmp ? 1 : 2))
+    );
+
+    if (is_jmp)
+    {
+        TRANSLATION_ERROR_HANDLE(write_jmp(translator, 0));
+    }
+    else
+    {
+        TRANSLATION_ERROR_HANDLE(write_cond_jmp(translator, jcc, 0));
+    }
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static size_t long_size_(const relax_jump_t* const jump)
+{
+    lassert(!is_invalid_ptr(jump), "");
+
+    return jump->jcc == OP_CODE_JMP ? JMP_SIZE_ : JCC_SIZE_;
+}
+
+typedef struct RelaxLayout
+{
+    const relax_jump_t* jumps;
+    size_t jumps_cnt;
+    size_t* shrinks;    // bytes, that short jumps before jump i saved, shrinks[jumps_cnt] - all
+} relax_layout_t;
+
+static void layout_update_(relax_layout_t* const layout)
+{
+    lassert(!is_invalid_ptr(layout), "");
+
+    layout->shrinks[0] = 0;
+    for (size_t jump_ind = 0; jump_ind < layout->jumps_cnt; ++jump_ind)
+    {
+        const relax_jump_t* const jump = layout->jumps + jump_ind;
+
+        layout->shrinks[jump_ind + 1] = layout->shrinks[jump_ind]
+                                      + (jump->is_short ? long_size_(jump) - SHORT_SIZE_ : 0);
+    }
+}
+
+// new addr of old one, that isn't inside a short jump
+static size_t layout_addr_(const relax_layout_t* const layout, const size_t addr)
+{
+    lassert(!is_invalid_ptr(layout), "");
+
+    // first jump at addr or after it
+    size_t lt = 0;
+    size_t rt = layout->jumps_cnt;
+    while (lt < rt)
+    {
+        const size_t mid = lt + (rt - lt) / 2;
+        if (layout->jumps[mid].addr < addr)
+            lt = mid + 1;
+        else
+            rt = mid;
+    }
+
+    return addr - layout->shrinks[lt];
+}
+
+static int64_t short_rel_(const elf_translator_t* const translator, const relax_layout_t* const layout,
+                          const size_t jump_ind)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(layout), "");
+
+    const relax_jump_t* const jump = layout->jumps + jump_ind;
+
+    const size_t target = layout_addr_(layout, translator->label_addrs[jump->label_num]);
+    const size_t short_end = jump->addr - layout->shrinks[jump_ind] + SHORT_SIZE_;
+
+    return (int64_t)target - (int64_t)short_end;
+}
+
+static enum TranslationError rebuild_text_(elf_translator_t* const translator,
+                                           const relax_layout_t* const layout)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(layout), "");
+
+    const code_buf_t old_text = translator->text;
+
+    code_buf_t text = {};
+    TRANSLATION_ERROR_HANDLE(code_buf_ctor(&text, old_text.capacity));
+
+    size_t old_pos = 0;
+    for (size_t jump_ind = 0; jump_ind < layout->jumps_cnt; ++jump_ind)
+    {
+        const relax_jump_t* const jump = layout->jumps + jump_ind;
+        if (!jump->is_short)
+            continue;
+
+        const size_t jump_pos = jump->addr - ENTRY_ADDR_;
+        const int64_t rel = short_rel_(translator, layout, jump_ind);
+        lassert(rel == (int8_t)rel, "");
+
+        const uint16_t short_jump = (uint16_t)(
+            (jump->jcc == OP_CODE_JMP ? OP_CODE_JMP_REL8 : (OP_CODE_JCC_REL8 | (jump->jcc & 0x0F)))
+          | ((uint8_t)(int8_t)rel << 8)
+        ); // little endian: opcode, then rel8
+
+        TRANSLATION_ERROR_HANDLE(code_buf_append(&text, old_text.data + old_pos, jump_pos - old_pos),
+                                                                            code_buf_dtor(&text););
+        TRANSLATION_ERROR_HANDLE(code_buf_append(&text, &short_jump, SHORT_SIZE_),
+                                                                            code_buf_dtor(&text););
+
+        old_pos = jump_pos + long_size_(jump);
+    }
+
+    TRANSLATION_ERROR_HANDLE(code_buf_append(&text, old_text.data + old_pos, old_text.size - old_pos),
+                                                                            code_buf_dtor(&text););
+
+    code_buf_dtor(&translator->text);
+    translator->text = text;
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+// fixups of short jumps go away, others are moved
+static enum TranslationError move_fixups_(elf_translator_t* const translator,
+                                          const relax_layout_t* const layout)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(layout), "");
+
+    const size_t fixups_cnt = stack_size(translator->fixups);
+
+    size_t kept_cnt = 0;
+    size_t jump_ind = 0;
+    for (size_t fixup_ind = 0; fixup_ind < fixups_cnt; ++fixup_ind)
+    {
+        while (jump_ind < layout->jumps_cnt && layout->jumps[jump_ind].fixup_ind < fixup_ind)
+            ++jump_ind;
+
+        if (jump_ind < layout->jumps_cnt && layout->jumps[jump_ind].fixup_ind == fixup_ind
+         && layout->jumps[jump_ind].is_short)
+            continue;
+
+        label_fixup_t fixup = *(const label_fixup_t*)stack_get(translator->fixups, fixup_ind);
+        fixup.insert_addr = layout_addr_(layout, fixup.insert_addr);
+
+        *(label_fixup_t*)stack_get(translator->fixups, kept_cnt++) = fixup;
+    }
+
+    for (size_t fixup_ind = kept_cnt; fixup_ind < fixups_cnt; ++fixup_ind)
+    {
+        label_fixup_t popped = {};
+        STACK_ERROR_HANDLE_(stack_pop(&translator->fixups, &popped));
+    }
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+enum TranslationError relax_jumps(elf_translator_t* const translator, const bool report)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    relax_jump_t* const jumps = stack_begin(translator->jumps);
+    const size_t jumps_cnt = stack_size(translator->jumps);
+
+    relax_layout_t layout = {.jumps = jumps, .jumps_cnt = jumps_cnt, .shrinks = NULL};
+    layout.shrinks = calloc(jumps_cnt + 1, sizeof(*layout.shrinks));
+    if (!layout.shrinks)
+    {
+        perror("Can't calloc layout.shrinks");
+        return TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    // jumps, that are made short in a pass, are counted as long till the next one,
+    // that only overestimates distances
+    bool is_changed = true;
+    size_t passes_cnt = 0;
+    while (is_changed)
+    {
+        is_changed = false;
+        ++passes_cnt;
+        layout_update_(&layout);
+
+        for (size_t jump_ind = 0; jump_ind < jumps_cnt; ++jump_ind)
+        {
+            if (jumps[jump_ind].is_short || !translator->label_addrs[jumps[jump_ind].label_num])
+                continue;
+
+            const int64_t rel = short_rel_(translator, &layout, jump_ind);
+            if (rel == (int8_t)rel)
+            {
+                jumps[jump_ind].is_short = true;
+                is_changed = true;
+            }
+        }
+    }
+
+    layout_update_(&layout);
+
+    const size_t old_size = translator->text.size;
+
+    TRANSLATION_ERROR_HANDLE(rebuild_text_(translator, &layout), free(layout.shrinks););
+    TRANSLATION_ERROR_HANDLE(move_fixups_(translator, &layout), free(layout.shrinks););
+
+    for (size_t label_num = 0; label_num < translator->labels_cnt; ++label_num)
+    {
+        if (translator->label_addrs[label_num])
+            translator->label_addrs[label_num] = layout_addr_(&layout, translator->label_addrs[label_num]);
+    }
+
+    translator->cur_addr = ENTRY_ADDR_ + translator->text.size;
+
+    if (report)
+    {
+        size_t short_cnt = 0;
+        for (size_t jump_ind = 0; jump_ind < jumps_cnt; ++jump_ind)
+            short_cnt += jumps[jump_ind].is_short;
+
+        fprintf(stderr, "relax: %zu of %zu jumps are rel8 after %zu passes, text %zu -> %zu bytes\n",
+                short_cnt, jumps_cnt, passes_cnt, old_size, translator->text.size);
+    }
+
+    free(layout.shrinks);
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+#undef JMP_SIZE_
+#undef JCC_SIZE_
+#undef SHORT_SIZE_
\ No newline at end of file
@@ -0,0 +1,17 @@
+#ifndef MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_RELAX_H
+#define MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_RELAX_H
+
+#include <stdbool.h>
+
+#include "translation/funcs/elf/structs.h"
+#include "translation/verification/verification.h"
+#include "write_lib.h"
+
+// jcc == OP_CODE_JMP - jmp, rel32 form is written, relax_jumps may shorten it
+enum TranslationError write_label_jmp(elf_translator_t* const translator, const size_t label_num,
+                                      const enum OpCode jcc);
+
+// after the text and before bss label, report - count of short jumps and text size to stderr
+enum TranslationError relax_jumps(elf_translator_t* const translator, const bool report);
+
+#endif /*MASIK_BACKEND_SRC_TRANSLATION_FUNCS_ELF_RELAX_H*/
\ No newline at end of file
@@ -2,47 +2,117 @@
 #define MASIK_BACKEND_SRC_TRANSLATION_STRUCTS_H
 
 #include <stdint.h>
+#include <stdbool.h>
+#include <assert.h>
 #include <elf.h>
 
-#include "hash_table/libhash_table.h"
 #include "stack_on_array/libstack.h"
 #include "ir_fist/structs.h"
+#include "utils/src/memo/structs.h"
+#include "utils/src/interner/interner.h"
+#include "code_buf.h"
 
 #define ENTRY_ADDR_     (0x400000)
 #define ALIGN_          (0x1000)
 
-typedef struct Label
+// bss segment of runtime: stdout buffer with count of bytes in it,
+// stdin buffer with position of the next byte and count of read bytes,
+// value found by memo_get and memo cache
+#define OUT_BUF_SIZE_   (0x10000)
+#define IN_BUF_SIZE_    (0x10000)
+
+#define BSS_OUT_BUF_    (0)
+#define BSS_OUT_CNT_    (BSS_OUT_BUF_ + OUT_BUF_SIZE_)
+#define BSS_IN_POS_     (BSS_OUT_CNT_ + sizeof(uint64_t))
+#define BSS_IN_END_     (BSS_IN_POS_  + sizeof(uint64_t))
+#define BSS_IN_BUF_     (BSS_IN_END_  + sizeof(uint64_t))
+#define BSS_MEMO_VAL_   (BSS_IN_BUF_  + IN_BUF_SIZE_)
+#define BSS_MEMO_       (BSS_MEMO_VAL_ + sizeof(uint64_t))
+#define BSS_SIZE_       (BSS_MEMO_    + MEMO_ENTRIES * MEMO_ENTRY_SIZE_)
+
+#define MEMO_ENTRY_SIZE_ (4 * sizeof(uint64_t))
+static_assert(BSS_MEMO_ % MEMO_ENTRY_SIZE_ == 0, "memo entries are not split by cache lines");
+
+// labels of runtime, they are interned to the same labels as ir ones
+enum RuntimeLabel
 {
-    char name[MAX_LABEL_NAME_SIZE];
-} label_t;
+    RUNTIME_LABEL_BSS           = 0,
+    RUNTIME_LABEL_OUT_FLUSH     = 1,
+    RUNTIME_LABEL_OUT_DIGITS    = 2,
+    RUNTIME_LABEL_MEMO_SLOT     = 3,
+    RUNTIME_LABEL_HLT           = 4,
+    RUNTIME_LABEL_IN            = 5,
+    RUNTIME_LABEL_OUT           = 6,
+    RUNTIME_LABEL_POW           = 7,
+    RUNTIME_LABEL_MEMO_GET      = 8,
+    RUNTIME_LABEL_MEMO_VAL      = 9,
+    RUNTIME_LABEL_MEMO_PUT      = 10,
 
-typedef struct LabelsVal
+    RUNTIME_LABELS_CNT
+};
+
+// rel32 at insert_addr is relative to label, it keeps the addend until labels_processing
+typedef struct LabelFixup
 {
-    size_t label_addr;
-    stack_key_t insert_addrs;
-} labels_val_t;
+    size_t label_num;
+    size_t insert_addr;
+} label_fixup_t;
+
+// jmp or jcc to label, its rel32 form may be relaxed to rel8 one
+typedef struct RelaxJump
+{
+    size_t addr;        // of rel32 form
+    size_t label_num;
+    size_t fixup_ind;   // of its rel32
+    uint8_t jcc;        // second byte of jcc rel32 opcode, OP_CODE_JMP for jmp
+    bool is_short;
+} relax_jump_t;
+
+struct RegAlloc;
+struct Branches;
+struct BranchBlock;
+struct Imms;
+struct ImmBlock;
+struct CallConv;
 
 typedef struct ElfTranslator
 {
-    stack_key_t text;
+    code_buf_t text;
 
     ir_block_t* cur_block;
+    const ir_block_t* next_block;
+    struct RegAlloc* regalloc;
+    struct Branches* branches;
+    const struct BranchBlock* cur_branch;
+    struct Imms* imms;
+    const struct ImmBlock* cur_imm;
+    struct CallConv* callconv;
+
+    bool has_frame;         // frame locations are based on rbp, else on rsp in the red zone
+    bool is_arg_in_reg;     // the last arg of the next call is already in its register
 
     size_t cur_addr;
-    smash_map_t labels_map;
-    stack_key_t labels_stack;
+
+    interner_t* labels;
+    size_t runtime_labels[RUNTIME_LABELS_CNT];  // label_num of runtime ones
+    size_t labels_cnt;
+    size_t* label_addrs;                        // by label_num, 0 - label isn't placed
+    stack_key_t fixups;
+    stack_key_t jumps;                          // in order of addr
 } elf_translator_t;
 
 typedef struct ElfHeaders
 {
     Elf64_Ehdr ehdr;
     Elf64_Phdr phdr_text;
+    Elf64_Phdr phdr_bss;
 
     const char* shstrtab;
     size_t shstrtab_size;
     Elf64_Shdr shdr_zero;
     Elf64_Shdr shdr_shstrtab;
     Elf64_Shdr shdr_text;
+    Elf64_Shdr shdr_bss;
 } elf_headers_t;
 
 #endif /*MASIK_BACKEND_SRC_TRANSLATION_STRUCTS_H*/
\ No newline at end of file
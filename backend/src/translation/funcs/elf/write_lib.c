@@ -1,26 +1,13 @@
 #include <unistd.h>
+#include <string.h>
 #include <elf.h>
 
 #include "utils/utils.h"
-#include "stack_on_array/libstack.h"
 #include "ir_fist/funcs/funcs.h"
 #include "ir_fist/structs.h"
 #include "translation/funcs/elf/structs.h"
-#include "map_utils.h"
 #include "write_lib.h"
 
-#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
-    do {                                                                                            \
-        const enum StackError stack_error_handler = call_func;                                      \
-        if (stack_error_handler)                                                                    \
-        {                                                                                           \
-            fprintf(stderr, "Can't " #call_func". Stack error: %s\n",                               \
-                            stack_strerror(stack_error_handler));                                   \
-            __VA_ARGS__                                                                             \
-            return TRANSLATION_ERROR_STACK;                                                         \
-        }                                                                                           \
-    } while(0)
-
 // static size_t get_imm_size_(const int64_t imm)
 // {
 //     if (imm == (int8_t)imm)
@@ -46,99 +33,42 @@ static uint8_t create_sib_(const enum RegNum base_reg)
     return (uint8_t)((SIB_SCALE1 << 6) + (SIB_NO_INDEX << 3) + (base_reg % 8));
 }
 
-static enum TranslationError write_byte_(stack_key_t stack, const uint8_t byte)
-{
-    STACK_ERROR_HANDLE_(stack_push(&stack, &byte)); 
-
-    return TRANSLATION_ERROR_SUCCESS;
-}
-
-static enum TranslationError write_word_(stack_key_t stack, const uint16_t word)
-{
-    const uint8_t* word_ptr = (const uint8_t*)&word;
-
-    STACK_ERROR_HANDLE_(stack_push(&stack, word_ptr + 0)); 
-    STACK_ERROR_HANDLE_(stack_push(&stack, word_ptr + 1)); 
-
-    return TRANSLATION_ERROR_SUCCESS;
-}
-
-static enum TranslationError write_dword_(stack_key_t stack, const uint32_t dword)
-{
-    const uint8_t* dword_ptr = (const uint8_t*)&dword;
-
-    STACK_ERROR_HANDLE_(stack_push(&stack, dword_ptr + 0)); 
-    STACK_ERROR_HANDLE_(stack_push(&stack, dword_ptr + 1)); 
-    STACK_ERROR_HANDLE_(stack_push(&stack, dword_ptr + 2)); 
-    STACK_ERROR_HANDLE_(stack_push(&stack, dword_ptr + 3)); 
-
-    return TRANSLATION_ERROR_SUCCESS;
-}
-
-static enum TranslationError write_qword_(stack_key_t stack, const uint64_t qword)
-{
-    const uint8_t* qword_ptr = (const uint8_t*)&qword;
-
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 0));
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 1));
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 2));
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 3));
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 4));
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 5));
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 6));
-    STACK_ERROR_HANDLE_(stack_push(&stack, qword_ptr + 7));
-
-    return TRANSLATION_ERROR_SUCCESS;
-}
-
 enum TranslationError write_byte_text(elf_translator_t* const translator, const uint8_t byte)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    TRANSLATION_ERROR_HANDLE(write_byte_(translator->text, byte));
-
-    return TRANSLATION_ERROR_SUCCESS;
+    return code_buf_append(&translator->text, &byte, sizeof(byte));
 }
 
 enum TranslationError write_word_text(elf_translator_t* const translator, const uint16_t word)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    TRANSLATION_ERROR_HANDLE(write_word_(translator->text, word));
-
-    return TRANSLATION_ERROR_SUCCESS;
+    return code_buf_append(&translator->text, &word, sizeof(word));
 }
 
 enum TranslationError write_dword_text(elf_translator_t* const translator, const uint32_t dword)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    TRANSLATION_ERROR_HANDLE(write_dword_(translator->text, dword));
-
-    return TRANSLATION_ERROR_SUCCESS;
+    return code_buf_append(&translator->text, &dword, sizeof(dword));
 }
 
 enum TranslationError write_qword_text(elf_translator_t* const translator, const uint64_t qword)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    TRANSLATION_ERROR_HANDLE(write_qword_(translator->text, qword));
-
-    return TRANSLATION_ERROR_SUCCESS;
+    return code_buf_append(&translator->text, &qword, sizeof(qword));
 }
 
 enum TranslationError write_arr_text(elf_translator_t* const translator, const uint8_t* const arr, const size_t size)
 {
     lassert(!is_invalid_ptr(translator), "");
 
-    for (size_t num = 0; num < size; ++num)
-    {
-        TRANSLATION_ERROR_HANDLE(write_byte_text(translator, arr[num]));
-    }
-
-    return TRANSLATION_ERROR_SUCCESS;
+    return code_buf_append(&translator->text, arr, size);
 }
 
+#define MAX_INSTR_SIZE_ 15
 static enum TranslationError write_command_(
                                             elf_translator_t* const translator,
                                             const enum OpCode opcode,
@@ -151,54 +81,43 @@ static enum TranslationError write_command_(
 {
     lassert(!is_invalid_ptr(translator), "");
 
+    // instruction is encoded here and goes to the text by one append
+    uint8_t instr[MAX_INSTR_SIZE_] = {};
     size_t instr_size = 0;
 
-    if (rex) {
-        TRANSLATION_ERROR_HANDLE(write_byte_text(translator, rex));
-        ++instr_size;
-    }
-
-    TRANSLATION_ERROR_HANDLE(write_byte_text(translator, (uint8_t)opcode));
-    ++instr_size;
+    if (rex)
+        instr[instr_size++] = rex;
 
-    if (modrm != 0) {
-        TRANSLATION_ERROR_HANDLE(write_byte_text(translator, modrm));
-        ++instr_size;
-    }
+    instr[instr_size++] = (uint8_t)opcode;
 
-    if (sib != 0) {
-        TRANSLATION_ERROR_HANDLE(write_byte_text(translator, sib));
-        ++instr_size;
-    }
+    if (modrm != 0)
+        instr[instr_size++] = modrm;
 
+    if (sib != 0)
+        instr[instr_size++] = sib;
 
     switch (imm_size) {
         case 0:
-            break;
         case sizeof(uint8_t):
-            TRANSLATION_ERROR_HANDLE(write_byte_text(translator, (uint8_t)imm));
-            instr_size += sizeof(uint8_t);
-            break;
         case sizeof(uint16_t):
-            TRANSLATION_ERROR_HANDLE(write_word_text(translator, (uint16_t)imm));
-            instr_size += sizeof(uint16_t);
-            break;
         case sizeof(uint32_t):
-            TRANSLATION_ERROR_HANDLE(write_dword_text(translator, (uint32_t)imm));
-            instr_size += sizeof(uint32_t);
-            break;
         case sizeof(uint64_t):
-            TRANSLATION_ERROR_HANDLE(write_qword_text(translator, (uint64_t)imm));
-            instr_size += sizeof(uint64_t);
             break;
         default:
             return TRANSLATION_ERROR_INVALID_IMM_SIZE;
     }
 
+    // little endian, so the low bytes of imm are the imm of size imm_size
+    memcpy(instr + instr_size, &imm, imm_size);
+    instr_size += imm_size;
+
+    TRANSLATION_ERROR_HANDLE(code_buf_append(&translator->text, instr, instr_size));
+
     translator->cur_addr += instr_size;
 
     return TRANSLATION_ERROR_SUCCESS;
 }
+#undef MAX_INSTR_SIZE_
 
 
 //E8 cd
@@ -276,8 +195,8 @@ enum TranslationError write_push_irm(elf_translator_t* const translator,
             translator, 
             OP_CODE_PUSH_IRM, 
             REX_W | (reg > 7 ? REX_B : 0),
-            create_modrm_(MOD_RM_OFF4, (const enum RegNum)OP_CODE_MOD_PUSH_IRM, reg),
-            0,
+            create_modrm_(MOD_RM_OFF4, (const enum RegNum)OP_CODE_MOD_PUSH_IRM, MOD_RM_USE_SIB),
+            create_sib_(reg),
             (uint64_t)imm,
             sizeof(uint32_t)
         )
@@ -322,8 +241,8 @@ enum TranslationError write_pop_irm     (elf_translator_t* const translator,
             translator, 
             OP_CODE_POP_IRM, 
             REX_W | (reg > 7 ? REX_B : 0),
-            create_modrm_(MOD_RM_OFF4, (const enum RegNum)OP_CODE_MOD_POP_IRM, reg),
-            0,
+            create_modrm_(MOD_RM_OFF4, (const enum RegNum)OP_CODE_MOD_POP_IRM, MOD_RM_USE_SIB),
+            create_sib_(reg),
             (uint64_t)imm,
             sizeof(uint32_t)
         )
@@ -367,7 +286,7 @@ enum TranslationError write_mov_r_irm(elf_translator_t* const translator,
         write_command_(
             translator, 
             OP_CODE_MOV_R_IRM,
-            REX_W | (reg1 > 7 ? REX_B : 0) | (reg2 > 7 ? REX_R : 0), 
+            REX_W | (reg1 > 7 ? REX_R : 0) | (reg2 > 7 ? REX_B : 0), 
             create_modrm_(MOD_RM_OFF4, reg1, MOD_RM_USE_SIB),
             create_sib_(reg2),
             (uint64_t)imm,
@@ -378,6 +297,30 @@ enum TranslationError write_mov_r_irm(elf_translator_t* const translator,
     return TRANSLATION_ERROR_SUCCESS;
 }
 
+// REX.W + 89 /r
+// MOV r/m64, r64
+enum TranslationError write_mov_irm_r(elf_translator_t* const translator, 
+                                      const enum RegNum reg1,
+                                      const int64_t imm,
+                                      const enum RegNum reg2)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(
+        write_command_(
+            translator, 
+            OP_CODE_MOV_R_R,
+            REX_W | (reg2 > 7 ? REX_R : 0) | (reg1 > 7 ? REX_B : 0), 
+            create_modrm_(MOD_RM_OFF4, reg2, MOD_RM_USE_SIB),
+            create_sib_(reg1),
+            (uint64_t)imm,
+            sizeof(uint32_t)
+        )
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
 //REX.W + B8+ rd io
 enum TranslationError write_mov_r_i(elf_translator_t* const translator, 
                                         const enum RegNum reg,
@@ -568,6 +511,171 @@ enum TranslationError write_idiv_r(elf_translator_t* const translator, const enu
     return TRANSLATION_ERROR_SUCCESS;
 }
 
+// REX.W + 69 /r id
+// IMUL r64, r/m64, imm32
+enum TranslationError write_imul_r_r_i(elf_translator_t* const translator, 
+                                       const enum RegNum reg1,
+                                       const enum RegNum reg2,
+                                       const int64_t imm)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(
+        write_command_(
+            translator, 
+            OP_CODE_IMUL_R_R_I,
+            REX_W | (reg1 > 7 ? REX_R : 0) | (reg2 > 7 ? REX_B : 0), 
+            create_modrm_(MOD_RM_RR, reg1, reg2),
+            0,
+            (uint64_t)imm,
+            sizeof(uint32_t)
+        )
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+// REX.W + F7 /5
+// IMUL r/m64: rdx:rax = rax * r/m64
+enum TranslationError write_imul_r(elf_translator_t* const translator, const enum RegNum reg)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(
+        write_command_(
+            translator, 
+            OP_CODE_IMUL_R,
+            REX_W | (reg > 7 ? REX_B : 0), 
+            create_modrm_(MOD_RM_RR, (const enum RegNum)OP_CODE_MOD_IMUL_R, reg),
+            0,
+            0,
+            0
+        )
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+// REX.W + 99
+// CQO: rdx:rax = sign-extend rax
+enum TranslationError write_cqo(elf_translator_t* const translator)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(
+        write_command_(
+            translator, 
+            OP_CODE_CQO,
+            REX_W, 
+            0,
+            0,
+            0,
+            0
+        )
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+// REX.W + F7 /3
+enum TranslationError write_neg_r(elf_translator_t* const translator, const enum RegNum reg)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    TRANSLATION_ERROR_HANDLE(
+        write_command_(
+            translator, 
+            OP_CODE_NEG_R,
+            REX_W | (reg > 7 ? REX_B : 0), 
+            create_modrm_(MOD_RM_RR, (const enum RegNum)OP_CODE_MOD_NEG_R, reg),
+            0,
+            0,
+            0
+        )
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum TranslationError write_shift_r_i_(elf_translator_t* const translator, 
+                                              const enum OpCodeModRM shift,
+                                              const enum RegNum reg,
+                                              const int64_t imm)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(imm >= 0 && imm < 64, "");
+
+    TRANSLATION_ERROR_HANDLE(
+        write_command_(
+            translator, 
+            OP_CODE_SHIFT_R_I,
+            REX_W | (reg > 7 ? REX_B : 0), 
+            create_modrm_(MOD_RM_RR, (const enum RegNum)shift, reg),
+            0,
+            (uint64_t)imm,
+            sizeof(uint8_t)
+        )
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
+// REX.W + C1 /4 ib
+enum TranslationError write_shl_r_i(elf_translator_t* const translator, 
+                                    const enum RegNum reg,
+                                    const int64_t imm)
+{
+    return write_shift_r_i_(translator, OP_CODE_MOD_SHL_R_I, reg, imm);
+}
+
+// REX.W + C1 /5 ib
+enum TranslationError write_shr_r_i(elf_translator_t* const translator, 
+                                    const enum RegNum reg,
+                                    const int64_t imm)
+{
+    return write_shift_r_i_(translator, OP_CODE_MOD_SHR_R_I, reg, imm);
+}
+
+// REX.W + C1 /7 ib
+enum TranslationError write_sar_r_i(elf_translator_t* const translator, 
+                                    const enum RegNum reg,
+                                    const int64_t imm)
+{
+    return write_shift_r_i_(translator, OP_CODE_MOD_SAR_R_I, reg, imm);
+}
+
+// REX.W + 8D /r
+// LEA r64, [base + index * scale]
+enum TranslationError write_lea_r_rr(elf_translator_t* const translator, 
+                                     const enum RegNum reg1,
+                                     const enum RegNum reg2,
+                                     const enum RegNum reg3,
+                                     const enum SIBScale scale)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    // without displacement base rbp/r13 means disp32 only, index rsp means no index
+    lassert(reg2 % 8 != REG_NUM_RBP, "");
+    lassert(reg3 != REG_NUM_RSP, "");
+
+    const uint8_t sib = (uint8_t)((scale << 6) + ((reg3 % 8) << 3) + (reg2 % 8));
+    // zero sib isn't written by write_command_
+    lassert(sib != 0, "");
+
+    TRANSLATION_ERROR_HANDLE(
+        write_command_(
+            translator, 
+            OP_CODE_LEA_R_RR,
+            REX_W | (reg1 > 7 ? REX_R : 0) | (reg3 > 7 ? REX_X : 0) | (reg2 > 7 ? REX_B : 0), 
+            create_modrm_(MOD_RM_OFF0, reg1, MOD_RM_USE_SIB),
+            sib,
+            0,
+            0
+        )
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
+
 //C3
 enum TranslationError write_ret(elf_translator_t* const translator)
 {
@@ -3,6 +3,7 @@
 
 #include "ir_fist/structs.h"
 #include "translation/funcs/elf/structs.h"
+#include "translation/verification/verification.h"
 
 #define REX     (0b01000000)
 #define REX_W   (0b01001000)
@@ -63,8 +64,17 @@ enum OpCode
 
     OP_CODE_IMUL_R_R_1  = 0x0F,
     OP_CODE_IMUL_R_R_2  = 0xAF,
+    OP_CODE_IMUL_R_R_I  = 0x69,
+    OP_CODE_IMUL_R      = 0xF7,
 
     OP_CODE_IDIV_R      = 0xF7,
+    OP_CODE_CQO         = 0x99,
+
+    OP_CODE_NEG_R       = 0xF7,
+
+    OP_CODE_SHIFT_R_I   = 0xC1,
+
+    OP_CODE_LEA_R_RR    = 0x8D,
 
     OP_CODE_RET         = 0xC3,
 
@@ -77,8 +87,10 @@ enum OpCode
 
 
     OP_CODE_JMP         = 0xE9,
+    OP_CODE_JMP_REL8    = 0xEB,
 
     OP_CODE_PREF_JMP    = 0x0F,
+    OP_CODE_JCC_REL8    = 0x70, // + low 4 bits of jcc rel32 opcode
 
     OP_CODE_JA          = 0x87,   
     OP_CODE_JAE         = 0x83,   
@@ -145,6 +157,14 @@ enum OpCodeModRM
 
     OP_CODE_MOD_IDIV_R      = 0x7,
 
+    OP_CODE_MOD_IMUL_R      = 0x5,
+
+    OP_CODE_MOD_NEG_R       = 0x3,
+
+    OP_CODE_MOD_SHL_R_I     = 0x4,
+    OP_CODE_MOD_SHR_R_I     = 0x5,
+    OP_CODE_MOD_SAR_R_I     = 0x7,
+
     OP_CODE_MOD_SET         = 0x0,
 };
 
@@ -186,6 +206,10 @@ enum TranslationError write_mov_r_irm   (elf_translator_t* const translator,
                                         const enum RegNum reg1,
                                         const enum RegNum reg2,
                                         const int64_t imm);
+enum TranslationError write_mov_irm_r   (elf_translator_t* const translator, 
+                                        const enum RegNum reg1,
+                                        const int64_t imm,
+                                        const enum RegNum reg2);
 enum TranslationError write_mov_r_i     (elf_translator_t* const translator, 
                                         const enum RegNum reg,
                                         const int64_t imm);
@@ -211,7 +235,32 @@ enum TranslationError write_imul_r_r    (elf_translator_t* const translator,
                                         const enum RegNum reg1,
                                         const enum RegNum reg2);
 
+enum TranslationError write_imul_r_r_i  (elf_translator_t* const translator, 
+                                        const enum RegNum reg1,
+                                        const enum RegNum reg2,
+                                        const int64_t imm);
+enum TranslationError write_imul_r      (elf_translator_t* const translator, const enum RegNum reg);
+
 enum TranslationError write_idiv_r       (elf_translator_t* const translator, const enum RegNum reg);
+enum TranslationError write_cqo         (elf_translator_t* const translator);
+
+enum TranslationError write_neg_r       (elf_translator_t* const translator, const enum RegNum reg);
+
+enum TranslationError write_shl_r_i     (elf_translator_t* const translator, 
+                                        const enum RegNum reg,
+                                        const int64_t imm);
+enum TranslationError write_shr_r_i     (elf_translator_t* const translator, 
+                                        const enum RegNum reg,
+                                        const int64_t imm);
+enum TranslationError write_sar_r_i     (elf_translator_t* const translator, 
+                                        const enum RegNum reg,
+                                        const int64_t imm);
+
+enum TranslationError write_lea_r_rr    (elf_translator_t* const translator, 
+                                        const enum RegNum reg1,
+                                        const enum RegNum reg2,
+                                        const enum RegNum reg3,
+                                        const enum SIBScale scale);
 
 enum TranslationError write_ret         (elf_translator_t* const translator);
 enum TranslationError write_syscall     (elf_translator_t* const translator);
@@ -2,16 +2,27 @@
 #define MASIK_BACKEND_SRC_TRANSLATION_FUNCS_FUNCS_H
 
 #include <stdio.h>
+#include <stdbool.h>
 
 #include "utils/src/tree/structs.h"
 #include "../verification/verification.h"
 #include "hash_table/libs/list_on_array/libfist.h"
+#include "utils/src/interner/interner.h"
 
-enum TranslationError translate_splu(const fist_t* const fist, FILE* out);
+// labels - names of ir blocks label_num
+enum TranslationError translate_splu(const fist_t* const fist, const interner_t* const labels, FILE* out);
 
-enum TranslationError translate_nasm(const fist_t* const fist, FILE* out);
+enum TranslationError translate_nasm(const fist_t* const fist, const interner_t* const labels, FILE* out);
 
-enum TranslationError translate_elf (const fist_t* const fist, FILE* out);
+typedef struct ElfOpts
+{
+    bool regalloc;
+    bool report;    // jumps relaxation summary to stderr
+} elf_opts_t;
+
+// runtime labels are interned to labels too
+enum TranslationError translate_elf (const fist_t* const fist, interner_t* const labels, FILE* out,
+                                     const elf_opts_t opts);
 
 
 #endif /* MASIK_BACKEND_SRC_TRANSLATION_FUNCS_FUNCS_H */
\ No newline at end of file
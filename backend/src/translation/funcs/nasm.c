@@ -1,29 +1,36 @@
+#include <stdint.h>
+#include <inttypes.h>
+
 #include "utils/utils.h"
 #include "stack_on_array/libstack.h"
 #include "funcs.h"
 #include "ir_fist/funcs/funcs.h"
 #include "ir_fist/structs.h"
+#include "utils/src/memo/structs.h"
 
 static enum TranslationError translate_syscall_hlt_(FILE* out);
 static enum TranslationError translate_syscall_in_(FILE* out);
 static enum TranslationError translate_syscall_out_(FILE* out);
 static enum TranslationError translate_syscall_pow_(FILE* out);
+static enum TranslationError translate_memo_(FILE* out);
 
 #define CUR_BLOCK_ ((const ir_block_t*)fist->data + elem_ind)
 
 #define IR_OP_BLOCK_HANDLE(num_, name_, ...)                                                        \
-        static enum TranslationError translate_##name_(const ir_block_t* const block, FILE* out);
+        static enum TranslationError translate_##name_(const ir_block_t* const block,               \
+                                                       const interner_t* const labels, FILE* out);
 
 #include "PYAM_IR/include/codegen.h"
 
 #undef IR_OP_BLOCK_HANDLE
 
 #define IR_OP_BLOCK_HANDLE(num_, name_, ...)                                                        \
-        case num_: TRANSLATION_ERROR_HANDLE(translate_##name_(CUR_BLOCK_, out)); break;
+        case num_: TRANSLATION_ERROR_HANDLE(translate_##name_(CUR_BLOCK_, labels, out)); break;
 
-enum TranslationError translate_nasm(const fist_t* const fist, FILE* out)
+enum TranslationError translate_nasm(const fist_t* const fist, const interner_t* const labels, FILE* out)
 {
     FIST_VERIFY_ASSERT(fist, NULL);
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
     fprintf(out,
@@ -50,28 +57,33 @@ enum TranslationError translate_nasm(const fist_t* const fist, FILE* out)
     TRANSLATION_ERROR_HANDLE(translate_syscall_in_(out));
     TRANSLATION_ERROR_HANDLE(translate_syscall_out_(out));
     TRANSLATION_ERROR_HANDLE(translate_syscall_pow_(out));
+    TRANSLATION_ERROR_HANDLE(translate_memo_(out));
 
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_CALL_FUNCTION(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_CALL_FUNCTION(const ir_block_t* const block,
+                                                     const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
-    fprintf(out, "call %s\n", block->label_str);
+    fprintf(out, "call %ls\n", interner_get(labels, block->label_num));
     fprintf(out, "push rax\n");
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_FUNCTION_BODY(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_FUNCTION_BODY(const ir_block_t* const block,
+                                                     const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
-    fprintf(out, "\n%s:\n", block->label_str);
+    fprintf(out, "\n%ls:\n", interner_get(labels, block->label_num));
 
     fprintf(out, "pop rax ; save ret val\n");
     fprintf(out, "mov rbx, rbp ; save old rbp\n");
@@ -88,9 +100,11 @@ static enum TranslationError translate_FUNCTION_BODY(const ir_block_t* const blo
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_COND_JUMP(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_COND_JUMP(const ir_block_t* const block,
+                                                 const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
     if (block->operand1_type == IR_OPERAND_TYPE_NUM)
@@ -103,15 +117,17 @@ static enum TranslationError translate_COND_JUMP(const ir_block_t* const block,
     }
 
     fprintf(out, "test rbx, rbx\n");
-    fprintf(out, "jne %s\n\n", block->label_str);
+    fprintf(out, "jne %ls\n\n", interner_get(labels, block->label_num));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_ASSIGNMENT(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_ASSIGNMENT(const ir_block_t* const block,
+                                                  const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     if (block->ret_type == IR_OPERAND_TYPE_TMP && block->operand1_type == IR_OPERAND_TYPE_VAR)
     {
@@ -119,7 +135,13 @@ static enum TranslationError translate_ASSIGNMENT(const ir_block_t* const block,
     }
     else if (block->ret_type == IR_OPERAND_TYPE_TMP && block->operand1_type == IR_OPERAND_TYPE_NUM)
     {
-        fprintf(out, "push %zu\n", block->operand1_num);
+        const int64_t num = (int64_t)block->operand1_num;
+
+        // push sign-extends imm32 only
+        if (num >= INT32_MIN && num <= INT32_MAX)
+            fprintf(out, "push %" PRId64 "\n", num);
+        else
+            fprintf(out, "mov rbx, %" PRId64 "\npush rbx\n", num);
     }
     else if (block->ret_type == IR_OPERAND_TYPE_VAR && block->operand1_type == IR_OPERAND_TYPE_TMP)
     {
@@ -128,10 +150,12 @@ static enum TranslationError translate_ASSIGNMENT(const ir_block_t* const block,
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_OPERATION(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_OPERATION(const ir_block_t* const block,
+                                                 const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     fprintf(out,
         "pop rcx\n"
@@ -164,8 +188,8 @@ static enum TranslationError translate_OPERATION(const ir_block_t* const block,
         case IR_OP_TYPE_DIV:
         {
             fprintf(out, 
-                "xor rdx, rdx\n"
                 "mov rax, rbx\n"
+                "cqo\n"
                 "idiv rcx\n"
                 "mov rbx, rax\n"
             );
@@ -240,10 +264,12 @@ static enum TranslationError translate_OPERATION(const ir_block_t* const block,
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_RETURN(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_RETURN(const ir_block_t* const block,
+                                              const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     fprintf(out, 
         "pop rax ; save ret val\n"
@@ -258,26 +284,30 @@ static enum TranslationError translate_RETURN(const ir_block_t* const block, FIL
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_LABEL(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_LABEL(const ir_block_t* const block,
+                                             const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
-    fprintf(out, "%s:\n", block->label_str);
+    fprintf(out, "%ls:\n", interner_get(labels, block->label_num));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_SYSCALL(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_SYSCALL(const ir_block_t* const block,
+                                               const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
-    fprintf(out, "call %s\n", block->label_str);
+    fprintf(out, "call %ls\n", interner_get(labels, block->label_num));
 
     fprintf(out, "add rsp, %zu\n", 8*block->operand1_num);
 
-    if (kIR_SYS_CALL_ARRAY[block->operand2_num].HaveRetVal)
+    if (ir_block_syscall_have_ret_val(block))
     {
         fprintf(out, "push rax ; ret val\n");
     }
@@ -285,10 +315,12 @@ static enum TranslationError translate_SYSCALL(const ir_block_t* const block, FI
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_GLOBAL_VARS(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_GLOBAL_VARS(const ir_block_t* const block,
+                                                   const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     return TRANSLATION_ERROR_SUCCESS;
 }
@@ -507,4 +539,83 @@ static enum TranslationError translate_syscall_pow_(FILE* out)
     );
 
     return TRANSLATION_ERROR_SUCCESS;
-}
\ No newline at end of file
+}
+
+static enum TranslationError translate_memo_(FILE* out)
+{
+    lassert(!is_invalid_ptr(out), "");
+
+    fprintf(out,
+        ";;; ---------------------------------------------\n"
+        ";;; Descript:   looks for result of pure func in memo cache\n"
+        ";;; Entry:      pushed args = id, arg0, arg1\n"
+        ";;; Exit:       rax = 1 if found, result is in memo_val\n"
+        ";;; Destroy:    rcx, rdx, rsi, rdi, r8\n"
+        ";;; ---------------------------------------------\n"
+        MEMO_GET_NAME ":\n"
+        "    call memo_slot\n"
+        "    xor eax, eax\n"
+        "    cmp [r8], rsi                           ; id\n"
+        "    jne .exit\n"
+        "    cmp [r8 + 8], rcx                       ; arg0\n"
+        "    jne .exit\n"
+        "    cmp [r8 + 16], rdx                      ; arg1\n"
+        "    jne .exit\n"
+        "    mov rdx, [r8 + 24]\n"
+        "    mov [rel memo_found], rdx\n"
+        "    inc eax\n"
+        ".exit:\n"
+        "    ret\n\n"
+
+        MEMO_VAL_NAME ":\n"
+        "    mov rax, [rel memo_found]\n"
+        "    ret\n\n"
+
+        ";;; ---------------------------------------------\n"
+        ";;; Descript:   puts result of pure func in memo cache\n"
+        ";;; Entry:      pushed args = val, id, arg0, arg1\n"
+        ";;; Exit:       rax = val\n"
+        ";;; Destroy:    rcx, rdx, rsi, rdi, r8\n"
+        ";;; ---------------------------------------------\n"
+        MEMO_PUT_NAME ":\n"
+        "    call memo_slot\n"
+        "    mov [r8], rsi\n"
+        "    mov [r8 + 8], rcx\n"
+        "    mov [r8 + 16], rdx\n"
+        "    mov rax, [rsp + 32]                     ; val\n"
+        "    mov [r8 + 24], rax\n"
+        "    ret\n\n"
+
+        ";;; ---------------------------------------------\n"
+        ";;; Descript:   entry of memo cache for the key\n"
+        ";;; Entry:      key above two ret addrs\n"
+        ";;; Exit:       r8 = entry, rsi = id + 1, rcx = arg0, rdx = arg1\n"
+        ";;; Destroy:    rax, rdi\n"
+        ";;; ---------------------------------------------\n"
+        "memo_slot:\n"
+        "    mov rsi, [rsp + 32]                     ; id\n"
+        "    inc rsi                                 ; 0 - empty entry\n"
+        "    mov rcx, [rsp + 24]                     ; arg0\n"
+        "    mov rdx, [rsp + 16]                     ; arg1\n"
+        "    mov rdi, %#lx\n"
+        "    mov rax, rsi\n"
+        "    imul rax, rdi\n"
+        "    xor rax, rcx\n"
+        "    imul rax, rdi\n"
+        "    xor rax, rdx\n"
+        "    imul rax, rdi\n"
+        "    shr rax, %d\n"
+        "    shl rax, 5                              ; entry is 32 bytes\n"
+        "    lea r8, [rel memo_cache]\n"
+        "    add r8, rax\n"
+        "    ret\n\n"
+
+        "section .bss\n"
+        "memo_found: resq 1\n"
+        "alignb 32\n"
+        "memo_cache: resq %lu\n",
+        MEMO_HASH_MUL, 64 - MEMO_ENTRIES_LOG, 4 * MEMO_ENTRIES
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
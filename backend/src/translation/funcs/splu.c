@@ -3,6 +3,7 @@
 #include "funcs.h"
 #include "ir_fist/funcs/funcs.h"
 #include "ir_fist/structs.h"
+#include "utils/src/memo/structs.h"
 
 #define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
     do {                                                                                            \
@@ -20,22 +21,25 @@ static enum TranslationError translate_syscall_hlt_(FILE* out);
 static enum TranslationError translate_syscall_in_(FILE* out);
 static enum TranslationError translate_syscall_out_(FILE* out);
 static enum TranslationError translate_syscall_pow_(FILE* out);
+static enum TranslationError translate_memo_(FILE* out);
 
 #define CUR_BLOCK_ ((const ir_block_t*)fist->data + elem_ind)
 
 #define IR_OP_BLOCK_HANDLE(num_, name_, ...)                                                        \
-        static enum TranslationError translate_##name_(const ir_block_t* const block, FILE* out);
+        static enum TranslationError translate_##name_(const ir_block_t* const block,               \
+                                                       const interner_t* const labels, FILE* out);
 
 #include "PYAM_IR/include/codegen.h"
 
 #undef IR_OP_BLOCK_HANDLE
 
 #define IR_OP_BLOCK_HANDLE(num_, name_, ...)                                                        \
-        case num_: TRANSLATION_ERROR_HANDLE(translate_##name_(CUR_BLOCK_, out)); break;
+        case num_: TRANSLATION_ERROR_HANDLE(translate_##name_(CUR_BLOCK_, labels, out)); break;
 
-enum TranslationError translate_splu(const fist_t* const fist, FILE* out)
+enum TranslationError translate_splu(const fist_t* const fist, const interner_t* const labels, FILE* out)
 {
     FIST_VERIFY_ASSERT(fist, NULL);
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
     fprintf(out, "PUSH 0\n");
@@ -60,17 +64,20 @@ enum TranslationError translate_splu(const fist_t* const fist, FILE* out)
     TRANSLATION_ERROR_HANDLE(translate_syscall_in_(out));
     TRANSLATION_ERROR_HANDLE(translate_syscall_out_(out));
     TRANSLATION_ERROR_HANDLE(translate_syscall_pow_(out));
+    TRANSLATION_ERROR_HANDLE(translate_memo_(out));
 
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_CALL_FUNCTION(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_CALL_FUNCTION(const ir_block_t* const block,
+                                                     const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
-    fprintf(out, "CALL :%s\n", block->label_str);
+    fprintf(out, "CALL :%ls\n", interner_get(labels, block->label_num));
     fprintf(out, // ret val
         "PUSH R3\n"
     );
@@ -78,12 +85,14 @@ static enum TranslationError translate_CALL_FUNCTION(const ir_block_t* const blo
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_FUNCTION_BODY(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_FUNCTION_BODY(const ir_block_t* const block,
+                                                     const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
-    fprintf(out, "\n:%s\n", block->label_str);
+    fprintf(out, "\n:%ls\n", interner_get(labels, block->label_num));
     // //save ret val
     // fprintf(out, "POP R3\n");
 
@@ -105,9 +114,11 @@ static enum TranslationError translate_FUNCTION_BODY(const ir_block_t* const blo
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_COND_JUMP(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_COND_JUMP(const ir_block_t* const block,
+                                                 const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
     if (block->operand1_type == IR_OPERAND_TYPE_NUM)
@@ -116,15 +127,17 @@ static enum TranslationError translate_COND_JUMP(const ir_block_t* const block,
     }
 
     fprintf(out, "PUSH 1\n");
-    fprintf(out, "JE :%s\n\n", block->label_str);
+    fprintf(out, "JE :%ls\n\n", interner_get(labels, block->label_num));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_ASSIGNMENT(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_ASSIGNMENT(const ir_block_t* const block,
+                                                  const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     if (block->ret_type == IR_OPERAND_TYPE_TMP && block->operand1_type == IR_OPERAND_TYPE_VAR)
     {
@@ -152,10 +165,12 @@ static enum TranslationError translate_ASSIGNMENT(const ir_block_t* const block,
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_OPERATION(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_OPERATION(const ir_block_t* const block,
+                                                 const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     switch(block->operation_num)
     {
@@ -220,10 +235,12 @@ static enum TranslationError translate_OPERATION(const ir_block_t* const block,
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_RETURN(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_RETURN(const ir_block_t* const block,
+                                              const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     fprintf(out, 
         "PUSH R1\n"
@@ -236,19 +253,23 @@ static enum TranslationError translate_RETURN(const ir_block_t* const block, FIL
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_LABEL(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_LABEL(const ir_block_t* const block,
+                                             const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
-    fprintf(out, ":%s\n", block->label_str);
+    fprintf(out, ":%ls\n", interner_get(labels, block->label_num));
 
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_SYSCALL(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_SYSCALL(const ir_block_t* const block,
+                                               const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
+    lassert(!is_invalid_ptr(labels), "");
     lassert(!is_invalid_ptr(out), "");
 
     // // push rbp
@@ -260,11 +281,11 @@ static enum TranslationError translate_SYSCALL(const ir_block_t* const block, FI
     fprintf(out, "SUB\n");
     fprintf(out, "POP R1\n");
 
-    fprintf(out, "CALL :%s\n", block->label_str);
+    fprintf(out, "CALL :%ls\n", interner_get(labels, block->label_num));
 
     fprintf(out, "POP R1\n");
 
-    if (kIR_SYS_CALL_ARRAY[block->operand2_num].HaveRetVal)
+    if (ir_block_syscall_have_ret_val(block))
     {
         fprintf(out, "PUSH R3\n"); // ret val
     }
@@ -272,10 +293,12 @@ static enum TranslationError translate_SYSCALL(const ir_block_t* const block, FI
     return TRANSLATION_ERROR_SUCCESS;
 }
 
-static enum TranslationError translate_GLOBAL_VARS(const ir_block_t* const block, FILE* out)
+static enum TranslationError translate_GLOBAL_VARS(const ir_block_t* const block,
+                                                   const interner_t* const labels, FILE* out)
 {
     lassert(!is_invalid_ptr(block), "");
     lassert(!is_invalid_ptr(out), "");
+    (void)labels;
 
     return TRANSLATION_ERROR_SUCCESS;
 }
@@ -340,4 +363,25 @@ static enum TranslationError translate_syscall_pow_(FILE* out)
     );
 
     return TRANSLATION_ERROR_SUCCESS;
-}
\ No newline at end of file
+}
+
+// SPU has no memory for the cache, so nothing is found and results are only passed through
+static enum TranslationError translate_memo_(FILE* out)
+{
+    lassert(!is_invalid_ptr(out), "");
+
+    fprintf(out,
+        ":" MEMO_GET_NAME "\n"
+        ":" MEMO_VAL_NAME "\n"
+        "PUSH 0\n"
+        "POP R3\n"
+        "RET\n\n"
+
+        ":" MEMO_PUT_NAME "\n"
+        "PUSH [R1]\n"
+        "POP R3\n"
+        "RET\n\n"
+    );
+
+    return TRANSLATION_ERROR_SUCCESS;
+}
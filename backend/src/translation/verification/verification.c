@@ -16,6 +16,8 @@ const char* translation_strerror(const enum TranslationError error)
         CASE_ENUM_TO_STRING_(TRANSLATION_ERROR_SMASH_MAP);
         CASE_ENUM_TO_STRING_(TRANSLATION_ERROR_INVALID_IMM_SIZE);
         CASE_ENUM_TO_STRING_(TRANSLATION_ERROR_INVALID_OPERAND);
+        CASE_ENUM_TO_STRING_(TRANSLATION_ERROR_INTERNER);
+        CASE_ENUM_TO_STRING_(TRANSLATION_ERROR_UNDEF_LABEL);
         default:
             return "UNKNOWN_TRANSLATION_ERROR";
     }
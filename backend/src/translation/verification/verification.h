@@ -15,6 +15,8 @@ enum TranslationError
     TRANSLATION_ERROR_SMASH_MAP             = 7,
     TRANSLATION_ERROR_INVALID_IMM_SIZE      = 8,
     TRANSLATION_ERROR_INVALID_OPERAND       = 9,
+    TRANSLATION_ERROR_INTERNER              = 10,
+    TRANSLATION_ERROR_UNDEF_LABEL           = 11,
 };
 static_assert(TRANSLATION_ERROR_SUCCESS == 0, "");
 
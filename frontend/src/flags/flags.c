@@ -36,13 +36,22 @@ enum FlagsError flags_objs_ctor(flags_objs_t* const flags_objs)
         return FLAGS_ERROR_SUCCESS;
     }
 
-    if (!strncpy(flags_objs->out_filename, "../assets/front_out.txt", FILENAME_MAX))
+    if (!strncpy(flags_objs->out_filename, "../assets/front_out.ast", FILENAME_MAX))
     {
         perror("Can't strncpy flags_objs->in_filename");
         return FLAGS_ERROR_SUCCESS;
     }
 
+    if (!strncpy(flags_objs->names_filename, "../assets/front_names.txt", FILENAME_MAX))
+    {
+        perror("Can't strncpy flags_objs->names_filename");
+        return FLAGS_ERROR_SUCCESS;
+    }
+
     flags_objs->out = NULL;
+    flags_objs->names_out = NULL;
+    flags_objs->timings = false;
+    flags_objs->text_tree = false;
 
     return FLAGS_ERROR_SUCCESS;
 }
@@ -57,6 +66,12 @@ enum FlagsError flags_objs_dtor (flags_objs_t* const flags_objs)
         return FLAGS_ERROR_FAILURE;
     }
 
+    if (flags_objs->names_out && fclose(flags_objs->names_out))
+    {
+        perror("Can't fclose names out file");
+        return FLAGS_ERROR_FAILURE;
+    }
+
     return FLAGS_ERROR_SUCCESS;
 }
 
@@ -68,7 +83,7 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
     lassert(argc, "");
 
     int getopt_rez = 0;
-    while ((getopt_rez = getopt(argc, argv, "l:i:o:")) != -1)
+    while ((getopt_rez = getopt(argc, argv, "l:i:o:n:tT")) != -1)
     {
         switch (getopt_rez)
         {
@@ -102,6 +117,26 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
 
                 break;
             }
+            case 'n':
+            {
+                if (!strncpy(flags_objs->names_filename, optarg, FILENAME_MAX))
+                {
+                    perror("Can't strncpy flags_objs->names_filename");
+                    return FLAGS_ERROR_FAILURE;
+                }
+
+                break;
+            }
+            case 't':
+            {
+                flags_objs->timings = true;
+                break;
+            }
+            case 'T':
+            {
+                flags_objs->text_tree = true;
+                break;
+            }
 
             default:
             {
@@ -117,5 +152,11 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
         return FLAGS_ERROR_FAILURE;
     }
 
+    if (!(flags_objs->names_out = fopen(flags_objs->names_filename, "wb")))
+    {
+        perror("Can't open names out file");
+        return FLAGS_ERROR_FAILURE;
+    }
+
     return FLAGS_ERROR_SUCCESS;
 }
\ No newline at end of file
@@ -30,8 +30,13 @@ typedef struct FlagsObjs
 
     char in_filename[FILENAME_MAX + 1];
     char out_filename[FILENAME_MAX + 1];
+    char names_filename[FILENAME_MAX + 1];
 
     FILE* out;
+    FILE* names_out;
+
+    bool timings;
+    bool text_tree;     // -T: text tree as before instead of binary AST
 
 } flags_objs_t;
 
@@ -21,13 +21,30 @@
         }                                                                                           \
     } while(0)
 
+#define INTERNER_ERROR_HANDLE_(call_func, ...)                                                      \
+    do {                                                                                            \
+        enum InternerError error_handler = call_func;                                               \
+        if (error_handler)                                                                          \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Error: %s\n",                                     \
+                            interner_strerror(error_handler));                                      \
+            __VA_ARGS__                                                                             \
+            return LEXER_ERROR_INTERNER;                                                            \
+        }                                                                                           \
+    } while(0)
+
 #define START_CAPACITY_ 256
 enum LexerError lexer_ctor(lexer_t* const lexer)
 {
     lassert(!is_invalid_ptr(lexer), "");
 
     lexer->stack = 0;
+    lexer->positions = 0;
     STACK_ERROR_HANDLE_(STACK_CTOR(&lexer->stack, sizeof(lexem_t), START_CAPACITY_));
+    STACK_ERROR_HANDLE_(STACK_CTOR(&lexer->positions, sizeof(lexem_pos_t), START_CAPACITY_),
+                        stack_dtor(&lexer->stack););
+    INTERNER_ERROR_HANDLE_(interner_ctor(&lexer->names),
+                           stack_dtor(&lexer->stack);stack_dtor(&lexer->positions););
 
     return LEXER_ERROR_SUCCESS;
 }
@@ -38,13 +55,16 @@ void lexer_dtor(lexer_t* const lexer)
     lassert(!is_invalid_ptr(lexer), "");
 
     stack_dtor(&lexer->stack);
+    stack_dtor(&lexer->positions);
+    interner_dtor(&lexer->names);
 }
 
-enum LexerError lexer_push(lexer_t* const lexer, const lexem_t lexem)
+enum LexerError lexer_push(lexer_t* const lexer, const lexem_t lexem, const lexem_pos_t pos)
 {
     lassert(!is_invalid_ptr(lexer), "");
 
     STACK_ERROR_HANDLE_(stack_push(&lexer->stack, &lexem));
+    STACK_ERROR_HANDLE_(stack_push(&lexer->positions, &pos));
 
     return LEXER_ERROR_SUCCESS;
 }
@@ -56,12 +76,19 @@ lexem_t* lexer_get(lexer_t lexer, const size_t ind)
     return (lexem_t*)stack_get(lexer.stack, ind);
 }
 
-static enum LexerError handle_num_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind);
-static enum LexerError handle_var_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind);
-static enum LexerError handle_op_ (lexer_t* const lexer,                            size_t* const ind,
-                                   const enum OpType op);
+lexem_pos_t lexer_get_pos(lexer_t lexer, const size_t ind)
+{
+    lassert(ind < stack_size(lexer.positions), "");
+
+    return *(lexem_pos_t*)stack_get(lexer.positions, ind);
+}
 
-static stack_key_t stack = 0;
+static enum LexerError handle_num_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind,
+                                   const lexem_pos_t pos);
+static enum LexerError handle_var_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind,
+                                   const lexem_pos_t pos);
+static enum LexerError handle_op_ (lexer_t* const lexer,                            size_t* const ind,
+                                   const lexem_pos_t pos, const enum OpType op);
 
 enum LexerError lexing(lexer_t* const lexer, const char* const filename)
 {
@@ -78,52 +105,66 @@ enum LexerError lexing(lexer_t* const lexer, const char* const filename)
 
     lassert(text[text_size-1] == L'\0', "");
 
-    STACK_ERROR_HANDLE_(STACK_CTOR(&stack, VAR_NAME_MAX * sizeof(wchar_t), 10));
-
     size_t line = 1;
-    for (size_t ind = 0; text[ind] != L'\0'; ++ind)
+    size_t line_begin = 0;
+    size_t ind = 0;
+    for (; text[ind] != L'\0'; ++ind)
     {
         if (text[ind] == L'\\')
         {
             ++ind;
-            for (; text[ind] != L'\\'; ++ind);
+            for (; text[ind] != L'\\'; ++ind)
+            {
+                if (text[ind] == L'\n')
+                {
+                    ++line;
+                    line_begin = ind + 1;
+                }
+            }
             continue;
         }
 
         if (iswspace((wint_t)text[ind]))
         {
-            line += (text[ind] == L'\n');
+            if (text[ind] == L'\n')
+            {
+                ++line;
+                line_begin = ind + 1;
+            }
             continue;
         }
 
+        const lexem_pos_t pos = {.line = line, .column = ind - line_begin + 1};
+
         if (iswdigit((wint_t)text[ind]))
         {
-            LEXER_ERROR_HANDLE(handle_num_(lexer, text, &ind), free(text);stack_dtor(&stack););
+            LEXER_ERROR_HANDLE(handle_num_(lexer, text, &ind, pos), free(text););
             continue;
         }
 
         enum OpType op = OP_TYPE_UNKNOWN;
         if ((op = find_op(text + ind)) != OP_TYPE_UNKNOWN)
         {
-            LEXER_ERROR_HANDLE(handle_op_(lexer, &ind, op), free(text);stack_dtor(&stack););
+            LEXER_ERROR_HANDLE(handle_op_(lexer, &ind, pos, op), free(text););
             continue;
         }
 
-        LEXER_ERROR_HANDLE(handle_var_(lexer, text, &ind), free(text);stack_dtor(&stack););
+        LEXER_ERROR_HANDLE(handle_var_(lexer, text, &ind, pos), free(text););
     }
 
     LEXER_ERROR_HANDLE(
-        lexer_push(lexer, (lexem_t){.type = LEXEM_TYPE_END, .data = {}}), 
-        free(text);stack_dtor(&stack);
+        lexer_push(lexer, (lexem_t){.type = LEXEM_TYPE_END, .data = {}},
+                   (lexem_pos_t){.line = line, .column = ind - line_begin + 1}),
+        free(text);
     );
 
     free(text); text = NULL;
-    stack_dtor(&stack);
 
     return LEXER_ERROR_SUCCESS;
 }
 
-static enum LexerError handle_num_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind)
+static enum LexerError handle_num_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind,
+                                   const lexem_pos_t pos)
 {
     lassert(!is_invalid_ptr(lexer), "");
     lassert(!is_invalid_ptr(text),  "");
@@ -134,42 +175,41 @@ static enum LexerError handle_num_(lexer_t* const lexer, const wchar_t* const te
     {
         num = num * 10 + (text[*ind] - L'0');
     }
-    LEXER_ERROR_HANDLE(lexer_push(lexer, (lexem_t){.type = LEXEM_TYPE_NUM, .data = {.num = num}}));
+    LEXER_ERROR_HANDLE(lexer_push(lexer, (lexem_t){.type = LEXEM_TYPE_NUM, .data = {.num = num}}, pos));
     --*ind;
 
     return LEXER_ERROR_SUCCESS;
 }
 
-static enum LexerError handle_var_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind)
+static enum LexerError handle_var_(lexer_t* const lexer, const wchar_t* const text, size_t* const ind,
+                                   const lexem_pos_t pos)
 {
     lassert(!is_invalid_ptr(lexer), "");
     lassert(!is_invalid_ptr(text),  "");
     lassert(!is_invalid_ptr(ind),   "");
 
-    wchar_t name[VAR_NAME_MAX] = {};
+    const size_t name_begin = *ind;
+    for (; !iswspace((wint_t)text[*ind]) && text[*ind] != L'\0'; ++*ind);
 
-    for (const size_t old_ind = *ind; 
-         *ind - old_ind < VAR_NAME_MAX && !iswspace((wint_t)text[*ind]) && text[*ind] != L'\0';
-         ++*ind)
-    {
-        name[*ind - old_ind] = text[*ind];
-    }
+    size_t var = 0;
+    INTERNER_ERROR_HANDLE_(interner_intern(&lexer->names, text + name_begin, *ind - name_begin, &var));
 
-    const lexem_t lexem = {.type = LEXEM_TYPE_VAR, .data = {.var = stack_find_push(&stack, name)}};
-    LEXER_ERROR_HANDLE(lexer_push(lexer, lexem));
+    const lexem_t lexem = {.type = LEXEM_TYPE_VAR, .data = {.var = var}};
+    LEXER_ERROR_HANDLE(lexer_push(lexer, lexem, pos));
 
     --*ind;
 
     return LEXER_ERROR_SUCCESS;
 }
 
-static enum LexerError handle_op_(lexer_t* const lexer, size_t* const ind, const enum OpType op)
+static enum LexerError handle_op_(lexer_t* const lexer, size_t* const ind, const lexem_pos_t pos,
+                                  const enum OpType op)
 {
     lassert(!is_invalid_ptr(lexer), "");
     lassert(!is_invalid_ptr(ind),   "");
 
-    LEXER_ERROR_HANDLE(lexer_push(lexer, (lexem_t){.type = LEXEM_TYPE_OP, .data = {.op = op}}));
-    *ind += wcslen(OPERATIONS[op].keyword) - 1;
+    LEXER_ERROR_HANDLE(lexer_push(lexer, (lexem_t){.type = LEXEM_TYPE_OP, .data = {.op = op}}, pos));
+    *ind += OPERATIONS[op].keyword_len - 1;
 
     return LEXER_ERROR_SUCCESS;
 }
\ No newline at end of file
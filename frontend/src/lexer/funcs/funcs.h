@@ -8,8 +8,9 @@
 
 enum LexerError lexer_ctor(lexer_t* const lexer);
 void            lexer_dtor(lexer_t* const lexer);
-enum LexerError lexer_push(lexer_t* const lexer, const lexem_t lexem);
+enum LexerError lexer_push(lexer_t* const lexer, const lexem_t lexem, const lexem_pos_t pos);
 lexem_t*        lexer_get (lexer_t        lexer, const size_t ind);
+lexem_pos_t     lexer_get_pos(lexer_t     lexer, const size_t ind);
 
 enum LexerError lexing(lexer_t* const lexer, const char* const filename);
 
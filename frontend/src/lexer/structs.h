@@ -8,9 +8,18 @@
 #include "stack_on_array/libstack.h"
 #include "utils/utils.h"
 
+// position in source file for diagnostics, both from 1
+typedef struct LexemPos
+{
+    size_t line;
+    size_t column;
+} lexem_pos_t;
+
 typedef struct Lexer
 {
     stack_key_t stack;
+    stack_key_t positions;      // lexem_pos_t of lexem with the same index
+    interner_t  names;
 } lexer_t;
 
 #endif /*MASIK_FRONTEND_SRC_LEXER_STRUCTS_H*/
\ No newline at end of file
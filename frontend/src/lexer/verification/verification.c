@@ -9,6 +9,7 @@ const char* lexer_strerror(const enum LexerError error)
         CASE_ENUM_TO_STRING_(LEXER_ERROR_STANDARD_ERRNO);
         CASE_ENUM_TO_STRING_(LEXER_ERROR_STACK);
         CASE_ENUM_TO_STRING_(LEXER_ERROR_INVALID_LEXEM);
+        CASE_ENUM_TO_STRING_(LEXER_ERROR_INTERNER);
 
         default:
             return "UNKNOWN_LEXER_ERROR";
@@ -9,6 +9,7 @@ enum LexerError
     LEXER_ERROR_STANDARD_ERRNO       = 1,
     LEXER_ERROR_STACK                = 2,
     LEXER_ERROR_INVALID_LEXEM        = 3,
+    LEXER_ERROR_INTERNER             = 4,
 };
 static_assert(LEXER_ERROR_SUCCESS == 0);
 
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <locale.h>
+#include <sys/stat.h>
 
 #include "logger/liblogger.h"
 #include "flags/flags.h"
@@ -9,6 +10,7 @@
 
 int init_all(flags_objs_t* const flags_objs, const int argc, char* const * argv);
 int dtor_all(flags_objs_t* const flags_objs);
+void print_lexing_speed(const char* const filename, const double lexing_time_ms);
 
 int main(const int argc, char* const argv[])
 {
@@ -27,16 +29,26 @@ int main(const int argc, char* const argv[])
                                                                               dtor_all(&flags_objs);
     );
 
+    const double lexing_start_ms = time_ms();
     LEXER_ERROR_HANDLE(lexing(&lexer, flags_objs.in_filename),
                                                            lexer_dtor(&lexer);dtor_all(&flags_objs);
     );
+    if (flags_objs.timings)
+        print_lexing_speed(flags_objs.in_filename, time_ms() - lexing_start_ms);
+
+    INTERNER_ERROR_HANDLE(interner_print(&lexer.names, flags_objs.names_out),
+                                                           lexer_dtor(&lexer);dtor_all(&flags_objs);
+    );
 
     tree_t syntaxer;
     TREE_ERROR_HANDLE(syntaxer_ctor(&syntaxer, lexer),
                                                            lexer_dtor(&lexer);dtor_all(&flags_objs);
     );
 
-    TREE_ERROR_HANDLE(tree_print(syntaxer, flags_objs.out),
+    if (flags_objs.timings)
+        tree_pool_print_stats(&syntaxer.pool, "frontend", stderr);
+
+    TREE_ERROR_HANDLE((flags_objs.text_tree ? tree_print : tree_print_bin)(syntaxer, flags_objs.out),
                                       lexer_dtor(&lexer);dtor_all(&flags_objs);tree_dtor(&syntaxer);
     );
 
@@ -116,4 +128,21 @@ int logger_init(char* const log_folder)
     return EXIT_SUCCESS;
 }
 #undef LOGOUT_FILENAME
-#undef   DUMB_FILENAME
\ No newline at end of file
+#undef   DUMB_FILENAME
+
+void print_lexing_speed(const char* const filename, const double lexing_time_ms)
+{
+    lassert(!is_invalid_ptr(filename), "");
+
+    struct stat file_stat = {};
+    if (stat(filename, &file_stat))
+    {
+        perror("Can't stat in file");
+        return;
+    }
+
+    const double size_mb = (double)file_stat.st_size / (1024. * 1024.);
+
+    fprintf(stderr, "lexing: %.2f MB in %.3f ms, %.2f MB/s\n",
+            size_mb, lexing_time_ms, lexing_time_ms > 0 ? size_mb * 1000. / lexing_time_ms : 0.);
+}
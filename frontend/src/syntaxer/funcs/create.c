@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdarg.h>
 #include <string.h>
 
 #include "logger/liblogger.h"
@@ -8,29 +9,22 @@
 #include "stack_on_array/libstack.h"
 #include "lexer/funcs/funcs.h"
 
-#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
-    do {                                                                                            \
-        enum StackError error_handler = call_func;                                                  \
-        if (error_handler)                                                                          \
-        {                                                                                           \
-            fprintf(stderr, "Can't " #call_func". Error: %s\n",                                     \
-                            stack_strerror(error_handler));                                         \
-            __VA_ARGS__                                                                             \
-            return TREE_ERROR_STACK;                                                              \
-        }                                                                                           \
-    } while(0)
+// Predictive recursive descent on assets/grammar.bnf: every alternative is chosen by the current
+// lexem, nothing is parsed twice, so parsing is linear in lexems count. On the first error
+// desc_state->error_msg is filled and all desc_* return NULL, the partial tree is freed with
+// the whole pool by syntaxer_ctor.
 
+#define ERROR_MSG_MAX_ 1024
 
 typedef struct DescState
 {
     size_t ind;
     const lexer_t lexer;
-    stack_key_t errors;
+    bool is_failure;
+    char error_msg[ERROR_MSG_MAX_];
     size_t local_vars_cnt;
 } desc_state_t;
 
-#define ERROR_MSG_MAX_ 1024
-
 
 tree_elem_t* desc_start_        (desc_state_t* const desc_state);
 
@@ -55,108 +49,61 @@ tree_elem_t* desc_call_func_    (desc_state_t* const desc_state);
 tree_elem_t* desc_ret_          (desc_state_t* const desc_state);
 
 tree_elem_t* desc_sysfunc_void_ (desc_state_t* const desc_state);
-tree_elem_t* desc_out_          (desc_state_t* const desc_state);
-tree_elem_t* desc_in_           (desc_state_t* const desc_state);
 
 tree_elem_t* desc_declaration_  (desc_state_t* const desc_state);
 
 tree_elem_t* desc_if_           (desc_state_t* const desc_state);
 tree_elem_t* desc_while_        (desc_state_t* const desc_state);
 
-tree_elem_t* desc_else_         (desc_state_t* const desc_state);
 tree_elem_t* desc_condition_    (desc_state_t* const desc_state);
 tree_elem_t* desc_body_         (desc_state_t* const desc_state);
 
 
-enum TreeError output_errors_(desc_state_t desc_state);
-
 static size_t size_ = 0;
+static tree_pool_t* pool_ = NULL;
 
 enum TreeError syntaxer_ctor(tree_t* const syntaxer, const lexer_t lexer)
 {
     lassert(!is_invalid_ptr(syntaxer), "");
 
     size_ = 0;
+    tree_pool_ctor(&syntaxer->pool);
+    pool_ = &syntaxer->pool;
 
-    desc_state_t desc_state = {.ind = 0, .lexer = lexer, .errors = 0, .local_vars_cnt = 0};
-    STACK_ERROR_HANDLE_(STACK_CTOR(&desc_state.errors, ERROR_MSG_MAX_, 0));
+    desc_state_t desc_state = {.ind = 0, .lexer = lexer, .is_failure = false, .local_vars_cnt = 0};
 
     syntaxer->Groot = desc_start_(&desc_state);
 
-    if (!stack_is_empty(desc_state.errors))
+    if (desc_state.is_failure)
     {
-        TREE_ERROR_HANDLE(output_errors_(desc_state),              
-                                                                     stack_dtor(&desc_state.errors);
-        );
-                                                                     stack_dtor(&desc_state.errors);
+        fprintf(stderr, RED_TEXT("DESC ERROR: ") "%s\n", desc_state.error_msg);
+        tree_pool_dtor(&syntaxer->pool);
         return TREE_ERROR_SYNTAX_ERROR;
     }
 
     syntaxer->size = size_;
-                                                                     stack_dtor(&desc_state.errors);
 
     TREE_VERIFY_ASSERT(syntaxer);
     return TREE_ERROR_SUCCESS;
 }
 
-enum TreeError output_errors_(desc_state_t desc_state)
-{
-    fprintf(stderr, RED_TEXT("DESC ERRORS: \n"));
-
-    while (!stack_is_empty(desc_state.errors))
-    {
-        char error_msg[ERROR_MSG_MAX_] = {};
-
-        STACK_ERROR_HANDLE_(stack_pop(&desc_state.errors, error_msg));
-
-        fprintf(stderr, "%s\n", error_msg);
-    }
-
-    return TREE_ERROR_SUCCESS;
-}
-
-
-#undef  STACK_ERROR_HANDLE_
-#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
-    do {                                                                                            \
-        enum StackError error_handler = call_func;                                                  \
-        if (error_handler)                                                                          \
-        {                                                                                           \
-            fprintf(stderr, "Can't " #call_func". Error: %s\n",                                     \
-                            stack_strerror(error_handler));                                         \
-            __VA_ARGS__                                                                             \
-            return NULL;                                                                            \
-        }                                                                                           \
-    } while(0)
 
 #define CUR_IND_ (desc_state->ind)
 #define SHIFT_  ++desc_state->ind
 #define CUR_LEX_ (*lexer_get(desc_state->lexer, CUR_IND_))
 
-#define IS_FAILURE_ (!stack_is_empty(desc_state->errors))
-
-#define RESET_ERRORS_                                                                               \
-        stack_dtor(&desc_state->errors);                                                            \
-        STACK_ERROR_HANDLE_(STACK_CTOR(&desc_state->errors, ERROR_MSG_MAX_, 0))
+#define CHECK_ERROR_()                                                                              \
+        do {                                                                                        \
+            if (desc_state->is_failure) return NULL;                                                \
+        } while(0)
 
 #define RET_FAILURE_(...)                                                                           \
     do {                                                                                            \
-        __VA_ARGS__                                                                                 \
-        char error_msg[ERROR_MSG_MAX_] = {};                                                        \
-        snprintf(error_msg, ERROR_MSG_MAX_, "Can't %s ind: %zu line: %d\n",                         \
-                 __func__, CUR_IND_, __LINE__);                                                     \
-        STACK_ERROR_HANDLE_(stack_push(&desc_state->errors, error_msg));                            \
+        syntax_error_(desc_state, __VA_ARGS__);                                                     \
         return NULL;                                                                                \
     } while(0)
 
-#define CHECK_ERROR_(...)                                                                           \
-        do {                                                                                        \
-            lassert(!is_invalid_ptr(desc_state), "");                                               \
-            if (IS_FAILURE_) { RET_FAILURE_(__VA_ARGS__); }                                         \
-        } while(0)
-
-
-#define CREATE_ELEM_(lex, lt, rt) (++size_, tree_elem_ctor(lex, lt, rt))
+#define CREATE_ELEM_(lex, lt, rt) (++size_, tree_elem_ctor(pool_, lex, lt, rt))
 
 #define IS_OP_  (CUR_LEX_.type == LEXEM_TYPE_OP)
 #define IS_NUM_ (CUR_LEX_.type == LEXEM_TYPE_NUM)
@@ -170,82 +117,100 @@ enum TreeError output_errors_(desc_state_t desc_state)
      || IS_OP_TYPE_(POW_ASSIGNMENT)                                                                 \
     )
 
-void tree_elem_dtor_recursive_(tree_elem_t** elem);
+#define KEYWORD_(name_) (OPERATIONS[OP_TYPE_##name_].keyword)
+
+#define EXPECT_OP_(name_)                                                                           \
+    do {                                                                                            \
+        if (!IS_OP_TYPE_(name_))                                                                    \
+        {                                                                                           \
+            RET_FAILURE_("'%ls'", KEYWORD_(name_));                                                 \
+        }                                                                                           \
+        SHIFT_;                                                                                     \
+    } while(0)
+
+// "line:column: expected <expected>, got <current lexem>"
+__attribute__((format(printf, 2, 3)))
+static void syntax_error_(desc_state_t* const desc_state, const char* const expected_format, ...)
+{
+    lassert(!is_invalid_ptr(desc_state), "");
+    lassert(!is_invalid_ptr(expected_format), "");
+
+    desc_state->is_failure = true;
+
+    char expected[ERROR_MSG_MAX_ / 2] = {};
+    va_list args;
+    va_start(args, expected_format);
+    vsnprintf(expected, sizeof(expected), expected_format, args);
+    va_end(args);
+
+    char got[ERROR_MSG_MAX_ / 4] = {};
+    const lexem_t lexem = CUR_LEX_;
+    switch (lexem.type)
+    {
+        case LEXEM_TYPE_OP:
+            snprintf(got, sizeof(got), "'%ls'", OPERATIONS[lexem.data.op].keyword);
+            break;
+        case LEXEM_TYPE_NUM:
+            snprintf(got, sizeof(got), "number %lld", (long long)lexem.data.num);
+            break;
+        case LEXEM_TYPE_VAR:
+            snprintf(got, sizeof(got), "name '%ls'", interner_get(&desc_state->lexer.names, lexem.data.var));
+            break;
+        case LEXEM_TYPE_END:
+            snprintf(got, sizeof(got), "end of file");
+            break;
+        default:
+            snprintf(got, sizeof(got), "unknown lexem");
+            break;
+    }
+
+    const lexem_pos_t pos = lexer_get_pos(desc_state->lexer, CUR_IND_);
+    snprintf(desc_state->error_msg, ERROR_MSG_MAX_, "%zu:%zu: expected %s, got %s",
+             pos.line, pos.column, expected, got);
+}
 
 tree_elem_t* desc_start_  (desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
-    
-    const lexem_t lexem_please = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_PLEASE}};
-
-    size_t old_ind = CUR_IND_;
 
-    tree_elem_t* func_lt = desc_func_(desc_state);
+    const lexem_t lexem_please = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_PLEASE}};
 
-    if (IS_FAILURE_)
-    {
-        tree_elem_dtor_recursive_(&func_lt);
-    }
-    else
+    tree_elem_t* func_lt = NULL;
+    while (IS_OP_TYPE_(FUNC))
     {
-        old_ind = CUR_IND_;
-        RESET_ERRORS_;
-        tree_elem_t* func_lt2 = desc_func_(desc_state);
+        tree_elem_t* func = desc_func_(desc_state);
+        CHECK_ERROR_();
 
-        while (!IS_FAILURE_)
-        {
-            func_lt = CREATE_ELEM_(lexem_please, func_lt, func_lt2);
-
-            old_ind = CUR_IND_;
-            func_lt2 = desc_func_(desc_state);
-        }
-        tree_elem_dtor_recursive_(&func_lt2);
+        func_lt = func_lt ? CREATE_ELEM_(lexem_please, func_lt, func) : func;
     }
-    RESET_ERRORS_;
-    CUR_IND_ = old_ind;
 
     //main
 
+    if (!IS_OP_TYPE_(MAIN))
+    {
+        RET_FAILURE_("'%ls' or '%ls'", KEYWORD_(FUNC), KEYWORD_(MAIN));
+    }
+
     tree_elem_t* main = desc_main_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&func_lt);tree_elem_dtor_recursive_(&main););
+    CHECK_ERROR_();
 
     //func rt
 
-    old_ind = CUR_IND_;
-
-    tree_elem_t* func_rt = desc_func_(desc_state);
-
-    if (IS_FAILURE_)
+    tree_elem_t* func_rt = NULL;
+    while (IS_OP_TYPE_(FUNC))
     {
-        tree_elem_dtor_recursive_(&func_rt);
-    }
-    else
-    {
-        old_ind = CUR_IND_;
-        RESET_ERRORS_;
-        tree_elem_t* func_rt2 = desc_func_(desc_state);
+        tree_elem_t* func = desc_func_(desc_state);
+        CHECK_ERROR_();
 
-        while (!IS_FAILURE_)
-        {
-            func_rt = CREATE_ELEM_(lexem_please, func_rt, func_rt2);
-
-            old_ind = CUR_IND_;
-            func_rt2 = desc_func_(desc_state);
-        }
-        tree_elem_dtor_recursive_(&func_rt2);
+        func_rt = func_rt ? CREATE_ELEM_(lexem_please, func_rt, func) : func;
     }
-    RESET_ERRORS_;
-    CUR_IND_ = old_ind;
 
     //all
     lexem_t lexem_main = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_MAIN}};
 
     if (CUR_LEX_.type != LEXEM_TYPE_END)
     {
-        fprintf(stderr, "desc_start fail\n");
-        RET_FAILURE_(tree_elem_dtor_recursive_(&func_lt);
-                     tree_elem_dtor_recursive_(&func_rt);
-                     tree_elem_dtor_recursive_(&main););
+        RET_FAILURE_("'%ls' or end of file", KEYWORD_(FUNC));
     }
 
     return CREATE_ELEM_(lexem_main, main, CREATE_ELEM_(lexem_please, func_lt, func_rt));
@@ -257,53 +222,43 @@ tree_elem_t* desc_func_(desc_state_t* const desc_state)
 
     if (!IS_OP_TYPE_(FUNC))
     {
-        // fprintf(stderr, "lexem_type: %d, op_type1_func: %s\n", CUR_LEX_.type,
-        //         op_type_to_str(CUR_LEX_.data.op));
-        RET_FAILURE_();
+        RET_FAILURE_("'%ls'", KEYWORD_(FUNC));
     }
     lexem_t lexem_func = CUR_LEX_;
     SHIFT_;
 
     if (!IS_VAR_)
     {
-        RET_FAILURE_();
+        RET_FAILURE_("function name");
     }
     tree_elem_t* name = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
     SHIFT_;
 
-    if (!IS_OP_TYPE_(LBRAKET))
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&name););
-    }
-    SHIFT_;
+    EXPECT_OP_(LBRAKET);
 
     desc_state->local_vars_cnt = 0;
 
-    size_t old_ind = CUR_IND_;
-    tree_elem_t* args = desc_vars_(desc_state);
-    if (IS_FAILURE_)
+    tree_elem_t* args = NULL;
+    if (IS_VAR_)
     {
-        RESET_ERRORS_;
-        CUR_IND_ = old_ind;
-        tree_elem_dtor_recursive_(&args);
+        args = desc_vars_(desc_state);
+        CHECK_ERROR_();
     }
 
     if (!IS_OP_TYPE_(RBRAKET))
     {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&name);tree_elem_dtor_recursive_(&args););
+        RET_FAILURE_("'%ls' or '%ls'", KEYWORD_(ARGS_COMMA), KEYWORD_(RBRAKET));
     }
     SHIFT_;
 
     tree_elem_t* body = desc_body_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&name);tree_elem_dtor_recursive_(&args);
-                 tree_elem_dtor_recursive_(&body););
+    CHECK_ERROR_();
 
     lexem_t lexem_local_vars_cnt = {
         .type = LEXEM_TYPE_NUM, 
         .data = {.num = (num_t)desc_state->local_vars_cnt}
     };
     
-    // lexem_t lexem_please = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_PLEASE}};
     return CREATE_ELEM_(lexem_func, CREATE_ELEM_(lexem_local_vars_cnt, name, args), body);
 }
 
@@ -311,18 +266,12 @@ tree_elem_t* desc_main_(desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
-    if (!IS_OP_TYPE_(MAIN))
-    {
-        RET_FAILURE_();
-    }
-    SHIFT_;
+    EXPECT_OP_(MAIN);
 
     desc_state->local_vars_cnt = 0;
 
     tree_elem_t* elem = desc_body_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-    // fprintf(stderr, RED_TEXT("lexem_local_vars_cnt: %zu\n"), desc_state->local_vars_cnt);
+    CHECK_ERROR_();
 
     lexem_t lexem_local_vars_cnt = {
         .type = LEXEM_TYPE_NUM, 
@@ -337,7 +286,7 @@ tree_elem_t* desc_args_(desc_state_t* const desc_state)
     CHECK_ERROR_();
 
     tree_elem_t* elem = desc_expr_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
+    CHECK_ERROR_();
 
     while(IS_OP_TYPE_(ARGS_COMMA))
     {
@@ -345,7 +294,7 @@ tree_elem_t* desc_args_(desc_state_t* const desc_state)
         SHIFT_;
 
         tree_elem_t* elem2 = desc_expr_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem);tree_elem_dtor_recursive_(&elem2););
+        CHECK_ERROR_();
 
         elem = CREATE_ELEM_(lexem, elem, elem2);
     }
@@ -359,7 +308,7 @@ tree_elem_t* desc_vars_(desc_state_t* const desc_state)
 
     if (!IS_VAR_)
     {
-        RET_FAILURE_();
+        RET_FAILURE_("argument name");
     }
     ++desc_state->local_vars_cnt;
     tree_elem_t* elem = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
@@ -372,7 +321,7 @@ tree_elem_t* desc_vars_(desc_state_t* const desc_state)
 
         if (!IS_VAR_)
         {
-            RET_FAILURE_();
+            RET_FAILURE_("argument name");
         }
         ++desc_state->local_vars_cnt;
         tree_elem_t* elem2 = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
@@ -384,85 +333,38 @@ tree_elem_t* desc_vars_(desc_state_t* const desc_state)
     return elem;
 }
 
+// if and while are complete, other statements are optional and end with one or more "пж-пж"
 tree_elem_t* desc_statement_(desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
-    size_t old_ind = CUR_IND_;
-
-    tree_elem_t* elem = desc_if_(desc_state);
+    if (IS_OP_TYPE_(IF))
+        return desc_if_(desc_state);
 
-    if (!IS_FAILURE_)
-    {
-        return elem;
-    }
-    RESET_ERRORS_;
-    CUR_IND_ = old_ind;
-    tree_elem_dtor_recursive_(&elem);
+    if (IS_OP_TYPE_(WHILE))
+        return desc_while_(desc_state);
 
-    elem = desc_while_(desc_state);
-
-    if (!IS_FAILURE_)
-    {
-        return elem;
-    }
-    RESET_ERRORS_;
-    CUR_IND_ = old_ind;
-    tree_elem_dtor_recursive_(&elem);
+    tree_elem_t* elem = NULL;
 
-    //-------
-
-    old_ind = CUR_IND_;
-
-    elem = desc_declaration_(desc_state);
+    if      (IS_OP_TYPE_(DECL_FLAG))                elem = desc_declaration_(desc_state);
+    else if (IS_VAR_)                               elem = desc_assignment_ (desc_state);
+    else if (IS_OP_TYPE_(RET))                      elem = desc_ret_        (desc_state);
+    else if (IS_OP_TYPE_(OUT) || IS_OP_TYPE_(IN))   elem = desc_sysfunc_void_(desc_state);
+    CHECK_ERROR_();
 
-    if (IS_FAILURE_)
+    if (!IS_OP_TYPE_(PLEASE))
     {
-        RESET_ERRORS_;
-        CUR_IND_ = old_ind;
-        tree_elem_dtor_recursive_(&elem);
+        if (elem)
+            RET_FAILURE_("'%ls'", KEYWORD_(PLEASE));
 
-        elem = desc_assignment_(desc_state);
-
-        if (IS_FAILURE_)
-        {
-            RESET_ERRORS_;
-            CUR_IND_ = old_ind;
-            tree_elem_dtor_recursive_(&elem);
-
-            elem = desc_ret_(desc_state);
-
-            if (IS_FAILURE_)
-            {
-                RESET_ERRORS_;
-                CUR_IND_ = old_ind;
-                tree_elem_dtor_recursive_(&elem);
-
-                elem = desc_sysfunc_void_(desc_state);
-
-                if (IS_FAILURE_)
-                {
-                    RESET_ERRORS_;
-                    CUR_IND_ = old_ind;
-                    tree_elem_dtor_recursive_(&elem);
-                }
-            }
-        }
+        RET_FAILURE_("statement or '%ls'", KEYWORD_(RBODY));
     }
 
-    bool is_please = false;
-
     while (IS_OP_TYPE_(PLEASE))
     {
-        is_please = true;
         SHIFT_;
     }
 
-    if (!is_please)
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&elem););
-    }
-
     return elem;
 }
 
@@ -471,197 +373,101 @@ tree_elem_t* desc_expr_(desc_state_t* const desc_state)
     CHECK_ERROR_();
 
     tree_elem_t* elem = desc_compare_eq_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
+    CHECK_ERROR_();
 
     return elem;
 }
 
-#define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
-        case OP_TYPE_##name_: elem = CREATE_ELEM_(lexem, elem, elem2); break;
-
 tree_elem_t* desc_assignment_(desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
     if (!IS_VAR_)
     {
-        RET_FAILURE_();
+        RET_FAILURE_("variable name");
     }
     tree_elem_t* elem_name = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
     SHIFT_;
 
     if (!IS_ASSIGNMENT)
     {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&elem_name););
+        RET_FAILURE_("assignment");
     }
     lexem_t lexem = CUR_LEX_;
     SHIFT_;
 
     tree_elem_t* elem_expr = desc_expr_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem_expr);tree_elem_dtor_recursive_(&elem_name););
+    CHECK_ERROR_();
 
     return CREATE_ELEM_(lexem, elem_name, elem_expr);
 }
-#undef OPERATION_HANDLE
 
-#define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
-        case OP_TYPE_##name_: elem = CREATE_ELEM_(lexem, elem, elem2); break;
+// <elem> ::= <next_desc_> (<op> <next_desc_>)*, left associative
+#define DESC_BINARY_(next_desc_, is_op_)                                                            \
+    do {                                                                                            \
+        CHECK_ERROR_();                                                                             \
+                                                                                                    \
+        tree_elem_t* elem = next_desc_(desc_state);                                                 \
+        CHECK_ERROR_();                                                                             \
+                                                                                                    \
+        while (is_op_)                                                                              \
+        {                                                                                           \
+            const lexem_t lexem = CUR_LEX_;                                                         \
+            SHIFT_;                                                                                 \
+                                                                                                    \
+            tree_elem_t* elem2 = next_desc_(desc_state);                                            \
+            CHECK_ERROR_();                                                                         \
+                                                                                                    \
+            elem = CREATE_ELEM_(lexem, elem, elem2);                                                \
+        }                                                                                           \
+                                                                                                    \
+        return elem;                                                                                \
+    } while(0)
 
 tree_elem_t* desc_compare_eq_ (desc_state_t* const desc_state)
 {
-    CHECK_ERROR_();
-
-    tree_elem_t* elem = desc_compare_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-    while (IS_OP_TYPE_(EQ) || IS_OP_TYPE_(NEQ))
-    {
-        const lexem_t lexem = CUR_LEX_;
-        SHIFT_;
-
-        tree_elem_t* elem2 = desc_compare_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-        switch(lexem.data.op)
-        {
-#include "utils/src/operations/codegen.h"
-
-            case OP_TYPE_UNKNOWN:
-            default:
-                RET_FAILURE_(tree_elem_dtor_recursive_(&elem); tree_elem_dtor_recursive_(&elem2););
-        }
-    }
-
-    return elem;
+    DESC_BINARY_(desc_compare_, IS_OP_TYPE_(EQ) || IS_OP_TYPE_(NEQ));
 }
-#undef OPERATION_HANDLE
-
-#define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
-        case OP_TYPE_##name_: elem = CREATE_ELEM_(lexem, elem, elem2); break;
 
 tree_elem_t* desc_compare_    (desc_state_t* const desc_state)
 {
-    CHECK_ERROR_();
-
-    tree_elem_t* elem = desc_sum_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-    while (IS_OP_TYPE_(LESS) || IS_OP_TYPE_(LESSEQ) || IS_OP_TYPE_(GREAT) || IS_OP_TYPE_(GREATEQ))
-    {
-        const lexem_t lexem = CUR_LEX_;
-        SHIFT_;
-
-        tree_elem_t* elem2 = desc_sum_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-        switch(lexem.data.op)
-        {
-#include "utils/src/operations/codegen.h"
-
-            case OP_TYPE_UNKNOWN:
-            default:
-                RET_FAILURE_(tree_elem_dtor_recursive_(&elem); tree_elem_dtor_recursive_(&elem2););
-        }
-    }
-
-    return elem;
+    DESC_BINARY_(desc_sum_,
+                 IS_OP_TYPE_(LESS) || IS_OP_TYPE_(LESSEQ) || IS_OP_TYPE_(GREAT) || IS_OP_TYPE_(GREATEQ));
 }
-#undef OPERATION_HANDLE
-
-#define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
-        case OP_TYPE_##name_: elem = CREATE_ELEM_(lexem, elem, elem2); break;
-
-tree_elem_t* desc_sum_(desc_state_t* const desc_state) {
-    CHECK_ERROR_();
-    
-    tree_elem_t* elem = desc_mul_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-    while (IS_OP_TYPE_(SUM) || IS_OP_TYPE_(SUB))
-    {
-        const lexem_t lexem = CUR_LEX_;
-        SHIFT_;
-
-        tree_elem_t* elem2 = desc_mul_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-        switch(lexem.data.op)
-        {
-#include "utils/src/operations/codegen.h"
-
-            case OP_TYPE_UNKNOWN:
-            default:
-                RET_FAILURE_(tree_elem_dtor_recursive_(&elem); tree_elem_dtor_recursive_(&elem2););
-        }
-    }
 
-    return elem;
+tree_elem_t* desc_sum_(desc_state_t* const desc_state)
+{
+    DESC_BINARY_(desc_mul_, IS_OP_TYPE_(SUM) || IS_OP_TYPE_(SUB));
 }
-#undef OPERATION_HANDLE
-
-#define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
-        case OP_TYPE_##name_: elem = CREATE_ELEM_(lexem, elem, elem2); break;
 
 tree_elem_t* desc_mul_    (desc_state_t* const desc_state)
 {
-    CHECK_ERROR_();
-    
-    tree_elem_t* elem = desc_pow_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-    while (IS_OP_TYPE_(MUL) || IS_OP_TYPE_(DIV))
-    {
-        const lexem_t lexem = CUR_LEX_;
-        SHIFT_;
-
-        tree_elem_t* elem2 = desc_pow_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-        switch(lexem.data.op)
-        {
-#include "utils/src/operations/codegen.h"
-
-            case OP_TYPE_UNKNOWN:
-            default:
-                RET_FAILURE_(tree_elem_dtor_recursive_(&elem); tree_elem_dtor_recursive_(&elem2););
-        }
-    }
-
-    return elem;
+    DESC_BINARY_(desc_pow_, IS_OP_TYPE_(MUL) || IS_OP_TYPE_(DIV));
 }
-#undef OPERATION_HANDLE
 
-#define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
-        case OP_TYPE_##name_: elem = CREATE_ELEM_(lexem, elem, elem2); break;
+#undef DESC_BINARY_
 
+// right associative
 tree_elem_t* desc_pow_    (desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
     
     tree_elem_t* elem = desc_brakets_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
+    CHECK_ERROR_();
 
-    while (IS_OP_TYPE_(POW))
+    if (IS_OP_TYPE_(POW))
     {
         const lexem_t lexem = CUR_LEX_;
         SHIFT_;
 
         tree_elem_t* elem2 = desc_pow_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
+        CHECK_ERROR_();
 
-        switch(lexem.data.op)
-        {
-#include "utils/src/operations/codegen.h"
-
-            case OP_TYPE_UNKNOWN:
-            default:
-                RET_FAILURE_(tree_elem_dtor_recursive_(&elem); tree_elem_dtor_recursive_(&elem2););
-        }
+        elem = CREATE_ELEM_(lexem, elem, elem2);
     }
 
     return elem;
 }
-#undef OPERATION_HANDLE
 
 tree_elem_t* desc_brakets_(desc_state_t* const desc_state)
 {
@@ -672,23 +478,20 @@ tree_elem_t* desc_brakets_(desc_state_t* const desc_state)
         SHIFT_;
 
         tree_elem_t* elem = desc_expr_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
+        CHECK_ERROR_();
 
-        if (!IS_OP_TYPE_(RBRAKET))
-        {
-            RET_FAILURE_(tree_elem_dtor_recursive_(&elem););
-        }
-        SHIFT_;
+        EXPECT_OP_(RBRAKET);
 
         return elem;
     }
 
     tree_elem_t* elem = desc_var_num_func_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
+    CHECK_ERROR_();
 
     return elem;
 }
 
+// name with ":-)" after it is call
 tree_elem_t* desc_var_num_func_(desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
@@ -700,22 +503,19 @@ tree_elem_t* desc_var_num_func_(desc_state_t* const desc_state)
         return elem;
     }
 
-    size_t old_ind = CUR_IND_;
-
-    tree_elem_t* elem = desc_call_func_(desc_state);
-    if (!IS_FAILURE_)
-    {
-        return elem;
-    }
-    tree_elem_dtor_recursive_(&elem);
-    CUR_IND_ = old_ind;
-    RESET_ERRORS_;
-
     if (!IS_VAR_)
     {
-        RET_FAILURE_();
+        RET_FAILURE_("number, name or '%ls'", KEYWORD_(LBRAKET));
     }
-    elem = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
+
+    SHIFT_;
+    const bool is_call = IS_OP_TYPE_(LBRAKET);
+    --CUR_IND_;
+
+    if (is_call)
+        return desc_call_func_(desc_state);
+
+    tree_elem_t* elem = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
     SHIFT_;
     
     return elem;
@@ -727,31 +527,21 @@ tree_elem_t* desc_call_func_(desc_state_t* const desc_state)
 
     if (!IS_VAR_)
     {
-        RET_FAILURE_();
+        RET_FAILURE_("function name");
     }
     tree_elem_t* name = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
     SHIFT_;
 
-    if (!IS_OP_TYPE_(LBRAKET))
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&name););
-    }
-    SHIFT_;
-
-    size_t old_ind = CUR_IND_;
-    tree_elem_t* args = desc_args_(desc_state);
-    if (IS_FAILURE_)
-    {
-        CUR_IND_ = old_ind;
-        RESET_ERRORS_;
-        tree_elem_dtor_recursive_(&args);
-    }
+    EXPECT_OP_(LBRAKET);
 
+    tree_elem_t* args = NULL;
     if (!IS_OP_TYPE_(RBRAKET))
     {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&name);tree_elem_dtor_recursive_(&args););
+        args = desc_args_(desc_state);
+        CHECK_ERROR_();
     }
-    SHIFT_;
+
+    EXPECT_OP_(RBRAKET);
 
     lexem_t lexem1 = {.type = LEXEM_TYPE_OP,  .data = {.op = OP_TYPE_FUNC_LBRAKET}};
     return CREATE_ELEM_(lexem1, name, args);
@@ -761,106 +551,37 @@ tree_elem_t* desc_ret_(desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
-
     if (!IS_OP_TYPE_(RET))
     {
-        RET_FAILURE_();
+        RET_FAILURE_("'%ls'", KEYWORD_(RET));
     }
     lexem_t lexem = CUR_LEX_;
     SHIFT_;
 
     tree_elem_t* elem_lt = desc_expr_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem_lt););
-
-    // fprintf(stderr, "op_type1_ret: %s\n", op_type_to_str(CUR_LEX_.data.op));
+    CHECK_ERROR_();
 
     return CREATE_ELEM_(lexem, elem_lt, NULL);
 }
 
+// <out> and <in> differ only in keyword
 tree_elem_t* desc_sysfunc_void_(desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
-    size_t old_ind = CUR_IND_;
-
-    tree_elem_t* elem = desc_out_(desc_state);
-    if (!IS_FAILURE_)
-    {
-        return elem;
-    }
-    tree_elem_dtor_recursive_(&elem);
-    CUR_IND_ = old_ind;
-    RESET_ERRORS_;
-
-    elem = desc_in_(desc_state);
-    if (IS_FAILURE_)
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&elem););
-    }
-
-    return elem;
-}
-
-tree_elem_t* desc_out_(desc_state_t* const desc_state)
-{
-    CHECK_ERROR_();
-
-    if (!IS_OP_TYPE_(OUT))
+    if (!IS_OP_TYPE_(OUT) && !IS_OP_TYPE_(IN))
     {
-        RET_FAILURE_();
+        RET_FAILURE_("'%ls' or '%ls'", KEYWORD_(OUT), KEYWORD_(IN));
     }
     lexem_t lexem = CUR_LEX_;
     SHIFT_;
 
-    if (!IS_OP_TYPE_(LBRAKET))
-    {
-        RET_FAILURE_();
-    }
-    SHIFT_;
+    EXPECT_OP_(LBRAKET);
 
     tree_elem_t* args = desc_args_(desc_state);
-    if (IS_FAILURE_)
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&args););
-    }
-
-    if (!IS_OP_TYPE_(RBRAKET))
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&args););
-    }
-    SHIFT_;
-
-    return CREATE_ELEM_(lexem, args, NULL);
-}
-
-tree_elem_t* desc_in_(desc_state_t* const desc_state)
-{
     CHECK_ERROR_();
 
-    if (!IS_OP_TYPE_(IN))
-    {
-        RET_FAILURE_();
-    }
-    lexem_t lexem = CUR_LEX_;
-    SHIFT_;
-
-    if (!IS_OP_TYPE_(LBRAKET))
-    {
-        RET_FAILURE_();
-    }
-    SHIFT_;
-
-    tree_elem_t* args = desc_args_(desc_state);
-    if (IS_FAILURE_)
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&args););
-    }
-
-    if (!IS_OP_TYPE_(RBRAKET))
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&args););
-    }
-    SHIFT_;
+    EXPECT_OP_(RBRAKET);
 
     return CREATE_ELEM_(lexem, args, NULL);
 }
@@ -869,142 +590,88 @@ tree_elem_t* desc_declaration_(desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
-    if (!IS_OP_TYPE_(DECL_FLAG))
-    {
-        RET_FAILURE_();
-    }
-    SHIFT_;
+    EXPECT_OP_(DECL_FLAG);
 
     if (!IS_VAR_)
     {
-        RET_FAILURE_();
+        RET_FAILURE_("variable name");
     }
     ++desc_state->local_vars_cnt;
-    // fprintf(stderr, RED_TEXT("desc_assignment: %zu\n"), desc_state->local_vars_cnt);
 
     tree_elem_t* elem_lt = CREATE_ELEM_(CUR_LEX_, NULL, NULL);
     SHIFT_;
 
-    const lexem_t lexem_zero = {.type = LEXEM_TYPE_NUM, .data = {.num = 0}};
-    tree_elem_t* elem_rt = CREATE_ELEM_(lexem_zero, NULL, NULL);
+    const lexem_t lexem = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_DECL_ASSIGNMENT}};
 
-    lexem_t lexem = CUR_LEX_;
-    lexem.data.op = OP_TYPE_DECL_ASSIGNMENT;
     if (IS_OP_TYPE_(ASSIGNMENT) || IS_OP_TYPE_(DECL_ASSIGNMENT))
     {
         SHIFT_;
 
-        tree_elem_dtor_recursive_(&elem_rt);
-        elem_rt = desc_expr_(desc_state);
-        CHECK_ERROR_(tree_elem_dtor_recursive_(&elem_lt); tree_elem_dtor_recursive_(&elem_rt););
+        tree_elem_t* elem_rt = desc_expr_(desc_state);
+        CHECK_ERROR_();
+
+        return CREATE_ELEM_(lexem, elem_lt, elem_rt);
     }
 
-    return CREATE_ELEM_(lexem, elem_lt, elem_rt);
+    const lexem_t lexem_zero = {.type = LEXEM_TYPE_NUM, .data = {.num = 0}};
+    return CREATE_ELEM_(lexem, elem_lt, CREATE_ELEM_(lexem_zero, NULL, NULL));
 }
 
+// <if> and <while> differ only in keyword
+#define DESC_COND_BLOCK_(name_)                                                                     \
+    do {                                                                                            \
+        CHECK_ERROR_();                                                                             \
+                                                                                                    \
+        if (!IS_OP_TYPE_(name_))                                                                    \
+        {                                                                                           \
+            RET_FAILURE_("'%ls'", KEYWORD_(name_));                                                 \
+        }                                                                                           \
+        const lexem_t lexem_block = CUR_LEX_;                                                       \
+        SHIFT_;                                                                                     \
+                                                                                                    \
+        tree_elem_t* elem_cond = desc_condition_(desc_state);                                       \
+        CHECK_ERROR_();                                                                             \
+                                                                                                    \
+        tree_elem_t* elem_body = desc_body_(desc_state);                                            \
+        CHECK_ERROR_();                                                                             \
+                                                                                                    \
+        tree_elem_t* elem_else_body = NULL;                                                         \
+        if (IS_OP_TYPE_(ELSE))                                                                      \
+        {                                                                                           \
+            SHIFT_;                                                                                 \
+            elem_else_body = desc_body_(desc_state);                                                \
+            CHECK_ERROR_();                                                                         \
+        }                                                                                           \
+                                                                                                    \
+        const lexem_t lexem_else = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_ELSE}};           \
+                                                                                                    \
+        return CREATE_ELEM_(lexem_block,                                                            \
+                                elem_cond,                                                          \
+                                CREATE_ELEM_(lexem_else, elem_body, elem_else_body));               \
+    } while(0)
+
 tree_elem_t* desc_if_         (desc_state_t* const desc_state)
 {
-    CHECK_ERROR_();
-
-    if (!IS_OP_TYPE_(IF))
-    {
-        RET_FAILURE_();
-    }
-    lexem_t lexem_if = CUR_LEX_;
-    SHIFT_;
-
-    tree_elem_t* elem_cond = desc_condition_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem_cond););
-
-    tree_elem_t* elem_if_body = desc_body_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem_if_body); tree_elem_dtor_recursive_(&elem_cond););
-
-    size_t old_ind = CUR_IND_;
-
-    tree_elem_t* elem_else_body = desc_else_(desc_state);
-    if (IS_FAILURE_)
-    {
-        RESET_ERRORS_;
-        CUR_IND_ = old_ind;
-        tree_elem_dtor_recursive_(&elem_else_body);
-    }
-
-    lexem_t lexem_else = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_ELSE}};
-
-    return CREATE_ELEM_(lexem_if, 
-                            elem_cond, 
-                            CREATE_ELEM_(lexem_else, elem_if_body, elem_else_body));
+    DESC_COND_BLOCK_(IF);
 }
 
 tree_elem_t* desc_while_      (desc_state_t* const desc_state)
 {
-CHECK_ERROR_();
-
-    if (!IS_OP_TYPE_(WHILE))
-    {
-        RET_FAILURE_();
-    }
-    lexem_t lexem_while = CUR_LEX_;
-    SHIFT_;
-
-    tree_elem_t* elem_cond = desc_condition_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem_cond););
-
-    tree_elem_t* elem_while_body = desc_body_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem_while_body); 
-                 tree_elem_dtor_recursive_(&elem_cond););
-
-    size_t old_ind = CUR_IND_;
-
-    tree_elem_t* elem_else_body = desc_else_(desc_state);
-    if (IS_FAILURE_)
-    {
-        RESET_ERRORS_;
-        CUR_IND_ = old_ind;
-        tree_elem_dtor_recursive_(&elem_else_body);
-    }
-
-    lexem_t lexem_else = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_ELSE}};
-
-    return CREATE_ELEM_(lexem_while, 
-                            elem_cond, 
-                            CREATE_ELEM_(lexem_else, elem_while_body, elem_else_body));
+    DESC_COND_BLOCK_(WHILE);
 }
 
-tree_elem_t* desc_else_       (desc_state_t* const desc_state)
-{
-    CHECK_ERROR_();
-
-    if (!IS_OP_TYPE_(ELSE))
-    {
-        RET_FAILURE_();
-    }
-    SHIFT_;
-
-    tree_elem_t* elem = desc_body_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
-
-    return elem;
-}
+#undef DESC_COND_BLOCK_
 
 tree_elem_t* desc_condition_  (desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
-    if (!IS_OP_TYPE_(COND_LBRAKET))
-    {
-        RET_FAILURE_();
-    }
-    SHIFT_;
+    EXPECT_OP_(COND_LBRAKET);
 
     tree_elem_t* elem = desc_expr_(desc_state);
-    CHECK_ERROR_(tree_elem_dtor_recursive_(&elem););
+    CHECK_ERROR_();
 
-    if (!IS_OP_TYPE_(COND_RBRAKET))
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&elem););
-    }
-    SHIFT_;
+    EXPECT_OP_(COND_RBRAKET);
 
     return elem;
 }
@@ -1013,62 +680,27 @@ tree_elem_t* desc_body_       (desc_state_t* const desc_state)
 {
     CHECK_ERROR_();
 
-    if (!IS_OP_TYPE_(LBODY))
-    {
-        RET_FAILURE_();
-    }
-    SHIFT_;
-
-    size_t old_ind = CUR_IND_;
-    tree_elem_t* elem = desc_statement_(desc_state);
+    EXPECT_OP_(LBODY);
 
-    if (IS_FAILURE_)
-    {
-        tree_elem_dtor_recursive_(&elem);
-    }
-    else
-    {
-        const lexem_t lexem = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_PLEASE}};
+    const lexem_t lexem = {.type = LEXEM_TYPE_OP, .data = {.op = OP_TYPE_PLEASE}};
 
-        old_ind = CUR_IND_;
-        tree_elem_t* elem2 = desc_statement_(desc_state);
-        // fprintf(stderr, "op_type: %s\n", op_type_to_str(CUR_LEX_.data.op));
+    tree_elem_t* elem = NULL;
+    bool is_first = true;
 
-        while (!IS_FAILURE_)
+    while (!IS_OP_TYPE_(RBODY))
+    {
+        if (CUR_LEX_.type == LEXEM_TYPE_END)
         {
-            elem = CREATE_ELEM_(lexem, elem, elem2);
-
-            old_ind = CUR_IND_;
-            elem2 = desc_statement_(desc_state);
+            RET_FAILURE_("statement or '%ls'", KEYWORD_(RBODY));
         }
-        tree_elem_dtor_recursive_(&elem2);
-    }
-    RESET_ERRORS_;
-    CUR_IND_ = old_ind;
-
-    // fprintf(stderr, "op_type: %s\n", op_type_to_str(CUR_LEX_.data.op));
 
+        tree_elem_t* elem2 = desc_statement_(desc_state);
+        CHECK_ERROR_();
 
-    if (!IS_OP_TYPE_(RBODY))
-    {
-        RET_FAILURE_(tree_elem_dtor_recursive_(&elem););
+        elem = is_first ? elem2 : CREATE_ELEM_(lexem, elem, elem2);
+        is_first = false;
     }
     SHIFT_;
 
     return elem;
 }
-
-void tree_elem_dtor_recursive_(tree_elem_t** elem)
-{
-    lassert(!is_invalid_ptr(elem), "");
-
-    if (!*elem) return;
-
-    lassert(!is_invalid_ptr(*elem), "");
-
-    tree_elem_dtor_recursive_(&(*elem)->lt);
-    tree_elem_dtor_recursive_(&(*elem)->rt);
-
-    tree_elem_dtor(elem);
-    --size_;
-}
\ No newline at end of file
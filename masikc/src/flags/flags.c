@@ -0,0 +1,184 @@
+#include <string.h>
+#include <stdlib.h>
+#include <getopt.h>
+
+#include "flags.h"
+#include "logger/liblogger.h"
+#include "utils/utils.h"
+
+#define CASE_ENUM_TO_STRING_(error) case error: return #error
+const char* flags_strerror(const enum FlagsError error)
+{
+    switch(error)
+    {
+        CASE_ENUM_TO_STRING_(FLAGS_ERROR_SUCCESS);
+        CASE_ENUM_TO_STRING_(FLAGS_ERROR_FAILURE);
+        default:
+            return "UNKNOWN_FLAGS_ERROR";
+    }
+    return "UNKNOWN_FLAGS_ERROR";
+}
+#undef CASE_ENUM_TO_STRING_
+
+
+enum FlagsError flags_objs_ctor(flags_objs_t* const flags_objs)
+{
+    lassert(!is_invalid_ptr(flags_objs), "");
+
+    *flags_objs = (flags_objs_t){};
+
+    if (!strncpy(flags_objs->log_folder, "./log/", FILENAME_MAX))
+    {
+        perror("Can't strncpy flags_objs->log_folder");
+        return FLAGS_ERROR_FAILURE;
+    }
+
+    if (!strncpy(flags_objs->in_filename, "../assets/input.msk", FILENAME_MAX))
+    {
+        perror("Can't strncpy flags_objs->in_filename");
+        return FLAGS_ERROR_FAILURE;
+    }
+
+    if (!strncpy(flags_objs->elf_filename, "../masik_elf.out", FILENAME_MAX))
+    {
+        perror("Can't strncpy flags_objs->elf_filename");
+        return FLAGS_ERROR_FAILURE;
+    }
+
+    flags_objs->mode         = 0;
+    flags_objs->regalloc     = true;
+    flags_objs->tail_rec     = true;
+    flags_objs->memo         = true;
+    flags_objs->inline_calls = true;
+    flags_objs->timings      = false;
+
+    return FLAGS_ERROR_SUCCESS;
+}
+
+#define FCLOSE_(file_)                                                                              \
+    do {                                                                                            \
+        if (flags_objs->file_ && fclose(flags_objs->file_))                                         \
+        {                                                                                           \
+            perror("Can't fclose flags_objs->" #file_);                                             \
+            return FLAGS_ERROR_FAILURE;                                                             \
+        }                                                                                           \
+        flags_objs->file_ = NULL;                                                                   \
+    } while(0)
+
+enum FlagsError flags_objs_dtor (flags_objs_t* const flags_objs)
+{
+    lassert(!is_invalid_ptr(flags_objs), "");
+
+    FCLOSE_(elf_out);
+    FCLOSE_(tree_out);
+    FCLOSE_(names_out);
+    FCLOSE_(ir_out);
+    FCLOSE_(bin_out);
+    FCLOSE_(splu_out);
+    FCLOSE_(nasm_out);
+
+    return FLAGS_ERROR_SUCCESS;
+}
+#undef FCLOSE_
+
+#define CASE_FILENAME_(opt_, filename_)                                                             \
+    case opt_:                                                                                      \
+    {                                                                                               \
+        if (!strncpy(flags_objs->filename_, optarg, FILENAME_MAX))                                  \
+        {                                                                                           \
+            perror("Can't strncpy flags_objs->" #filename_);                                        \
+            return FLAGS_ERROR_FAILURE;                                                             \
+        }                                                                                           \
+                                                                                                    \
+        break;                                                                                      \
+    }
+
+// dump is opened only if its filename is given
+#define FOPEN_DUMP_(filename_, file_)                                                               \
+    do {                                                                                            \
+        if (flags_objs->filename_[0] && !(flags_objs->file_ = fopen(flags_objs->filename_, "wb")))  \
+        {                                                                                           \
+            perror("Can't open " #file_ " file");                                                   \
+            return FLAGS_ERROR_FAILURE;                                                             \
+        }                                                                                           \
+    } while(0)
+
+enum FlagsError flags_processing(flags_objs_t* const flags_objs,
+                                 const int argc, char* const argv[])
+{
+    lassert(!is_invalid_ptr(flags_objs), "");
+    lassert(!is_invalid_ptr(argv), "");
+    lassert(argc, "");
+
+    int getopt_rez = 0;
+    while ((getopt_rez = getopt(argc, argv, "l:i:e:f:n:p:b:s:a:m:r:T:M:I:t")) != -1)
+    {
+        switch (getopt_rez)
+        {
+            CASE_FILENAME_('l', log_folder);
+            CASE_FILENAME_('i', in_filename);
+            CASE_FILENAME_('e', elf_filename);
+
+            CASE_FILENAME_('f', tree_filename);
+            CASE_FILENAME_('n', names_filename);
+            CASE_FILENAME_('p', ir_filename);
+            CASE_FILENAME_('b', bin_filename);
+            CASE_FILENAME_('s', splu_filename);
+            CASE_FILENAME_('a', nasm_filename);
+
+            case 'm':
+            {
+                flags_objs->mode = atoi(optarg);
+                break;
+            }
+            case 'r':
+            {
+                flags_objs->regalloc = atoi(optarg);
+                break;
+            }
+            case 'T':
+            {
+                flags_objs->tail_rec = atoi(optarg);
+                break;
+            }
+            case 'M':
+            {
+                flags_objs->memo = atoi(optarg);
+                break;
+            }
+            case 'I':
+            {
+                flags_objs->inline_calls = atoi(optarg);
+                break;
+            }
+            case 't':
+            {
+                flags_objs->timings = true;
+                break;
+            }
+
+            default:
+            {
+                fprintf(stderr, "Getopt error - d: %d, c: %c\n", getopt_rez, (char)getopt_rez);
+                return FLAGS_ERROR_FAILURE;
+            }
+        }
+    }
+
+    if (!(flags_objs->elf_out = fopen(flags_objs->elf_filename, "wb")))
+    {
+        perror("Can't open elf_out file");
+        return FLAGS_ERROR_FAILURE;
+    }
+
+    FOPEN_DUMP_(tree_filename,  tree_out);
+    FOPEN_DUMP_(names_filename, names_out);
+    FOPEN_DUMP_(ir_filename,    ir_out);
+    FOPEN_DUMP_(bin_filename,   bin_out);
+    FOPEN_DUMP_(splu_filename,  splu_out);
+    FOPEN_DUMP_(nasm_filename,  nasm_out);
+
+    return FLAGS_ERROR_SUCCESS;
+}
+#undef FOPEN_DUMP_
+#undef CASE_FILENAME_
@@ -0,0 +1,67 @@
+#ifndef MASIK_MASIKC_SRC_FLAGS_FLAGS_H
+#define MASIK_MASIKC_SRC_FLAGS_FLAGS_H
+
+#include <stdbool.h>
+
+#include "utils/utils.h"
+
+enum FlagsError
+{
+    FLAGS_ERROR_SUCCESS     = 0,
+    FLAGS_ERROR_FAILURE     = 1,
+};
+static_assert(FLAGS_ERROR_SUCCESS  == 0);
+
+const char* flags_strerror(const enum FlagsError error);
+
+#define FLAGS_ERROR_HANDLE(call_func, ...)                                                          \
+    do {                                                                                            \
+        enum FlagsError error_handler = call_func;                                                  \
+        if (error_handler)                                                                          \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Error: %s\n",                                     \
+                            flags_strerror(error_handler));                                         \
+            __VA_ARGS__                                                                             \
+            return error_handler;                                                                   \
+        }                                                                                           \
+    } while(0)
+
+// dumps of intermediates: empty filename - no dump, FILE* is NULL
+typedef struct FlagsObjs
+{
+    char log_folder [FILENAME_MAX + 1];
+
+    char in_filename  [FILENAME_MAX + 1];
+    char elf_filename [FILENAME_MAX + 1];
+
+    char tree_filename[FILENAME_MAX + 1];     // frontend binary AST, the same as front_out.ast
+    char names_filename[FILENAME_MAX + 1];
+    char ir_filename  [FILENAME_MAX + 1];     // text PYAM IR
+    char bin_filename [FILENAME_MAX + 1];     // binary PYAM IR
+    char splu_filename[FILENAME_MAX + 1];
+    char nasm_filename[FILENAME_MAX + 1];
+
+    FILE* elf_out;
+
+    FILE* tree_out;
+    FILE* names_out;
+    FILE* ir_out;
+    FILE* bin_out;
+    FILE* splu_out;
+    FILE* nasm_out;
+
+    int  mode;                                // midlend enum Mode
+    bool regalloc;
+    bool tail_rec;                            // tail calls and accumulators in midlend
+    bool memo;                                // cache of pure recursive functions in midlend
+    bool inline_calls;                        // inlining of small functions in midlend
+    bool timings;
+
+} flags_objs_t;
+
+enum FlagsError flags_objs_ctor (flags_objs_t* const flags_objs);
+enum FlagsError flags_objs_dtor (flags_objs_t* const flags_objs);
+enum FlagsError flags_processing(flags_objs_t* const flags_objs,
+                                 const int argc, char* const argv[]);
+
+#endif /*MASIK_MASIKC_SRC_FLAGS_FLAGS_H*/
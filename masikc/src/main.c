@@ -0,0 +1,186 @@
+#include <stdio.h>
+#include <locale.h>
+
+#include "logger/liblogger.h"
+#include "flags/flags.h"
+#include "utils/src/tree/funcs/funcs.h"
+#include "utils/src/interner/interner.h"
+#include "stages/stages.h"
+
+int init_all(flags_objs_t* const flags_objs, const int argc, char* const * argv);
+int dtor_all(flags_objs_t* const flags_objs);
+void print_stage_time(const flags_objs_t* const flags_objs, const char* const stage_name,
+                      const double stage_start_ms);
+
+int main(const int argc, char* const argv[])
+{
+    fprintf(stderr, GREEN_TEXT("Hello masikc\n"));
+
+    flags_objs_t flags_objs = {};
+
+    if (init_all(&flags_objs, argc, argv))
+    {
+        fprintf(stderr, "Can't init all\n");
+        return EXIT_FAILURE;
+    }
+
+    const double start_ms = time_ms();
+    double stage_start_ms = start_ms;
+
+    tree_t tree = {};
+    interner_t names = {};
+    STAGE_ERROR_HANDLE(stage_frontend(flags_objs.in_filename, &tree, &names),
+                                                                              dtor_all(&flags_objs);
+    );
+    print_stage_time(&flags_objs, "frontend", stage_start_ms);
+
+    if (flags_objs.timings)
+        tree_pool_print_stats(&tree.pool, "frontend", stderr);
+
+    if (flags_objs.tree_out)
+    {
+        TREE_ERROR_HANDLE(tree_print_bin(tree, flags_objs.tree_out),
+                                     interner_dtor(&names);tree_dtor(&tree);dtor_all(&flags_objs);
+        );
+    }
+
+    if (flags_objs.names_out)
+    {
+        INTERNER_ERROR_HANDLE(interner_print(&names, flags_objs.names_out),
+                                     interner_dtor(&names);tree_dtor(&tree);dtor_all(&flags_objs);
+        );
+    }
+
+    stage_start_ms = time_ms();
+    STAGE_ERROR_HANDLE(stage_modify(&tree, flags_objs.mode),
+                                     interner_dtor(&names);tree_dtor(&tree);dtor_all(&flags_objs);
+    );
+    print_stage_time(&flags_objs, "modification", stage_start_ms);
+
+    stage_start_ms = time_ms();
+    struct PyamBinWriter* ir = NULL;
+    STAGE_ERROR_HANDLE(stage_translate(&tree, &names, flags_objs.tail_rec, flags_objs.memo,
+                                       flags_objs.inline_calls, flags_objs.timings,
+                                       flags_objs.ir_out, &ir),
+                                     interner_dtor(&names);tree_dtor(&tree);dtor_all(&flags_objs);
+    );
+    print_stage_time(&flags_objs, "translation", stage_start_ms);
+
+    interner_dtor(&names);
+    tree_dtor(&tree);
+
+    if (flags_objs.bin_out)
+    {
+        STAGE_ERROR_HANDLE(stage_ir_write(ir, flags_objs.bin_out),
+                                                               stage_ir_dtor(ir);dtor_all(&flags_objs);
+        );
+    }
+
+    stage_start_ms = time_ms();
+    fist_t fist = {};
+    interner_t labels = {};
+    STAGE_ERROR_HANDLE(stage_ir_fist(&fist, &labels, stage_ir_view(ir)),
+                                                               stage_ir_dtor(ir);dtor_all(&flags_objs);
+    );
+    print_stage_time(&flags_objs, "ir blocks", stage_start_ms);
+
+    stage_ir_dtor(ir); ir = NULL;
+
+    stage_start_ms = time_ms();
+    STAGE_ERROR_HANDLE(stage_backend(&fist, &labels, flags_objs.splu_out, flags_objs.nasm_out,
+                                     flags_objs.elf_out, flags_objs.regalloc, flags_objs.timings),
+                                   interner_dtor(&labels);fist_dtor(&fist);dtor_all(&flags_objs);
+    );
+    print_stage_time(&flags_objs, "backend", stage_start_ms);
+
+    interner_dtor(&labels);
+    fist_dtor(&fist);
+
+    print_stage_time(&flags_objs, "total", start_ms);
+
+    if (dtor_all(&flags_objs))
+    {
+        fprintf(stderr, "Can't dtor all\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void print_stage_time(const flags_objs_t* const flags_objs, const char* const stage_name,
+                      const double stage_start_ms)
+{
+    lassert(!is_invalid_ptr(flags_objs), "");
+    lassert(!is_invalid_ptr(stage_name), "");
+
+    if (!flags_objs->timings)
+        return;
+
+    fprintf(stderr, "masikc %-12s: %10.3f ms\n", stage_name, time_ms() - stage_start_ms);
+}
+
+int logger_init(char* const log_folder);
+
+int init_all(flags_objs_t* const flags_objs, const int argc, char* const * argv)
+{
+    lassert(argc, "");
+    lassert(argv, "");
+
+    if (!setlocale(LC_ALL, "ru_RU.utf8"))
+    {
+        fprintf(stderr, "Can't setlocale\n");
+        return EXIT_FAILURE;
+    }
+
+    FLAGS_ERROR_HANDLE(flags_objs_ctor (flags_objs));
+    FLAGS_ERROR_HANDLE(flags_processing(flags_objs, argc, argv));
+
+    if (logger_init(flags_objs->log_folder))
+    {
+        fprintf(stderr, "Can't logger init\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int dtor_all(flags_objs_t* const flags_objs)
+{
+    LOGG_ERROR_HANDLE(                                                               logger_dtor());
+    TREE_DUMB_ERROR_HANDLE(                                                       tree_dumb_dtor());
+    FLAGS_ERROR_HANDLE(                                                flags_objs_dtor(flags_objs));
+
+    return EXIT_SUCCESS;
+}
+
+#define LOGOUT_FILENAME "logout.log"
+#define   DUMB_FILENAME "dumb"
+int logger_init(char* const log_folder)
+{
+    lassert(log_folder, "");
+
+    char logout_filename[FILENAME_MAX] = {};
+    if (snprintf(logout_filename, FILENAME_MAX, "%s%s", log_folder, LOGOUT_FILENAME) <= 0)
+    {
+        perror("Can't snprintf logout_filename");
+        return EXIT_FAILURE;
+    }
+
+    char dumb_filename[FILENAME_MAX] = {};
+    if (snprintf(dumb_filename, FILENAME_MAX, "%s%s", log_folder, DUMB_FILENAME) <= 0)
+    {
+        perror("Can't snprintf dumb_filename");
+        return EXIT_FAILURE;
+    }
+
+    LOGG_ERROR_HANDLE(logger_ctor());
+    LOGG_ERROR_HANDLE(logger_set_level_details(LOG_LEVEL_DETAILS_ALL));
+    LOGG_ERROR_HANDLE(logger_set_logout_file(logout_filename));
+
+    TREE_DUMB_ERROR_HANDLE(tree_dumb_ctor());
+    TREE_DUMB_ERROR_HANDLE(tree_dumb_set_out_file(dumb_filename));
+
+    return EXIT_SUCCESS;
+}
+#undef LOGOUT_FILENAME
+#undef   DUMB_FILENAME
@@ -0,0 +1,56 @@
+#include "utils/utils.h"
+#include "logger/liblogger.h"
+#include "ir_fist/funcs/funcs.h"
+#include "ir_fist/structs.h"
+#include "ir_fist/verification/verification.h"
+#include "translation/funcs/funcs.h"
+#include "translation/verification/verification.h"
+#include "stages.h"
+
+#define FIST_BEGIN_CAPACITY_ 10
+enum StageError stage_ir_fist(fist_t* const fist, interner_t* const labels,
+                              const pyam_bin_view_t view)
+{
+    lassert(!is_invalid_ptr(fist), "");
+    lassert(!is_invalid_ptr(labels), "");
+
+    COMPONENT_ERROR_HANDLE_(FIST_CTOR(fist, sizeof(ir_block_t), FIST_BEGIN_CAPACITY_),
+                            fist_strerror, STAGE_ERROR_BACKEND);
+
+    COMPONENT_ERROR_HANDLE_(interner_ctor(labels), interner_strerror, STAGE_ERROR_BACKEND,
+                                                                                  fist_dtor(fist);
+    );
+
+    COMPONENT_ERROR_HANDLE_(ir_fist_from_view(fist, labels, view), ir_fist_strerror,
+                            STAGE_ERROR_BACKEND,
+                                                            fist_dtor(fist);interner_dtor(labels);
+    );
+
+    return STAGE_ERROR_SUCCESS;
+}
+#undef FIST_BEGIN_CAPACITY_
+
+enum StageError stage_backend(const fist_t* const fist, interner_t* const labels,
+                              FILE* splu_out, FILE* nasm_out, FILE* elf_out, const bool regalloc,
+                              const bool report)
+{
+    lassert(!is_invalid_ptr(fist), "");
+    lassert(!is_invalid_ptr(labels), "");
+    lassert(!is_invalid_ptr(elf_out), "");
+
+    if (splu_out)
+    {
+        COMPONENT_ERROR_HANDLE_(translate_splu(fist, labels, splu_out), translation_strerror, STAGE_ERROR_BACKEND);
+    }
+
+    if (nasm_out)
+    {
+        COMPONENT_ERROR_HANDLE_(translate_nasm(fist, labels, nasm_out), translation_strerror, STAGE_ERROR_BACKEND);
+    }
+
+    const elf_opts_t elf_opts = {.regalloc = regalloc, .report = report};
+    COMPONENT_ERROR_HANDLE_(translate_elf(fist, labels, elf_out, elf_opts), translation_strerror,
+                            STAGE_ERROR_BACKEND);
+
+    return STAGE_ERROR_SUCCESS;
+}
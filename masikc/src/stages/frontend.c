@@ -0,0 +1,49 @@
+#include "utils/utils.h"
+#include "logger/liblogger.h"
+#include "lexer/funcs/funcs.h"
+#include "lexer/verification/verification.h"
+#include "syntaxer/funcs/funcs.h"
+#include "stages.h"
+
+#define CASE_ENUM_TO_STRING_(error) case error: return #error
+const char* stage_strerror(const enum StageError error)
+{
+    switch(error)
+    {
+        CASE_ENUM_TO_STRING_(STAGE_ERROR_SUCCESS);
+        CASE_ENUM_TO_STRING_(STAGE_ERROR_STANDARD_ERRNO);
+        CASE_ENUM_TO_STRING_(STAGE_ERROR_FRONTEND);
+        CASE_ENUM_TO_STRING_(STAGE_ERROR_MIDLEND);
+        CASE_ENUM_TO_STRING_(STAGE_ERROR_BACKEND);
+        default:
+            return "UNKNOWN_STAGE_ERROR";
+    }
+    return "UNKNOWN_STAGE_ERROR";
+}
+#undef CASE_ENUM_TO_STRING_
+
+enum StageError stage_frontend(const char* const in_filename, tree_t* const tree,
+                               interner_t* const names)
+{
+    lassert(!is_invalid_ptr(in_filename), "");
+    lassert(!is_invalid_ptr(tree), "");
+    lassert(!is_invalid_ptr(names), "");
+
+    lexer_t lexer;
+    COMPONENT_ERROR_HANDLE_(lexer_ctor(&lexer), lexer_strerror, STAGE_ERROR_FRONTEND);
+
+    COMPONENT_ERROR_HANDLE_(lexing(&lexer, in_filename), lexer_strerror, STAGE_ERROR_FRONTEND,
+                                                                                 lexer_dtor(&lexer);
+    );
+
+    COMPONENT_ERROR_HANDLE_(syntaxer_ctor(tree, lexer), tree_strerror, STAGE_ERROR_FRONTEND,
+                                                                                 lexer_dtor(&lexer);
+    );
+
+    *names = lexer.names;
+    lexer.names = (interner_t){};
+
+    lexer_dtor(&lexer);
+
+    return STAGE_ERROR_SUCCESS;
+}
@@ -0,0 +1,74 @@
+#include <stdlib.h>
+
+#include "utils/utils.h"
+#include "logger/liblogger.h"
+#include "modification/modification.h"
+#include "translation/funcs/funcs.h"
+#include "translation/funcs/pyam_bin.h"
+#include "translation/verification/verification.h"
+#include "stages.h"
+
+enum StageError stage_modify(tree_t* const tree, const int mode)
+{
+    lassert(!is_invalid_ptr(tree), "");
+
+    COMPONENT_ERROR_HANDLE_(tree_modify(tree, (enum Mode)mode), tree_strerror, STAGE_ERROR_MIDLEND);
+
+    return STAGE_ERROR_SUCCESS;
+}
+
+enum StageError stage_translate(const tree_t* const tree, const interner_t* const names,
+                                const bool tail_rec, const bool memo, const bool inline_calls,
+                                const bool report, FILE* ir_out,
+                                struct PyamBinWriter** const ir)
+{
+    lassert(!is_invalid_ptr(tree), "");
+    lassert(!is_invalid_ptr(names), "");
+    lassert(!is_invalid_ptr(ir), "");
+
+    *ir = calloc(1, sizeof(**ir));
+    if (!*ir)
+    {
+        perror("Can't calloc ir");
+        return STAGE_ERROR_STANDARD_ERRNO;
+    }
+
+    COMPONENT_ERROR_HANDLE_(pyam_bin_writer_ctor(*ir), ir_translation_strerror, STAGE_ERROR_MIDLEND,
+                                                                            free(*ir); *ir = NULL;
+    );
+
+    const ir_translation_opts_t opts = {.tail_rec = tail_rec, .memo = memo,
+                                        .inline_calls = inline_calls, .report = report};
+    COMPONENT_ERROR_HANDLE_(translate_ir(tree, names, opts, ir_out, *ir),
+                            ir_translation_strerror, STAGE_ERROR_MIDLEND,
+                                                                 stage_ir_dtor(*ir); *ir = NULL;
+    );
+
+    return STAGE_ERROR_SUCCESS;
+}
+
+void stage_ir_dtor(struct PyamBinWriter* const ir)
+{
+    if (!ir)
+        return;
+
+    pyam_bin_writer_dtor(ir);
+    free(ir);
+}
+
+enum StageError stage_ir_write(const struct PyamBinWriter* const ir, FILE* bin_out)
+{
+    lassert(!is_invalid_ptr(ir), "");
+    lassert(!is_invalid_ptr(bin_out), "");
+
+    COMPONENT_ERROR_HANDLE_(pyam_bin_write(ir, bin_out), ir_translation_strerror, STAGE_ERROR_MIDLEND);
+
+    return STAGE_ERROR_SUCCESS;
+}
+
+pyam_bin_view_t stage_ir_view(const struct PyamBinWriter* const ir)
+{
+    lassert(!is_invalid_ptr(ir), "");
+
+    return pyam_bin_view(ir);
+}
@@ -0,0 +1,84 @@
+#ifndef MASIK_MASIKC_SRC_STAGES_STAGES_H
+#define MASIK_MASIKC_SRC_STAGES_STAGES_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <assert.h>
+
+#include "utils/src/tree/structs.h"
+#include "utils/src/interner/interner.h"
+#include "utils/src/pyam_bin/structs.h"
+#include "hash_table/libs/list_on_array/libfist.h"
+
+// Stages of masikc. Every stage is in its own translation unit compiled with include path of its
+// component (frontend, midlend and backend have the same header names), so only utils and libs
+// types are in this header. Data between stages is passed in memory, files are only dumps.
+
+enum StageError
+{
+    STAGE_ERROR_SUCCESS         = 0,
+    STAGE_ERROR_STANDARD_ERRNO  = 1,
+    STAGE_ERROR_FRONTEND        = 2,
+    STAGE_ERROR_MIDLEND         = 3,
+    STAGE_ERROR_BACKEND         = 4,
+};
+static_assert(STAGE_ERROR_SUCCESS == 0);
+
+const char* stage_strerror(const enum StageError error);
+
+#define STAGE_ERROR_HANDLE(call_func, ...)                                                          \
+    do {                                                                                            \
+        enum StageError error_handler = call_func;                                                  \
+        if (error_handler)                                                                          \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Error: %s\n",                                     \
+                            stage_strerror(error_handler));                                         \
+            __VA_ARGS__                                                                             \
+            return error_handler;                                                                   \
+        }                                                                                           \
+    } while(0)
+
+// component error -> stage error, strerror_func_ is strerror of component error
+#define COMPONENT_ERROR_HANDLE_(call_func, strerror_func_, stage_error_, ...)                       \
+    do {                                                                                            \
+        const __typeof__(call_func) component_error_handler = call_func;                            \
+        if (component_error_handler)                                                                \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Error: %s\n",                                     \
+                            strerror_func_(component_error_handler));                               \
+            __VA_ARGS__                                                                             \
+            return stage_error_;                                                                    \
+        }                                                                                           \
+    } while(0)
+
+// midlend binary IR writer, lies in memory between midlend and backend
+struct PyamBinWriter;
+
+// lexing and syntax analysis, names are moved from lexer
+enum StageError stage_frontend (const char* const in_filename, tree_t* const tree,
+                                interner_t* const names);
+
+// mode is midlend enum Mode
+enum StageError stage_modify   (tree_t* const tree, const int mode);
+
+// ir_out == NULL - without text IR dump, tail_rec - tail calls and accumulators,
+// memo - cache of results of pure recursive functions, inline_calls - bodies of small functions
+// at call sites, report - inlined calls and IR size to stderr
+enum StageError stage_translate(const tree_t* const tree, const interner_t* const names,
+                                const bool tail_rec, const bool memo, const bool inline_calls,
+                                const bool report, FILE* ir_out,
+                                struct PyamBinWriter** const ir);
+void            stage_ir_dtor  (struct PyamBinWriter* const ir);
+enum StageError stage_ir_write (const struct PyamBinWriter* const ir, FILE* bin_out);
+pyam_bin_view_t stage_ir_view  (const struct PyamBinWriter* const ir);
+
+// constructs fist of backend ir blocks and labels with names of their label_num
+enum StageError stage_ir_fist  (fist_t* const fist, interner_t* const labels,
+                                const pyam_bin_view_t view);
+
+// splu_out and nasm_out may be NULL
+enum StageError stage_backend  (const fist_t* const fist, interner_t* const labels,
+                                FILE* splu_out, FILE* nasm_out, FILE* elf_out, const bool regalloc,
+                                const bool report);
+
+#endif /* MASIK_MASIKC_SRC_STAGES_STAGES_H */
@@ -30,7 +30,7 @@ enum FlagsError flags_objs_ctor(flags_objs_t* const flags_objs)
         return FLAGS_ERROR_SUCCESS;
     }
 
-    if (!strncpy(flags_objs->in_filename, "../assets/front_out.txt", FILENAME_MAX))
+    if (!strncpy(flags_objs->in_filename, "../assets/front_out.ast", FILENAME_MAX))
     {
         perror("Can't strncpy flags_objs->in_filename");
         return FLAGS_ERROR_SUCCESS;
@@ -42,9 +42,22 @@ enum FlagsError flags_objs_ctor(flags_objs_t* const flags_objs)
         return FLAGS_ERROR_SUCCESS;
     }
 
+    flags_objs->bin_filename[0] = '\0';
+
+    if (!strncpy(flags_objs->names_filename, "../assets/front_names.txt", FILENAME_MAX))
+    {
+        perror("Can't strncpy flags_objs->names_filename");
+        return FLAGS_ERROR_SUCCESS;
+    }
+
     flags_objs->out = NULL;
+    flags_objs->bin_out = NULL;
 
     flags_objs->mode = MODE_NOTHING;
+    flags_objs->tail_rec = true;
+    flags_objs->memo = true;
+    flags_objs->inline_calls = true;
+    flags_objs->timings = false;
 
     return FLAGS_ERROR_SUCCESS;
 }
@@ -59,6 +72,12 @@ enum FlagsError flags_objs_dtor (flags_objs_t* const flags_objs)
         return FLAGS_ERROR_FAILURE;
     }
 
+    if (flags_objs->bin_out && fclose(flags_objs->bin_out))
+    {
+        perror("Can't fclose bin_out file");
+        return FLAGS_ERROR_FAILURE;
+    }
+
     return FLAGS_ERROR_SUCCESS;
 }
 
@@ -70,7 +89,7 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
     lassert(argc, "");
 
     int getopt_rez = 0;
-    while ((getopt_rez = getopt(argc, argv, "l:i:o:m:")) != -1)
+    while ((getopt_rez = getopt(argc, argv, "l:i:o:b:n:m:T:M:I:t")) != -1)
     {
         switch (getopt_rez)
         {
@@ -104,12 +123,52 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
 
                 break;
             }
+            case 'b':
+            {
+                if (!strncpy(flags_objs->bin_filename, optarg, FILENAME_MAX))
+                {
+                    perror("Can't strncpy flags_objs->bin_filename");
+                    return FLAGS_ERROR_FAILURE;
+                }
+
+                break;
+            }
+            case 'n':
+            {
+                if (!strncpy(flags_objs->names_filename, optarg, FILENAME_MAX))
+                {
+                    perror("Can't strncpy flags_objs->names_filename");
+                    return FLAGS_ERROR_FAILURE;
+                }
+
+                break;
+            }
 
             case 'm':
             {
                 flags_objs->mode = (enum Mode)atoi(optarg);
                 break;
             }
+            case 'T':
+            {
+                flags_objs->tail_rec = atoi(optarg);
+                break;
+            }
+            case 'M':
+            {
+                flags_objs->memo = atoi(optarg);
+                break;
+            }
+            case 'I':
+            {
+                flags_objs->inline_calls = atoi(optarg);
+                break;
+            }
+            case 't':
+            {
+                flags_objs->timings = true;
+                break;
+            }
 
             default:
             {
@@ -125,6 +184,12 @@ enum FlagsError flags_processing(flags_objs_t* const flags_objs,
         return FLAGS_ERROR_FAILURE;
     }
 
+    if (flags_objs->bin_filename[0] && !(flags_objs->bin_out = fopen(flags_objs->bin_filename, "wb")))
+    {
+        perror("Can't open bin_out file");
+        return FLAGS_ERROR_FAILURE;
+    }
+
     
     return FLAGS_ERROR_SUCCESS;
 }
\ No newline at end of file
@@ -38,11 +38,19 @@ typedef struct FlagsObjs
 
     char in_filename[FILENAME_MAX + 1];
     char out_filename[FILENAME_MAX + 1];
+    char bin_filename[FILENAME_MAX + 1];
+    char names_filename[FILENAME_MAX + 1];     // empty - without names in diagnostics
 
     FILE* out;
+    FILE* bin_out;
 
     enum Mode mode;
 
+    bool tail_rec;
+    bool memo;
+    bool inline_calls;
+    bool timings;
+
 } flags_objs_t;
 
 enum FlagsError flags_objs_ctor (flags_objs_t* const flags_objs);
@@ -4,6 +4,7 @@
 #include "logger/liblogger.h"
 #include "flags/flags.h"
 #include "utils/src/tree/funcs/funcs.h"
+#include "utils/src/interner/interner.h"
 #include "modification/modification.h"
 #include "translation/structs.h"
 #include "translation/funcs/funcs.h"
@@ -25,18 +26,42 @@ int main(const int argc, char* const argv[])
     }
 
     tree_t tree = {};
+    const double load_start_ms = time_ms();
     TREE_ERROR_HANDLE(tree_ctor(&tree, flags_objs.in_filename), 
                                                                               dtor_all(&flags_objs);
     );
+    if (flags_objs.timings)
+        fprintf(stderr, "midlend tree load: %.3f ms\n", time_ms() - load_start_ms);
 
     TREE_ERROR_HANDLE(tree_modify(&tree, flags_objs.mode),
                                                              tree_dtor(&tree);dtor_all(&flags_objs);
     );
 
-    IR_TRANSLATION_ERROR_HANDLE(translate(&tree, flags_objs.out),
+    if (flags_objs.timings)
+        tree_pool_print_stats(&tree.pool, "midlend", stderr);
+
+    interner_t names = {};
+    INTERNER_ERROR_HANDLE(interner_ctor(&names),
                                                              tree_dtor(&tree);dtor_all(&flags_objs);
     );
 
+    if (flags_objs.names_filename[0])
+    {
+        INTERNER_ERROR_HANDLE(interner_read(&names, flags_objs.names_filename),
+                                     interner_dtor(&names);tree_dtor(&tree);dtor_all(&flags_objs);
+        );
+    }
+
+    IR_TRANSLATION_ERROR_HANDLE(
+        translate(&tree, flags_objs.names_filename[0] ? &names : NULL,
+                  (ir_translation_opts_t){.tail_rec = flags_objs.tail_rec, .memo = flags_objs.memo,
+                                          .inline_calls = flags_objs.inline_calls,
+                                          .report = flags_objs.timings},
+                  flags_objs.out, flags_objs.bin_out),
+                                     interner_dtor(&names);tree_dtor(&tree);dtor_all(&flags_objs);
+    );
+
+    interner_dtor(&names);
     tree_dtor(&tree);
 
     if (dtor_all(&flags_objs))
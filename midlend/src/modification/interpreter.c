@@ -0,0 +1,537 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include "utils/utils.h"
+#include "utils/src/tree/funcs/funcs.h"
+#include "utils/src/operations/op_math.h"
+#include "modification/interpreter.h"
+
+#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
+    do {                                                                                            \
+        const enum StackError stack_error_handler = call_func;                                      \
+        if (stack_error_handler)                                                                    \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Stack error: %s\n",                               \
+                            stack_strerror(stack_error_handler));                                   \
+            __VA_ARGS__                                                                             \
+            return TREE_ERROR_STACK;                                                                \
+        }                                                                                           \
+    } while(0)
+
+typedef struct InterpreterVar
+{
+    size_t name;
+    num_t val;
+    bool is_init;
+} interpreter_var_t;
+
+#define NO_NAME_ SIZE_MAX   // arg, that isn't param yet
+#define NO_VAR_  SIZE_MAX
+
+#define VARS_BEGIN_CAPACITY_  64
+#define ITEMS_BEGIN_CAPACITY_ 64
+enum TreeError interpreter_ctor(interpreter_t* const interpreter, const tree_elem_t* const root)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+
+    if (purity_ctor(&interpreter->purity))
+        return TREE_ERROR_STACK;
+
+    if (purity_analyze(&interpreter->purity, root))
+    {
+        purity_dtor(&interpreter->purity);
+        return TREE_ERROR_STACK;
+    }
+
+    STACK_ERROR_HANDLE_(STACK_CTOR(&interpreter->vars, sizeof(interpreter_var_t), VARS_BEGIN_CAPACITY_),
+                        purity_dtor(&interpreter->purity);
+    );
+    STACK_ERROR_HANDLE_(STACK_CTOR(&interpreter->items, sizeof(const tree_elem_t*), ITEMS_BEGIN_CAPACITY_),
+                        purity_dtor(&interpreter->purity); stack_dtor(&interpreter->vars);
+    );
+
+    interpreter->frame_begin = 0;
+    interpreter->depth       = 0;
+    interpreter->steps       = INTERPRETER_STEPS_MAX;
+    interpreter->call_steps  = 0;
+    interpreter->state       = INTERPRETER_STATE_RUN;
+    interpreter->ret_val     = 0;
+
+    return TREE_ERROR_SUCCESS;
+}
+#undef VARS_BEGIN_CAPACITY_
+#undef ITEMS_BEGIN_CAPACITY_
+
+void interpreter_dtor(interpreter_t* const interpreter)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+
+    purity_dtor(&interpreter->purity);
+    stack_dtor(&interpreter->vars);
+    stack_dtor(&interpreter->items);
+
+    IF_DEBUG(interpreter->steps = 0;)
+}
+
+static bool is_op_(const tree_elem_t* const elem, const enum OpType op)
+{
+    return elem && elem->lexem.type == LEXEM_TYPE_OP && elem->lexem.data.op == op;
+}
+
+static enum TreeError truncate_(stack_key_t* const stack, const size_t size)
+{
+    lassert(!is_invalid_ptr(stack), "");
+
+    while (stack_size(*stack) > size)
+    {
+        STACK_ERROR_HANDLE_(stack_pop(stack, NULL));
+    }
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static void stop_(interpreter_t* const interpreter)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+
+    interpreter->state = INTERPRETER_STATE_STOP;
+}
+
+// false - budget is exceeded
+static bool step_(interpreter_t* const interpreter)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+
+    if (!interpreter->steps || !interpreter->call_steps)
+    {
+        stop_(interpreter);
+        return false;
+    }
+
+    --interpreter->steps;
+    --interpreter->call_steps;
+
+    return true;
+}
+
+static size_t find_var_(const interpreter_t* const interpreter, const size_t name)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+
+    for (size_t var_ind = stack_size(interpreter->vars); var_ind > interpreter->frame_begin; --var_ind)
+    {
+        const interpreter_var_t* const var = stack_get(interpreter->vars, var_ind - 1);
+        if (var->name == name)
+            return var_ind - 1;
+    }
+
+    return NO_VAR_;
+}
+
+// *res isn't changed, if interpreter is stopped
+static void binary_(interpreter_t* const interpreter, const enum OpType op,
+                    const num_t lt, const num_t rt, num_t* const res)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(res), "");
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+
+    switch (op)
+    {
+        case OP_TYPE_SUM:       *res = (num_t)((uint64_t)lt + (uint64_t)rt);    break;
+        case OP_TYPE_SUB:       *res = (num_t)((uint64_t)lt - (uint64_t)rt);    break;
+        case OP_TYPE_MUL:       *res = (num_t)((uint64_t)lt * (uint64_t)rt);    break;
+        case OP_TYPE_POW:       *res = math_POW(lt, rt);                        break;
+
+        case OP_TYPE_DIV:
+        {
+            // idiv traps in runtime
+            if (rt == 0 || (lt == INT64_MIN && rt == -1))
+            {
+                stop_(interpreter);
+                break;
+            }
+            *res = lt / rt;
+            break;
+        }
+
+        case OP_TYPE_EQ:        *res = (lt == rt);                              break;
+        case OP_TYPE_NEQ:       *res = (lt != rt);                              break;
+        case OP_TYPE_LESS:      *res = (lt <  rt);                              break;
+        case OP_TYPE_LESSEQ:    *res = (lt <= rt);                              break;
+        case OP_TYPE_GREAT:     *res = (lt >  rt);                              break;
+        case OP_TYPE_GREATEQ:   *res = (lt >= rt);                              break;
+
+        default:
+            stop_(interpreter);
+            break;
+    }
+
+#pragma GCC diagnostic pop
+}
+
+// stopped or returned interpreter unwinds to the call without errors
+#define EVAL_(elem_, val_)                                                                          \
+    do {                                                                                            \
+        TREE_ERROR_HANDLE(eval_(interpreter, (elem_), (val_)));                                     \
+        if (interpreter->state != INTERPRETER_STATE_RUN)                                            \
+            return TREE_ERROR_SUCCESS;                                                              \
+    } while(0)
+
+static enum TreeError eval_(interpreter_t* const interpreter, const tree_elem_t* const elem,
+                            num_t* const val);
+static enum TreeError exec_(interpreter_t* const interpreter, const tree_elem_t* const elem);
+
+static enum TreeError call_(interpreter_t* const interpreter, const tree_elem_t* const call,
+                            num_t* const val)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(call), "");
+    lassert(!is_invalid_ptr(val), "");
+
+    const func_purity_t* const callee = purity_find(&interpreter->purity, call->lt->lexem.data.var,
+                                                    func_args_cnt(call->rt));
+
+    if (!callee || !callee->is_pure || interpreter->depth >= INTERPRETER_DEPTH_MAX)
+    {
+        stop_(interpreter);
+        return TREE_ERROR_SUCCESS;
+    }
+
+    const size_t vars_begin  = stack_size(interpreter->vars);
+    const size_t items_begin = stack_size(interpreter->items);
+
+    // args are evaluated in the frame of the caller, then they are renamed to params
+    if (callee->count_args)
+    {
+        TREE_ERROR_HANDLE(tree_chain_collect(&interpreter->items, call->rt, OP_TYPE_ARGS_COMMA));
+        TREE_ERROR_HANDLE(tree_chain_collect(&interpreter->items, callee->params, OP_TYPE_ARGS_COMMA));
+    }
+
+    for (size_t arg_ind = 0; arg_ind < callee->count_args; ++arg_ind)
+    {
+        const tree_elem_t* const arg = *(const tree_elem_t**)stack_get(interpreter->items,
+                                                                        items_begin + arg_ind);
+        interpreter_var_t var = {.name = NO_NAME_, .val = 0, .is_init = true};
+        EVAL_(arg, &var.val);
+        STACK_ERROR_HANDLE_(stack_push(&interpreter->vars, &var));
+    }
+
+    for (size_t arg_ind = 0; arg_ind < callee->count_args; ++arg_ind)
+    {
+        const tree_elem_t* const param = *(const tree_elem_t**)stack_get(interpreter->items,
+                                                        items_begin + callee->count_args + arg_ind);
+        ((interpreter_var_t*)stack_get(interpreter->vars, vars_begin + arg_ind))->name
+            = param->lexem.data.var;
+    }
+
+    TREE_ERROR_HANDLE(truncate_(&interpreter->items, items_begin));
+
+    const size_t frame_begin = interpreter->frame_begin;
+    interpreter->frame_begin = vars_begin;
+    ++interpreter->depth;
+
+    TREE_ERROR_HANDLE(exec_(interpreter, callee->body));
+
+    --interpreter->depth;
+    interpreter->frame_begin = frame_begin;
+
+    if (interpreter->state == INTERPRETER_STATE_STOP)
+        return TREE_ERROR_SUCCESS;
+
+    // function without return gives garbage
+    if (interpreter->state == INTERPRETER_STATE_RUN)
+    {
+        stop_(interpreter);
+        return TREE_ERROR_SUCCESS;
+    }
+
+    interpreter->state = INTERPRETER_STATE_RUN;
+    *val = interpreter->ret_val;
+
+    return truncate_(&interpreter->vars, vars_begin);
+}
+
+static enum TreeError eval_(interpreter_t* const interpreter, const tree_elem_t* const elem,
+                            num_t* const val)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(val), "");
+
+    if (!elem || !step_(interpreter))
+    {
+        stop_(interpreter);
+        return TREE_ERROR_SUCCESS;
+    }
+
+    if (elem->lexem.type == LEXEM_TYPE_NUM)
+    {
+        *val = elem->lexem.data.num;
+        return TREE_ERROR_SUCCESS;
+    }
+
+    if (elem->lexem.type == LEXEM_TYPE_VAR)
+    {
+        const size_t var_ind = find_var_(interpreter, elem->lexem.data.var);
+        const interpreter_var_t* const var = var_ind == NO_VAR_ ? NULL
+                                                                : stack_get(interpreter->vars, var_ind);
+        if (!var || !var->is_init)
+            stop_(interpreter);
+        else
+            *val = var->val;
+
+        return TREE_ERROR_SUCCESS;
+    }
+
+    if (is_op_(elem, OP_TYPE_FUNC_LBRAKET))
+        return call_(interpreter, elem, val);
+
+    if (elem->lexem.type != LEXEM_TYPE_OP || !OPERATIONS[elem->lexem.data.op].is_ariphmetic)
+    {
+        stop_(interpreter);
+        return TREE_ERROR_SUCCESS;
+    }
+
+    num_t lt = 0;
+    num_t rt = 0;
+    EVAL_(elem->lt, &lt);
+    EVAL_(elem->rt, &rt);
+
+    binary_(interpreter, elem->lexem.data.op, lt, rt, val);
+
+    return TREE_ERROR_SUCCESS;
+}
+
+// vars of body are out of scope after it
+static enum TreeError exec_scope_(interpreter_t* const interpreter, const tree_elem_t* const body)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+
+    const size_t vars_begin = stack_size(interpreter->vars);
+
+    TREE_ERROR_HANDLE(exec_(interpreter, body));
+
+    return truncate_(&interpreter->vars, vars_begin);
+}
+
+static enum TreeError exec_chain_(interpreter_t* const interpreter, const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(elem), "");
+
+    const size_t items_begin = stack_size(interpreter->items);
+    TREE_ERROR_HANDLE(tree_chain_collect(&interpreter->items, elem, OP_TYPE_PLEASE));
+    const size_t items_end = stack_size(interpreter->items);
+
+    for (size_t item_ind = items_begin; item_ind < items_end; ++item_ind)
+    {
+        const tree_elem_t* const statement = *(const tree_elem_t**)stack_get(interpreter->items,
+                                                                              item_ind);
+        TREE_ERROR_HANDLE(exec_(interpreter, statement));
+
+        if (interpreter->state != INTERPRETER_STATE_RUN)
+            break;
+    }
+
+    return truncate_(&interpreter->items, items_begin);
+}
+
+static enum TreeError exec_decl_(interpreter_t* const interpreter, const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(elem), "");
+
+    // var is declared before its initializer, like in translation, and it has garbage there
+    const size_t var_ind = stack_size(interpreter->vars);
+    const interpreter_var_t var = {.name = elem->lt->lexem.data.var, .val = 0, .is_init = false};
+    STACK_ERROR_HANDLE_(stack_push(&interpreter->vars, &var));
+
+    num_t val = 0;
+    if (elem->rt)
+        EVAL_(elem->rt, &val);
+
+    interpreter_var_t* const decl = stack_get(interpreter->vars, var_ind);
+    decl->val     = val;
+    decl->is_init = true;
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static enum TreeError exec_assignment_(interpreter_t* const interpreter, const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(elem), "");
+
+    const size_t var_ind = find_var_(interpreter, elem->lt->lexem.data.var);
+    if (var_ind == NO_VAR_)
+    {
+        stop_(interpreter);
+        return TREE_ERROR_SUCCESS;
+    }
+
+    num_t val = 0;
+    EVAL_(elem->rt, &val);
+
+    interpreter_var_t* const var = stack_get(interpreter->vars, var_ind);
+
+    enum OpType op = OP_TYPE_UNKNOWN;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+
+    switch (elem->lexem.data.op)
+    {
+        case OP_TYPE_ASSIGNMENT:
+        {
+            var->val     = val;
+            var->is_init = true;
+            return TREE_ERROR_SUCCESS;
+        }
+
+        case OP_TYPE_SUM_ASSIGNMENT:    op = OP_TYPE_SUM;   break;
+        case OP_TYPE_SUB_ASSIGNMENT:    op = OP_TYPE_SUB;   break;
+        case OP_TYPE_MUL_ASSIGNMENT:    op = OP_TYPE_MUL;   break;
+        case OP_TYPE_DIV_ASSIGNMENT:    op = OP_TYPE_DIV;   break;
+        case OP_TYPE_POW_ASSIGNMENT:    op = OP_TYPE_POW;   break;
+
+        default:
+            break;
+    }
+
+#pragma GCC diagnostic pop
+
+    if (!var->is_init)
+    {
+        stop_(interpreter);
+        return TREE_ERROR_SUCCESS;
+    }
+
+    binary_(interpreter, op, var->val, val, &var->val);
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static enum TreeError exec_if_(interpreter_t* const interpreter, const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(elem), "");
+
+    num_t cond = 0;
+    EVAL_(elem->lt, &cond);
+
+    return exec_scope_(interpreter, cond ? elem->rt->lt : elem->rt->rt);
+}
+
+// else of WHILE is executed, if condition is false before the first iteration
+static enum TreeError exec_while_(interpreter_t* const interpreter, const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(elem), "");
+
+    num_t cond = 0;
+    EVAL_(elem->lt, &cond);
+
+    if (!cond)
+        return exec_scope_(interpreter, elem->rt->rt);
+
+    while (cond)
+    {
+        TREE_ERROR_HANDLE(exec_scope_(interpreter, elem->rt->lt));
+
+        if (interpreter->state != INTERPRETER_STATE_RUN)
+            return TREE_ERROR_SUCCESS;
+
+        EVAL_(elem->lt, &cond);
+    }
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static enum TreeError exec_(interpreter_t* const interpreter, const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+
+    if (!elem)
+        return TREE_ERROR_SUCCESS;
+
+    if (!step_(interpreter))
+        return TREE_ERROR_SUCCESS;
+
+    if (elem->lexem.type != LEXEM_TYPE_OP)
+    {
+        stop_(interpreter);
+        return TREE_ERROR_SUCCESS;
+    }
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wswitch-enum"
+
+    switch (elem->lexem.data.op)
+    {
+        case OP_TYPE_PLEASE:            return exec_chain_     (interpreter, elem);
+        case OP_TYPE_DECL_ASSIGNMENT:   return exec_decl_      (interpreter, elem);
+        case OP_TYPE_IF:                return exec_if_        (interpreter, elem);
+        case OP_TYPE_WHILE:             return exec_while_     (interpreter, elem);
+
+        case OP_TYPE_ASSIGNMENT:
+        case OP_TYPE_SUM_ASSIGNMENT:
+        case OP_TYPE_SUB_ASSIGNMENT:
+        case OP_TYPE_MUL_ASSIGNMENT:
+        case OP_TYPE_DIV_ASSIGNMENT:
+        case OP_TYPE_POW_ASSIGNMENT:    return exec_assignment_(interpreter, elem);
+
+        case OP_TYPE_RET:
+        {
+            num_t val = 0;
+            EVAL_(elem->lt, &val);
+
+            interpreter->ret_val = val;
+            interpreter->state   = INTERPRETER_STATE_RET;
+            return TREE_ERROR_SUCCESS;
+        }
+
+        default:
+            stop_(interpreter);
+            return TREE_ERROR_SUCCESS;
+    }
+
+#pragma GCC diagnostic pop
+
+    return TREE_ERROR_SUCCESS;
+}
+
+enum TreeError interpreter_call(interpreter_t* const interpreter, const tree_elem_t* const call,
+                                num_t* const res, bool* const is_evaluated)
+{
+    lassert(!is_invalid_ptr(interpreter), "");
+    lassert(!is_invalid_ptr(call), "");
+    lassert(!is_invalid_ptr(res), "");
+    lassert(!is_invalid_ptr(is_evaluated), "");
+
+    *is_evaluated = false;
+
+    interpreter->state       = INTERPRETER_STATE_RUN;
+    interpreter->call_steps  = INTERPRETER_CALL_STEPS_MAX;
+    interpreter->frame_begin = 0;
+    interpreter->depth       = 0;
+
+    num_t val = 0;
+    const enum TreeError error = call_(interpreter, call, &val);
+
+    // stopped interpreter leaves vars and items of the calls
+    TREE_ERROR_HANDLE(truncate_(&interpreter->vars, 0));
+    TREE_ERROR_HANDLE(truncate_(&interpreter->items, 0));
+
+    if (error)
+        return error;
+
+    if (interpreter->state == INTERPRETER_STATE_RUN)
+    {
+        *res = val;
+        *is_evaluated = true;
+    }
+
+    return TREE_ERROR_SUCCESS;
+}
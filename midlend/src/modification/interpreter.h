@@ -0,0 +1,51 @@
+#ifndef MASIK_MIDLEND_SRC_MODIFICATION_INTERPRETER_H
+#define MASIK_MIDLEND_SRC_MODIFICATION_INTERPRETER_H
+
+#include <stdbool.h>
+
+#include "stack_on_array/libstack.h"
+#include "utils/src/tree/structs.h"
+#include "utils/src/tree/verification/verification.h"
+#include "translation/funcs/purity.h"
+
+// Compile-time evaluation of calls of pure functions with constant args. AST of the callee is run
+// with the same arithmetic as in runtime: wrapping 64-bit ops, truncating division and pow by
+// squaring. Division, that traps in runtime, exceeded budget of steps or calls depth, function
+// without return and unknown node stop interpreter, then the call stays for runtime.
+
+#define INTERPRETER_STEPS_MAX       (1ul << 24)     // for all calls of the tree
+#define INTERPRETER_CALL_STEPS_MAX  (1ul << 20)
+#define INTERPRETER_DEPTH_MAX       (256)
+
+enum InterpreterState
+{
+    INTERPRETER_STATE_RUN           = 0,
+    INTERPRETER_STATE_RET           = 1,
+    INTERPRETER_STATE_STOP          = 2,
+};
+
+typedef struct Interpreter
+{
+    purity_t purity;
+
+    stack_key_t vars;           // interpreter_var_t of all active calls
+    stack_key_t items;          // statements and args, that are executed now
+    size_t frame_begin;         // first var of current call
+    size_t depth;
+
+    size_t steps;               // left for the tree
+    size_t call_steps;          // left for current evaluated call
+    enum InterpreterState state;
+    num_t ret_val;
+} interpreter_t;
+
+// funcs of the tree are analyzed for purity. Roots of their bodies are statements, so they
+// aren't replaced by simplification and interpreter may be used for the whole simplification
+enum TreeError interpreter_ctor(interpreter_t* const interpreter, const tree_elem_t* const root);
+void           interpreter_dtor(interpreter_t* const interpreter);
+
+// *is_evaluated false - call can't be evaluated at compile time
+enum TreeError interpreter_call(interpreter_t* const interpreter, const tree_elem_t* const call,
+                                num_t* const res, bool* const is_evaluated);
+
+#endif /* MASIK_MIDLEND_SRC_MODIFICATION_INTERPRETER_H */
@@ -1,6 +1,8 @@
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "modification/modification.h"
+#include "modification/interpreter.h"
 #include "logger/liblogger.h"
 #include "utils/src/operations/op_math.h"
 
@@ -23,10 +25,16 @@ const char* modification_strerror(const enum ModificationError error)
 
 enum TreeError tree_simplify_(tree_t* const tree);
 
+static tree_pool_t* pool_ = NULL;
+static size_t*      size_ = NULL;
+
 enum TreeError tree_modify(tree_t* const tree, const enum Mode mode)
 {
     TREE_VERIFY_ASSERT(tree);
 
+    pool_ = &tree->pool;
+    size_ = &tree->size;
+
     switch (mode)
     {
     case MODE_NOTHING:
@@ -55,259 +63,341 @@ enum TreeError tree_modify(tree_t* const tree, const enum Mode mode)
     return TREE_ERROR_SUCCESS;
 }
 
-enum TreeError tree_simplify_constants_(tree_elem_t** elem, size_t* const count_changes);
-enum TreeError tree_simplify_trivial_  (tree_elem_t** elem, size_t* const count_changes);
+typedef struct Simplifier
+{
+    interpreter_t interpreter;
+    size_t count_changes;
+} simplifier_t;
+
+// Rule is tried on op elem, which children are already simplified. apply replaces *elem by
+// equivalent subtree and keeps tree size, *is_changed false - rule turned out to be inapplicable.
+typedef struct SimplifyRule
+{
+    enum OpType op;                                 // OP_TYPE_UNKNOWN - any ariphmetic op
+    bool (*is_match)(const tree_elem_t* const elem);
+    enum TreeError (*apply)(simplifier_t* const simplifier, tree_elem_t** elem,
+                            bool* const is_changed);
+} simplify_rule_t;
+
+static bool is_const_operands_(const tree_elem_t* const elem);
+static bool is_const_args_    (const tree_elem_t* const elem);
+static bool is_zero_rt_       (const tree_elem_t* const elem);
+static bool is_zero_lt_       (const tree_elem_t* const elem);
+static bool is_one_rt_        (const tree_elem_t* const elem);
+static bool is_one_lt_        (const tree_elem_t* const elem);
+static bool is_zero_rt_pure_  (const tree_elem_t* const elem);
+static bool is_zero_lt_pure_  (const tree_elem_t* const elem);
+static bool is_zero_div_pure_ (const tree_elem_t* const elem);
+
+static enum TreeError fold_constants_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed);
+static enum TreeError fold_call_     (simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed);
+static enum TreeError change_to_lt_  (simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed);
+static enum TreeError change_to_rt_  (simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed);
+static enum TreeError change_to_zero_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed);
+static enum TreeError change_to_one_ (simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed);
+static enum TreeError change_to_neg_ (simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed);
+
+// earlier rule of the same op wins
+static const simplify_rule_t RULES_[] =
+{
+//   op                     is_match            apply
+    {OP_TYPE_UNKNOWN,       is_const_operands_, fold_constants_ },
+    {OP_TYPE_FUNC_LBRAKET,  is_const_args_,     fold_call_      },
+
+    {OP_TYPE_POW,           is_one_rt_,         change_to_lt_   },
+    {OP_TYPE_POW,           is_zero_rt_pure_,   change_to_one_  },
+
+    {OP_TYPE_MUL,           is_zero_lt_pure_,   change_to_zero_ },
+    {OP_TYPE_MUL,           is_zero_rt_pure_,   change_to_zero_ },
+    {OP_TYPE_MUL,           is_one_rt_,         change_to_lt_   },
+    {OP_TYPE_MUL,           is_one_lt_,         change_to_rt_   },
+
+    {OP_TYPE_SUM,           is_zero_rt_,        change_to_lt_   },
+    {OP_TYPE_SUM,           is_zero_lt_,        change_to_rt_   },
 
+    {OP_TYPE_SUB,           is_zero_rt_,        change_to_lt_   },
+    {OP_TYPE_SUB,           is_zero_lt_,        change_to_neg_  },
+
+    {OP_TYPE_DIV,           is_zero_div_pure_,  change_to_zero_ },
+};
+#define RULES_CNT_ (sizeof(RULES_) / sizeof(*RULES_))
+static_assert(RULES_CNT_ <= 32, "fired rules of elem are bits of uint32_t");
+
+static enum TreeError simplify_elem_(tree_elem_t** elem, void* const simplifier);
+
+// Rules look only at elem and its children, so after post-order walk every elem is visited
+// after its changed children and one pass reaches the fixpoint.
 enum TreeError tree_simplify_(tree_t* const tree)
 {
     TREE_VERIFY_ASSERT(tree);
 
-    size_t count_changes = 0;
-    do
-    {
-        count_changes = 0;
-        TREE_ERROR_HANDLE(tree_simplify_constants_(&tree->Groot, &count_changes));
-        TREE_ERROR_HANDLE(tree_simplify_trivial_  (&tree->Groot, &count_changes));
-    } while (count_changes);
+    simplifier_t simplifier = {};
+    TREE_ERROR_HANDLE(interpreter_ctor(&simplifier.interpreter, tree->Groot));
 
-    tree_update_size(tree);
+    TREE_ERROR_HANDLE(tree_walk_post(&tree->Groot, NULL, simplify_elem_, &simplifier),
+                      interpreter_dtor(&simplifier.interpreter););
+
+    interpreter_dtor(&simplifier.interpreter);
 
     TREE_VERIFY_ASSERT(tree);
     return TREE_ERROR_SUCCESS;
 }
 
-#define OPERATION_HANDLE(num_, name_, ...)                                                          \
-    case OP_TYPE_##name_:                                                                           \
-        *elem = tree_elem_ctor((lexem_t){.type = LEXEM_TYPE_NUM,                                    \
-                                         .data.num = math_##name_((*elem)->lt->lexem.data.num,      \
-                                                                  (*elem)->rt->lexem.data.num)},    \
-                                NULL, NULL);                                                        \
-        break;
+static bool is_rule_op_(const simplify_rule_t* const rule, const tree_elem_t* const elem)
+{
+    return rule->op == OP_TYPE_UNKNOWN ? OPERATIONS[elem->lexem.data.op].is_ariphmetic
+                                       : rule->op == elem->lexem.data.op;
+}
 
-enum TreeError tree_simplify_constants_(tree_elem_t** elem, size_t* const count_changes)
+// children are already simplified by tree_walk_post
+static enum TreeError simplify_elem_(tree_elem_t** elem, void* const simplifier)
 {
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(count_changes), "");
+    lassert(!is_invalid_ptr(simplifier), "");
 
-    if (!*elem)
-        return TREE_ERROR_SUCCESS;
-    
-    TREE_ERROR_HANDLE(tree_simplify_constants_(&(*elem)->lt, count_changes));
-    TREE_ERROR_HANDLE(tree_simplify_constants_(&(*elem)->rt, count_changes));
-
-    if((*elem)->lexem.type != LEXEM_TYPE_OP)
-        return TREE_ERROR_SUCCESS;
-    
-    const bool is_correct = 
-        ((*elem)->lt && ((*elem)->lt->lexem.type == LEXEM_TYPE_NUM)) &&
-        ((*elem)->rt && ((*elem)->rt->lexem.type == LEXEM_TYPE_NUM)) &&
-        OPERATIONS[(*elem)->lexem.data.op].is_ariphmetic;
+    uint32_t fired = 0;
 
-    if (!is_correct)
-        return TREE_ERROR_SUCCESS;
-
-    tree_elem_t* temp = *elem;
-
-    switch((*elem)->lexem.data.op)
+    // after change elem is tried from the first rule again, each rule fires once
+    for (size_t rule_ind = 0; rule_ind < RULES_CNT_ && (*elem)->lexem.type == LEXEM_TYPE_OP;)
     {
-        #include "utils/src/operations/codegen.h"
+        const simplify_rule_t* const rule = &RULES_[rule_ind];
 
-        case OP_TYPE_UNKNOWN:
-        default:
-            fprintf(stderr, "Unknown op type\n");
-            return TREE_ERROR_INVALID_OP_TYPE;
-    }
+        if ((fired & (1u << rule_ind)) || !is_rule_op_(rule, *elem) || !rule->is_match(*elem))
+        {
+            ++rule_ind;
+            continue;
+        }
 
-    if ((*elem)->lexem.data.num == NUM_POISON)
-    {
-        fprintf(stderr, "Incorrect operation\n");
-        return TREE_ERROR_INVALID_DATA_NUM;
-    }
+        fired |= 1u << rule_ind;
 
-    tree_elem_dtor_recursive(&temp);
+        bool is_changed = false;
+        TREE_ERROR_HANDLE(rule->apply(simplifier, elem, &is_changed));
 
-    ++*count_changes;
+        if (is_changed)
+        {
+            ++((simplifier_t*)simplifier)->count_changes;
+            rule_ind = 0;
+        }
+        else
+        {
+            ++rule_ind;
+        }
+    }
 
     return TREE_ERROR_SUCCESS;
 }
-#undef OPERATION_HANDLE
 
-enum TreeError tree_simplify_POW_(tree_elem_t** tree, size_t* const count_changes);
-enum TreeError tree_simplify_MUL_(tree_elem_t** tree, size_t* const count_changes);
-enum TreeError tree_simplify_SUM_(tree_elem_t** tree, size_t* const count_changes);
-enum TreeError tree_simplify_SUB_(tree_elem_t** tree, size_t* const count_changes);
-enum TreeError tree_simplify_DIV_(tree_elem_t** tree, size_t* const count_changes);
+//==================================== MATCHES ===========================================
 
-enum TreeError tree_simplify_trivial_  (tree_elem_t** elem, size_t* const count_changes)
+static bool is_num_(const tree_elem_t* const elem)
+{
+    return elem && elem->lexem.type == LEXEM_TYPE_NUM;
+}
+
+// trapping division is left for runtime
+static bool is_const_operands_(const tree_elem_t* const elem)
 {
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(count_changes), "");
 
-    if (!*elem || (*elem)->lexem.type != LEXEM_TYPE_OP)
-        return TREE_ERROR_SUCCESS;
-        
-    
-    TREE_ERROR_HANDLE(tree_simplify_trivial_(&(*elem)->lt, count_changes));
-    TREE_ERROR_HANDLE(tree_simplify_trivial_(&(*elem)->rt, count_changes));
+    if (!is_num_(elem->lt) || !is_num_(elem->rt))
+        return false;
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wswitch-enum"
+    return elem->lexem.data.op != OP_TYPE_DIV
+        || (elem->rt->lexem.data.num != 0
+            && !(elem->lt->lexem.data.num == INT64_MIN && elem->rt->lexem.data.num == -1));
+}
 
-    switch((*elem)->lexem.data.op)
+static bool is_const_args_(const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(elem), "");
+
+    const tree_elem_t* args = elem->rt;
+    for (; args && args->lexem.type == LEXEM_TYPE_OP && args->lexem.data.op == OP_TYPE_ARGS_COMMA;
+           args = args->lt)
     {
-        case OP_TYPE_POW:
-        {
-            TREE_ERROR_HANDLE(tree_simplify_POW_(elem, count_changes));
-            break;
-        }
-        case OP_TYPE_MUL:
-        {
-            TREE_ERROR_HANDLE(tree_simplify_MUL_(elem, count_changes));
-            break;
-        }
-        case OP_TYPE_SUM:
-        {
-            TREE_ERROR_HANDLE(tree_simplify_SUM_(elem, count_changes));
-            break;
-        }
-        case OP_TYPE_SUB:
-        {
-            TREE_ERROR_HANDLE(tree_simplify_SUB_(elem, count_changes));
-            break;
-        }
-        case OP_TYPE_DIV:
-        {
-            TREE_ERROR_HANDLE(tree_simplify_DIV_(elem, count_changes));
-            break;
-        }
-        default:
-            break;
+        if (!is_num_(args->rt))
+            return false;
     }
 
-#pragma GCC diagnostic pop
+    return !args || is_num_(args);
+}
+
+static bool is_zero_rt_(const tree_elem_t* const elem)
+{
+    return is_num_(elem->rt) && elem->rt->lexem.data.num == 0;
+}
+static bool is_zero_lt_(const tree_elem_t* const elem)
+{
+    return is_num_(elem->lt) && elem->lt->lexem.data.num == 0;
+}
+static bool is_one_rt_ (const tree_elem_t* const elem)
+{
+    return is_num_(elem->rt) && elem->rt->lexem.data.num == 1;
+}
+static bool is_one_lt_ (const tree_elem_t* const elem)
+{
+    return is_num_(elem->lt) && elem->lt->lexem.data.num == 1;
+}
+
+static enum TreeError find_call_(const tree_elem_t* elem, void* const is_found)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(is_found), "");
+
+    if (elem->lexem.type == LEXEM_TYPE_OP && elem->lexem.data.op == OP_TYPE_FUNC_LBRAKET)
+        *(bool*)is_found = true;
 
     return TREE_ERROR_SUCCESS;
 }
 
-static bool is_zero_rt_(const tree_elem_t* const tree)
+// called function may do out, so operand with calls isn't dropped
+static bool is_pure_(const tree_elem_t* const elem)
 {
-    return tree->rt->lexem.type == LEXEM_TYPE_NUM && tree->rt->lexem.data.num == 0;
+    bool is_found = false;
+
+    return !tree_walk_pre(elem, find_call_, &is_found) && !is_found;
 }
-static bool is_zero_lt_(const tree_elem_t* const tree)
+
+// other operand is dropped by rule
+static bool is_zero_rt_pure_(const tree_elem_t* const elem)
 {
-    return tree->lt->lexem.type == LEXEM_TYPE_NUM && tree->lt->lexem.data.num == 0;
+    return is_zero_rt_(elem) && is_pure_(elem->lt);
 }
-static bool is_one_rt_ (const tree_elem_t* const tree)
+static bool is_zero_lt_pure_(const tree_elem_t* const elem)
 {
-    return tree->rt->lexem.type == LEXEM_TYPE_NUM && tree->rt->lexem.data.num == 1;
+    return is_zero_lt_(elem) && is_pure_(elem->rt);
 }
-static bool is_one_lt_ (const tree_elem_t* const tree)
+// 0 / 0 traps at runtime, like other division by zero
+static bool is_zero_div_pure_(const tree_elem_t* const elem)
 {
-    return tree->lt->lexem.type == LEXEM_TYPE_NUM && tree->lt->lexem.data.num == 1;
+    return is_zero_lt_pure_(elem) && !is_zero_rt_(elem);
 }
 
-void change_tree_to_lt_ (tree_elem_t** tree);
-void change_tree_to_rt_ (tree_elem_t** tree);
-void change_tree_to_num_(tree_elem_t** tree, const num_t num);
+//==================================== APPLIES ===========================================
+
+static void change_tree_to_lt_ (tree_elem_t** tree);
+static void change_tree_to_rt_ (tree_elem_t** tree);
+static void change_tree_to_num_(tree_elem_t** tree, const num_t num);
 
+#define OPERATION_HANDLE(num_, name_, ...)                                                          \
+    case OP_TYPE_##name_:                                                                           \
+        res = math_##name_((*elem)->lt->lexem.data.num, (*elem)->rt->lexem.data.num);               \
+        break;
 
-enum TreeError tree_simplify_POW_(tree_elem_t** tree, size_t* const count_changes)
+static enum TreeError fold_constants_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed)
 {
-    lassert(!is_invalid_ptr(tree), "");
-    lassert(!is_invalid_ptr(count_changes), "");
+    lassert(!is_invalid_ptr(simplifier), "");
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(is_changed), "");
 
-    if ((is_one_rt_(*tree)))
-    {
-        change_tree_to_lt_(tree);
-        ++*count_changes;
-    }
-    else if ((is_zero_rt_(*tree)))
+    num_t res = 0;
+
+    switch((*elem)->lexem.data.op)
     {
-        change_tree_to_num_(tree, 1);
-        ++*count_changes;
+        #include "utils/src/operations/codegen.h"
+
+        case OP_TYPE_UNKNOWN:
+        default:
+            fprintf(stderr, "Unknown op type\n");
+            return TREE_ERROR_INVALID_OP_TYPE;
     }
-    
+
+    change_tree_to_num_(elem, res);
+    *is_changed = true;
+
     return TREE_ERROR_SUCCESS;
 }
+#undef OPERATION_HANDLE
 
-enum TreeError tree_simplify_MUL_(tree_elem_t** tree, size_t* const count_changes)
+// call of pure function with constant args is evaluated at compile time, args are already simplified
+static enum TreeError fold_call_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                 bool* const is_changed)
 {
-    lassert(!is_invalid_ptr(tree), "");
-    lassert(!is_invalid_ptr(count_changes), "");
+    lassert(!is_invalid_ptr(simplifier), "");
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(is_changed), "");
 
-    if ((is_zero_lt_(*tree)) || (is_zero_rt_(*tree)))
-    {
-        change_tree_to_num_(tree, 0);
-        ++*count_changes;
-    }
-    else if ((is_one_rt_(*tree)))
-    {
-        change_tree_to_lt_(tree);
-        ++*count_changes;
-    }
-    else if ((is_one_lt_(*tree)))
-    {
-        change_tree_to_rt_(tree);
-        ++*count_changes;
-    }
+    num_t res = 0;
+    TREE_ERROR_HANDLE(interpreter_call(&simplifier->interpreter, *elem, &res, is_changed));
+
+    if (*is_changed)
+        change_tree_to_num_(elem, res);
 
     return TREE_ERROR_SUCCESS;
 }
 
-enum TreeError tree_simplify_SUM_(tree_elem_t** tree, size_t* const count_changes)
+static enum TreeError change_to_lt_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                    bool* const is_changed)
 {
-    lassert(!is_invalid_ptr(tree), "");
-    lassert(!is_invalid_ptr(count_changes), "");
+    lassert(!is_invalid_ptr(simplifier), "");
+    lassert(!is_invalid_ptr(is_changed), "");
 
-    if ((is_zero_rt_(*tree)))
-    {
-        change_tree_to_lt_(tree);
-        ++*count_changes;
-    }
-    else if ((is_zero_lt_(*tree)))
-    {
-        change_tree_to_rt_(tree);
-        ++*count_changes;
-    }
+    change_tree_to_lt_(elem);
+    *is_changed = true;
 
     return TREE_ERROR_SUCCESS;
 }
 
-enum TreeError tree_simplify_SUB_(tree_elem_t** tree, size_t* const count_changes)
+static enum TreeError change_to_rt_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                    bool* const is_changed)
 {
-    lassert(!is_invalid_ptr(tree), "");
-    lassert(!is_invalid_ptr(count_changes), "");
+    lassert(!is_invalid_ptr(simplifier), "");
+    lassert(!is_invalid_ptr(is_changed), "");
 
-    if ((is_zero_rt_(*tree)))
-    {
-        change_tree_to_lt_(tree);
-        ++*count_changes;
-    }
-    else if ((is_zero_lt_(*tree)))
-    {
-        (*tree)->lexem.data.op = OP_TYPE_MUL;
-        (*tree)->lt->lexem.data.num = -1;
-        ++*count_changes;
-    }
+    change_tree_to_rt_(elem);
+    *is_changed = true;
 
     return TREE_ERROR_SUCCESS;
 }
 
-enum TreeError tree_simplify_DIV_(tree_elem_t** tree, size_t* const count_changes)
+static enum TreeError change_to_zero_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                      bool* const is_changed)
 {
-    lassert(!is_invalid_ptr(tree), "");
-    lassert(!is_invalid_ptr(count_changes), "");
+    lassert(!is_invalid_ptr(simplifier), "");
+    lassert(!is_invalid_ptr(is_changed), "");
 
-    if ((is_zero_lt_(*tree)))
-    {
-        change_tree_to_num_(tree, 0);
-        ++*count_changes;
-    }
+    change_tree_to_num_(elem, 0);
+    *is_changed = true;
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static enum TreeError change_to_one_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                     bool* const is_changed)
+{
+    lassert(!is_invalid_ptr(simplifier), "");
+    lassert(!is_invalid_ptr(is_changed), "");
+
+    change_tree_to_num_(elem, 1);
+    *is_changed = true;
+
+    return TREE_ERROR_SUCCESS;
+}
+
+// 0 - x -> -1 * x
+static enum TreeError change_to_neg_(simplifier_t* const simplifier, tree_elem_t** elem,
+                                     bool* const is_changed)
+{
+    lassert(!is_invalid_ptr(simplifier), "");
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(is_changed), "");
+
+    (*elem)->lexem.data.op = OP_TYPE_MUL;
+    (*elem)->lt->lexem.data.num = -1;
+    *is_changed = true;
 
     return TREE_ERROR_SUCCESS;
 }
 
-void change_tree_to_lt_ (tree_elem_t** tree)
+static void change_tree_to_lt_ (tree_elem_t** tree)
 {
     lassert(!is_invalid_ptr(tree), "");
 
@@ -316,10 +406,10 @@ void change_tree_to_lt_ (tree_elem_t** tree)
     *tree = (*tree)->lt;
 
     temp->lt = NULL;
-    tree_elem_dtor_recursive(&temp);
+    *size_ -= tree_elem_dtor_recursive(pool_, &temp);
 }
 
-void change_tree_to_rt_ (tree_elem_t** tree)
+static void change_tree_to_rt_ (tree_elem_t** tree)
 {
     lassert(!is_invalid_ptr(tree), "");
 
@@ -328,18 +418,17 @@ void change_tree_to_rt_ (tree_elem_t** tree)
     *tree = (*tree)->rt;
 
     temp->rt = NULL;
-    tree_elem_dtor_recursive(&temp);
+    *size_ -= tree_elem_dtor_recursive(pool_, &temp);
 }
 
-void change_tree_to_num_(tree_elem_t** tree, const num_t num)
+static void change_tree_to_num_(tree_elem_t** tree, const num_t num)
 {
     lassert(!is_invalid_ptr(tree), "");
 
     tree_elem_t* temp = *tree;
 
-    *tree = tree_elem_ctor((lexem_t){.type = LEXEM_TYPE_NUM, .data.num = num}, NULL, NULL);
+    *tree = tree_elem_ctor(pool_, (lexem_t){.type = LEXEM_TYPE_NUM, .data.num = num}, NULL, NULL);
+    ++*size_;
 
-    tree_elem_dtor_recursive(&temp);
+    *size_ -= tree_elem_dtor_recursive(pool_, &temp);
 }
-
-
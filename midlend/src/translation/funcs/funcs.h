@@ -4,9 +4,20 @@
 #include <stdio.h>
 
 #include "utils/src/tree/structs.h"
+#include "utils/src/interner/interner.h"
 #include "translation/verification/verification.h"
+#include "translation/funcs/pyam_bin.h"
+#include "translation/structs.h"
 
-enum IrTranslationError translate(const tree_t* const tree, FILE* out);
+// names == NULL - diagnostics without names, bin_out == NULL - only text IR
+enum IrTranslationError translate(const tree_t* const tree, const interner_t* const names,
+                                  const ir_translation_opts_t opts, FILE* out, FILE* bin_out);
+
+// out == NULL - without text IR, bin == NULL - without binary records.
+// bin is constructed and destructed by caller, so records stay in memory after translation
+enum IrTranslationError translate_ir(const tree_t* const tree, const interner_t* const names,
+                                     const ir_translation_opts_t opts, FILE* out,
+                                     pyam_bin_writer_t* const bin);
 
 
 #endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_FUNCS_H */
\ No newline at end of file
@@ -0,0 +1,347 @@
+#include <stdbool.h>
+
+#include "utils/utils.h"
+#include "utils/src/tree/funcs/funcs.h"
+#define IR_file out
+#define NUM_SPECIFER_ "%ld"
+#include "PYAM_IR/include/libpyam_ir.h"
+#include "ir_emit.h"
+#include "translation_lib.h"
+#include "purity.h"
+#include "pow_chain.h"
+#include "inline.h"
+
+#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
+    do {                                                                                            \
+        const enum StackError stack_error_handler = call_func;                                      \
+        if (stack_error_handler)                                                                    \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Stack error: %s\n",                               \
+                            stack_strerror(stack_error_handler));                                   \
+            __VA_ARGS__                                                                             \
+            return IR_TRANSLATION_ERROR_STACK;                                                      \
+        }                                                                                           \
+    } while(0)
+
+static bool is_op_(const tree_elem_t* const elem, const enum OpType op)
+{
+    return elem && elem->lexem.type == LEXEM_TYPE_OP && elem->lexem.data.op == op;
+}
+
+#define INLINE_SIZE_MAX_        (40)    // nodes of body
+#define INLINE_ONCE_SIZE_MAX_   (400)   // for function with the only call site
+
+static const wchar_t* func_name_(const translator_t* const translator, const func_purity_t* const func)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    return func ? var_name(translator, func->num) : L"main";
+}
+
+const func_purity_t* inline_callee(const translator_t* const translator, const inline_t* const inl,
+                                   const tree_elem_t* const call)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(inl), "");
+    lassert(!is_invalid_ptr(call), "");
+
+    if (!translator->opts.inline_calls || inl->depth >= INLINE_DEPTH_MAX)
+        return NULL;
+
+    const func_purity_t* const callee = purity_find(&translator->purity, call->lt->lexem.data.var,
+                                                    func_args_cnt(call->rt));
+
+    // recursive function is called anyway, and cache of memoized one would be bypassed
+    if (!callee || !callee->body || callee->self_calls_cnt
+     || (translator->opts.memo && callee->is_memo))
+        return NULL;
+
+    for (size_t depth = 0; depth <= inl->depth; ++depth)
+    {
+        if (inl->chain[depth] == callee)
+            return NULL;
+    }
+
+    if (callee->size <= INLINE_SIZE_MAX_
+     || (callee->call_sites_cnt == 1 && callee->size <= INLINE_ONCE_SIZE_MAX_))
+        return callee;
+
+    return NULL;
+}
+
+static inline_t inline_next_(const inline_t* const inl, const func_purity_t* const callee)
+{
+    lassert(!is_invalid_ptr(inl), "");
+    lassert(!is_invalid_ptr(callee), "");
+
+    inline_t next = *inl;
+
+    next.chain[++next.depth] = callee;
+    next.body     = callee->body;
+    next.is_end_jumped = false;
+    next.res_var  = inl->free_var;
+    next.free_var = inl->free_var + 1 + (long long int)callee->locals_cnt;
+
+    return next;
+}
+
+typedef struct InlineScan
+{
+    const translator_t* translator;
+    const inline_t* inl;
+    long long int vars_end;
+} inline_scan_t;
+
+static enum TreeError scan_inline_(const tree_elem_t* elem, void* const arg)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(arg), "");
+
+    inline_scan_t* const scan = arg;
+
+    pow_chain_t chain = {};
+    if ((is_op_(elem, OP_TYPE_POW) || is_op_(elem, OP_TYPE_POW_ASSIGNMENT))
+     && is_pow_chain(elem->rt, &chain))
+    {
+        // base and elements of the chain
+        const long long int vars_end = scan->inl->free_var + 1 + (long long int)chain.muls_cnt;
+        if (vars_end > scan->vars_end)
+            scan->vars_end = vars_end;
+
+        return TREE_ERROR_SUCCESS;
+    }
+
+    if (!is_op_(elem, OP_TYPE_FUNC_LBRAKET))
+        return TREE_ERROR_SUCCESS;
+
+    const func_purity_t* const callee = inline_callee(scan->translator, scan->inl, elem);
+    if (!callee)
+        return TREE_ERROR_SUCCESS;
+
+    const inline_t inl = inline_next_(scan->inl, callee);
+
+    long long int vars_end = 0;
+    if (inline_vars_end(scan->translator, &inl, callee->body, &vars_end))
+        return TREE_ERROR_STACK;
+
+    if (vars_end > scan->vars_end)
+        scan->vars_end = vars_end;
+
+    return TREE_ERROR_SUCCESS;
+}
+
+enum IrTranslationError inline_vars_end(const translator_t* const translator,
+                                        const inline_t* const inl, const tree_elem_t* const body,
+                                        long long int* const vars_end)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(inl), "");
+    lassert(!is_invalid_ptr(vars_end), "");
+
+    inline_scan_t scan = {.translator = translator, .inl = inl, .vars_end = inl->free_var};
+
+    if (tree_walk_pre(body, scan_inline_, &scan))
+    {
+        fprintf(stderr, "Can't walk body for inlined calls\n");
+        return IR_TRANSLATION_ERROR_STACK;
+    }
+
+    *vars_end = scan.vars_end;
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+// NULL for empty body
+static const tree_elem_t* last_statement_(const tree_elem_t* const body)
+{
+    return is_op_(body, OP_TYPE_PLEASE) ? body->rt : body;
+}
+
+// body ends with return or with if, whose both branches always return
+static bool is_always_ret_(const tree_elem_t* const body)
+{
+    const tree_elem_t* const last = last_statement_(body);
+
+    if (is_op_(last, OP_TYPE_RET))
+        return true;
+
+    return is_op_(last, OP_TYPE_IF) && is_always_ret_(last->rt->lt) && is_always_ret_(last->rt->rt);
+}
+
+// ret is the last statement of body or of a branch of its last if, so it falls to the end of body
+static bool is_tail_ret_(const tree_elem_t* const body, const tree_elem_t* const ret)
+{
+    const tree_elem_t* const last = last_statement_(body);
+
+    if (last == ret)
+        return true;
+
+    return is_op_(last, OP_TYPE_IF)
+        && (is_tail_ret_(last->rt->lt, ret) || is_tail_ret_(last->rt->rt, ret));
+}
+
+// state of the caller, that is restored after inlined body
+typedef struct InlineSaved
+{
+    stack_key_t vars;
+    long long int var_num_base;
+    tail_rec_t tail_rec;
+    memo_t memo;
+    inline_t inl;
+} inline_saved_t;
+
+static enum IrTranslationError inline_enter_(translator_t* const translator, 
+                                             const tree_elem_t** const params,
+                                             const size_t* const arg_tmps, const size_t count_args,
+                                             FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(params), "");
+    lassert(!is_invalid_ptr(arg_tmps), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame(translator));
+
+    for (size_t var_ind = 0; var_ind < count_args; ++var_ind)
+    {
+        CHECK_UNDECLD_VAR_(params[var_ind]);
+        STACK_ERROR_HANDLE_(stack_push(CUR_VAR_STACK_, &params[var_ind]->lexem.data.var));
+    }
+
+    // in reverse, so tmps on stack are taken from its top
+    for (size_t var_ind = count_args; var_ind > 0; --var_ind)
+    {
+        IR_EMIT_ASSIGN_VAR_(translator->var_num_base + (long long int)var_ind - 1, 
+                            arg_tmps[var_ind - 1], "inlined arg");
+    }
+
+    // function may end without return
+    if (!is_always_ret_(translator->inl.body))
+    {
+        IR_EMIT_ASSIGN_TMP_NUM_(translator->temp_var_num++, 0l);
+        IR_EMIT_ASSIGN_VAR_(translator->inl.res_var, translator->temp_var_num - 1, "inlined result");
+    }
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+static enum IrTranslationError inline_leave_(translator_t* const translator, 
+                                             const inline_saved_t* const saved)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(saved), "");
+
+    const enum IrTranslationError error = clean_vars_stacks(translator);
+    stack_dtor(&translator->vars);
+
+    translator->vars         = saved->vars;
+    translator->var_num_base = saved->var_num_base;
+    translator->tail_rec     = saved->tail_rec;
+    translator->memo         = saved->memo;
+    translator->inl          = saved->inl;
+
+    return error;
+}
+
+enum IrTranslationError translate_inline(translator_t* const translator, const tree_elem_t* const call,
+                                         const func_purity_t* const callee, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(call), "");
+    lassert(!is_invalid_ptr(callee), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    const size_t count_args = callee->count_args;
+    const tree_elem_t** const args = calloc(count_args + 1, sizeof(*args));
+    const tree_elem_t** const params = calloc(count_args + 1, sizeof(*params));
+    size_t* const arg_tmps = calloc(count_args + 1, sizeof(*arg_tmps));
+    if (!args || !params || !arg_tmps)
+    {
+        perror("Can't calloc args");
+        free(args);
+        free(params);
+        free(arg_tmps);
+        return IR_TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    func_args_collect(call->rt, count_args, args);
+    func_args_collect(callee->params, count_args, params);
+
+    // args are computed in the caller's scope, like for real call
+    for (size_t var_ind = 0; var_ind < count_args; ++var_ind)
+    {
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, args[var_ind], out),
+                                    free(args);free(params);free(arg_tmps););
+        arg_tmps[var_ind] = translator->temp_var_num - 1;
+    }
+
+    free(args);
+
+    const inline_saved_t saved = {
+        .vars           = translator->vars,
+        .var_num_base   = translator->var_num_base,
+        .tail_rec       = translator->tail_rec,
+        .memo           = translator->memo,
+        .inl            = translator->inl,
+    };
+
+    inline_t inl = inline_next_(&translator->inl, callee);
+    inl.label_end = USE_LABEL_();
+
+    if (translator->opts.report)
+        fprintf(stderr, "inline: %ls into %ls, %zu nodes, depth %zu\n", 
+                        func_name_(translator, callee), 
+                        func_name_(translator, saved.inl.chain[saved.inl.depth]), 
+                        callee->size, inl.depth);
+
+    STACK_ERROR_HANDLE_(STACK_CTOR(&translator->vars, sizeof(stack_key_t), 1),
+                        translator->vars = saved.vars; free(params); free(arg_tmps););
+
+    translator->var_num_base = inl.res_var + 1;
+    translator->tail_rec     = (tail_rec_t){.is_on = false, .acc_op = OP_TYPE_UNKNOWN};
+    translator->memo         = (memo_t){.is_on = false};
+    translator->inl          = inl;
+
+    IR_TRANSLATION_ERROR_HANDLE(inline_enter_(translator, params, arg_tmps, count_args, out),
+                                inline_leave_(translator, &saved); free(params); free(arg_tmps););
+
+    free(params);
+    free(arg_tmps);
+
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, callee->body, out),
+                                inline_leave_(translator, &saved););
+
+    const bool is_end_jumped = translator->inl.is_end_jumped;
+
+    IR_TRANSLATION_ERROR_HANDLE(inline_leave_(translator, &saved));
+
+    ++translator->inlined_cnt;
+
+    if (is_end_jumped)
+        IR_EMIT_LABEL_(inl.label_end, "end of inlined call");
+    IR_EMIT_ASSIGN_TMP_VAR_(translator->temp_var_num++, inl.res_var, "inlined result");
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+#undef INLINE_SIZE_MAX_
+#undef INLINE_ONCE_SIZE_MAX_
+
+enum IrTranslationError translate_inline_ret(translator_t* const translator,
+                                             const tree_elem_t* const ret, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(ret), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, ret->lt, out));
+    IR_EMIT_ASSIGN_VAR_(translator->inl.res_var, translator->temp_var_num - 1, "inlined return");
+
+    if (!is_tail_ret_(translator->inl.body, ret))
+    {
+        IR_EMIT_JMP_(translator->inl.label_end, "inlined return");
+        translator->inl.is_end_jumped = true;
+    }
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,35 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_INLINE_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_INLINE_H
+
+#include <stdio.h>
+
+#include "utils/src/tree/structs.h"
+#include "translation/structs.h"
+#include "translation/funcs/purity.h"
+#include "translation/verification/verification.h"
+
+// Inlining. Call of small function is replaced with its body: args are assigned to params, and
+// every return assigns result var and jumps to the end of the body. Body is translated in its own
+// var frames, like in the function itself, so its names don't clash with the caller's ones, and
+// its vars are numbered after vars of the caller. Frame of the caller is extended by vars of
+// the deepest inlined calls, they are counted before the body is translated.
+// Recursive function isn't inlined, and function, that is already in the chain of inlined calls,
+// is called, so mutual recursion stops there.
+
+// NULL - call isn't inlined
+const func_purity_t*    inline_callee(const translator_t* const translator,
+                                      const inline_t* const inl, const tree_elem_t* const call);
+
+// first var after vars of calls, that are inlined in body, and of pow chains
+enum IrTranslationError inline_vars_end(const translator_t* const translator,
+                                        const inline_t* const inl, const tree_elem_t* const body,
+                                        long long int* const vars_end);
+
+enum IrTranslationError translate_inline(translator_t* const translator, const tree_elem_t* const call,
+                                         const func_purity_t* const callee, FILE* out);
+
+// return in inlined body, jump to the end is omitted for return at the end of body
+enum IrTranslationError translate_inline_ret(translator_t* const translator,
+                                             const tree_elem_t* const ret, FILE* out);
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_INLINE_H */
\ No newline at end of file
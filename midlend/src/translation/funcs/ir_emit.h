@@ -0,0 +1,124 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_IR_EMIT_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_IR_EMIT_H
+
+// Every IR block is written as text in IR_file, if it is not NULL, and, if translator->bin is not
+// NULL, as a binary record. Must be included after PYAM_IR/include/libpyam_ir.h.
+// Ret tmp is evaluated once, because it is usually translator->temp_var_num++.
+
+#include "pyam_bin.h"
+
+// pyam_bin_* print errors themselves
+#define IR_BIN_PUSH_(push_func_, ...)                                                               \
+    do {                                                                                            \
+        pyam_bin_writer_t* const emit_bin_ = translator->bin;                                       \
+        if (emit_bin_)                                                                              \
+        {                                                                                           \
+            const enum IrTranslationError emit_error_ = push_func_(emit_bin_, __VA_ARGS__);         \
+            if (emit_error_)                                                                        \
+                return emit_error_;                                                                 \
+        }                                                                                           \
+    } while(0)
+
+#define IR_EMIT_GLOBAL_VARS_NUM_(num_)                                                              \
+    do {                                                                                            \
+        if (IR_file) { IR_GLOBAL_VARS_NUM_(num_); }                                                 \
+        IR_BIN_PUSH_(pyam_bin_global_vars, (size_t)(num_));                                         \
+    } while(0)
+
+#define IR_EMIT_CALL_MAIN_(tmp_)                                                                    \
+    do {                                                                                            \
+        const size_t emit_tmp_ = (size_t)(tmp_);                                                    \
+        if (IR_file) { IR_CALL_MAIN_(emit_tmp_); }                                                  \
+        IR_BIN_PUSH_(pyam_bin_call_main, emit_tmp_);                                                \
+    } while(0)
+
+#define IR_EMIT_CALL_FUNC_(tmp_, num_, argc_, comment_)                                             \
+    do {                                                                                            \
+        const size_t emit_tmp_ = (size_t)(tmp_);                                                    \
+        if (IR_file) { IR_CALL_FUNC_(emit_tmp_, num_, argc_, comment_); }                           \
+        IR_BIN_PUSH_(pyam_bin_call_func, emit_tmp_, (size_t)(num_), (size_t)(argc_));               \
+    } while(0)
+
+#define IR_EMIT_FUNCTION_BODY_(num_, argc_, locals_, comment_)                                      \
+    do {                                                                                            \
+        if (IR_file) { IR_FUNCTION_BODY_(num_, argc_, locals_, comment_); }                         \
+        IR_BIN_PUSH_(pyam_bin_function_body, (size_t)(num_), (size_t)(argc_), (size_t)(locals_));   \
+    } while(0)
+
+#define IR_EMIT_MAIN_BODY_(locals_)                                                                 \
+    do {                                                                                            \
+        if (IR_file) { IR_MAIN_BODY_(locals_); }                                                    \
+        IR_BIN_PUSH_(pyam_bin_main_body, (size_t)(locals_));                                        \
+    } while(0)
+
+#define IR_EMIT_SYSCALL_(tmp_, name_, argc_)                                                        \
+    do {                                                                                            \
+        const size_t emit_tmp_ = (size_t)(tmp_);                                                    \
+        if (IR_file) { IR_SYSCALL_(emit_tmp_, name_, argc_); }                                      \
+        IR_BIN_PUSH_(pyam_bin_syscall, emit_tmp_, name_, (size_t)(argc_));                          \
+    } while(0)
+
+#define IR_EMIT_GIVE_ARG_(arg_, tmp_)                                                               \
+    do {                                                                                            \
+        if (IR_file) { IR_GIVE_ARG_(arg_, tmp_); }                                                  \
+        IR_BIN_PUSH_(pyam_bin_give_arg, (size_t)(arg_), (size_t)(tmp_));                            \
+    } while(0)
+
+#define IR_EMIT_TAKE_ARG_(var_, arg_, comment_)                                                     \
+    do {                                                                                            \
+        if (IR_file) { IR_TAKE_ARG_(var_, arg_, comment_); }                                        \
+        IR_BIN_PUSH_(pyam_bin_take_arg, (long long int)(var_), (size_t)(arg_));                     \
+    } while(0)
+
+#define IR_EMIT_ASSIGN_TMP_NUM_(tmp_, num_)                                                         \
+    do {                                                                                            \
+        const size_t emit_tmp_ = (size_t)(tmp_);                                                    \
+        if (IR_file) { IR_ASSIGN_TMP_NUM_(emit_tmp_, num_); }                                       \
+        IR_BIN_PUSH_(pyam_bin_assign_tmp_num, emit_tmp_, (int64_t)(num_));                          \
+    } while(0)
+
+#define IR_EMIT_ASSIGN_TMP_VAR_(tmp_, var_, comment_)                                               \
+    do {                                                                                            \
+        const size_t emit_tmp_ = (size_t)(tmp_);                                                    \
+        if (IR_file) { IR_ASSIGN_TMP_VAR_(emit_tmp_, var_, comment_); }                             \
+        IR_BIN_PUSH_(pyam_bin_assign_tmp_var, emit_tmp_, (long long int)(var_));                    \
+    } while(0)
+
+#define IR_EMIT_ASSIGN_VAR_(var_, tmp_, comment_)                                                   \
+    do {                                                                                            \
+        if (IR_file) { IR_ASSIGN_VAR_(var_, tmp_, comment_); }                                      \
+        IR_BIN_PUSH_(pyam_bin_assign_var, (long long int)(var_), (size_t)(tmp_));                   \
+    } while(0)
+
+#define IR_EMIT_OPERATION_(tmp_, op_, first_, second_)                                              \
+    do {                                                                                            \
+        const size_t emit_tmp_ = (size_t)(tmp_);                                                    \
+        if (IR_file) { IR_OPERATION_(emit_tmp_, op_, first_, second_); }                            \
+        IR_BIN_PUSH_(pyam_bin_operation, emit_tmp_, op_, (size_t)(first_), (size_t)(second_));      \
+    } while(0)
+
+#define IR_EMIT_COND_JMP_(label_, tmp_, comment_)                                                   \
+    do {                                                                                            \
+        if (IR_file) { IR_COND_JMP_(label_, tmp_, comment_); }                                      \
+        IR_BIN_PUSH_(pyam_bin_cond_jmp, (size_t)(label_), (size_t)(tmp_));                          \
+    } while(0)
+
+#define IR_EMIT_JMP_(label_, comment_)                                                              \
+    do {                                                                                            \
+        if (IR_file) { IR_JMP_(label_, comment_); }                                                 \
+        IR_BIN_PUSH_(pyam_bin_jmp, (size_t)(label_));                                               \
+    } while(0)
+
+#define IR_EMIT_LABEL_(label_, comment_)                                                            \
+    do {                                                                                            \
+        if (IR_file) { IR_LABEL_(label_, comment_); }                                               \
+        IR_BIN_PUSH_(pyam_bin_label, (size_t)(label_));                                             \
+    } while(0)
+
+#define IR_EMIT_RET_(tmp_)                                                                          \
+    do {                                                                                            \
+        if (IR_file) { IR_RET_(tmp_); }                                                             \
+        IR_BIN_PUSH_(pyam_bin_ret, (size_t)(tmp_));                                                 \
+    } while(0)
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_IR_EMIT_H */
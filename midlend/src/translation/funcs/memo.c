@@ -0,0 +1,107 @@
+#include <stdbool.h>
+
+#include "utils/utils.h"
+#define IR_file out
+#define NUM_SPECIFER_ "%ld"
+#include "PYAM_IR/include/libpyam_ir.h"
+#include "ir_emit.h"
+#include "translation_lib.h"
+#include "utils/src/memo/structs.h"
+#include "memo.h"
+
+memo_t memo_of_func(const translator_t* const translator, const func_purity_t* const purity,
+                    const size_t count_args, const long long int first_var)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    if (!translator->opts.memo || !purity || !purity->is_memo)
+        return (memo_t){.is_on = false, .first_var = first_var};
+
+    return (memo_t){.is_on = true, .id = purity->memo_id, .count_args = count_args,
+                    .first_var = first_var};
+}
+
+static enum IrTranslationError translate_memo_key_(translator_t* const translator, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    const memo_t* const memo = &translator->memo;
+
+    IR_EMIT_ASSIGN_TMP_NUM_(translator->temp_var_num++, (long)memo->id);
+
+    for (size_t arg_ind = 0; arg_ind < MEMO_ARGS_MAX; ++arg_ind)
+    {
+        if (arg_ind < memo->count_args)
+            IR_EMIT_ASSIGN_TMP_VAR_(translator->temp_var_num++, 
+                                    memo->first_var + (long long int)arg_ind, "memo key");
+        else
+            IR_EMIT_ASSIGN_TMP_NUM_(translator->temp_var_num++, 0l);
+    }
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+enum IrTranslationError translate_memo_get(translator_t* const translator,
+                                           const long long int first_arg_var, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    const memo_t* const memo = &translator->memo;
+    if (!memo->is_on)
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
+    for (size_t arg_ind = 0; arg_ind < memo->count_args; ++arg_ind)
+    {
+        IR_EMIT_ASSIGN_TMP_VAR_(translator->temp_var_num++, first_arg_var + (long long int)arg_ind, 
+                                "memo arg");
+        IR_EMIT_ASSIGN_VAR_(memo->first_var + (long long int)arg_ind, translator->temp_var_num - 1, 
+                            "memo arg");
+    }
+
+    const size_t key_tmp = translator->temp_var_num;
+    IR_TRANSLATION_ERROR_HANDLE(translate_memo_key_(translator, out));
+
+    for (size_t arg_ind = 0; arg_ind < MEMO_GET_ARGS_CNT; ++arg_ind)
+    {
+        IR_EMIT_GIVE_ARG_(arg_ind, key_tmp + arg_ind);
+    }
+    IR_EMIT_SYSCALL_(translator->temp_var_num++, MEMO_GET_NAME, MEMO_GET_ARGS_CNT);
+
+    const size_t label_hit  = USE_LABEL_();
+    const size_t label_miss = USE_LABEL_();
+
+    IR_EMIT_COND_JMP_(label_hit, translator->temp_var_num - 1, "memo hit");
+    IR_EMIT_JMP_(label_miss, "memo miss");
+
+    IR_EMIT_LABEL_(label_hit, "memo hit");
+    IR_EMIT_SYSCALL_(translator->temp_var_num++, MEMO_VAL_NAME, MEMO_VAL_ARGS_CNT);
+    IR_EMIT_RET_(translator->temp_var_num - 1);
+
+    IR_EMIT_LABEL_(label_miss, "memo miss");
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+enum IrTranslationError translate_memo_put(translator_t* const translator, const size_t val_tmp,
+                                           FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    if (!translator->memo.is_on)
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
+    const size_t key_tmp = translator->temp_var_num;
+    IR_TRANSLATION_ERROR_HANDLE(translate_memo_key_(translator, out));
+
+    IR_EMIT_GIVE_ARG_((size_t)0, val_tmp);
+    for (size_t arg_ind = 1; arg_ind < MEMO_PUT_ARGS_CNT; ++arg_ind)
+    {
+        IR_EMIT_GIVE_ARG_(arg_ind, key_tmp + arg_ind - 1);
+    }
+    IR_EMIT_SYSCALL_(translator->temp_var_num++, MEMO_PUT_NAME, MEMO_PUT_ARGS_CNT);
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
\ No newline at end of file
@@ -0,0 +1,27 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_MEMO_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_MEMO_H
+
+#include <stdio.h>
+
+#include "translation/structs.h"
+#include "translation/funcs/purity.h"
+#include "translation/verification/verification.h"
+
+// Memoization. Pure function with several self calls looks for its args in the runtime cache
+// at the start and puts result in it at every return. Args are copied at the start: result of
+// tail recursive function is cached for the args it was called with, not for the last ones.
+
+// is_on - memo is enabled and purity of function allows it, copies of args start at first_var.
+// Without memo count_args is 0, there are no copies
+memo_t memo_of_func(const translator_t* const translator, const func_purity_t* const purity,
+                    const size_t count_args, const long long int first_var);
+
+// after args are taken, hit returns cached result. Nothing without memo
+enum IrTranslationError translate_memo_get(translator_t* const translator,
+                                           const long long int first_arg_var, FILE* out);
+
+// tmp with res = val, that is cached. Nothing without memo
+enum IrTranslationError translate_memo_put(translator_t* const translator, const size_t val_tmp,
+                                           FILE* out);
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_MEMO_H */
\ No newline at end of file
@@ -0,0 +1,223 @@
+#include <stdbool.h>
+
+#include "utils/utils.h"
+#define IR_file out
+#define NUM_SPECIFER_ "%ld"
+#include "PYAM_IR/include/libpyam_ir.h"
+#include "ir_emit.h"
+#include "translation_lib.h"
+#include "pow_chain.h"
+
+typedef struct PowChainSearch
+{
+    uint64_t exp;
+    size_t muls_cnt;
+    uint64_t vals[POW_CHAIN_MULS_MAX + 1];   // exponents of elements
+    pow_chain_t* chain;
+} pow_chain_search_t;
+
+// Iterative deepening: chains of muls_cnt steps are tried for growing muls_cnt. Elements of the
+// chain grow, so the last one doubled on every left step has to reach exp.
+static bool search_(pow_chain_search_t* const search, const size_t step)
+{
+    lassert(!is_invalid_ptr(search), "");
+
+    const uint64_t last = search->vals[step];
+
+    if (last == search->exp)
+        return true;
+    if (step == search->muls_cnt || (last << (search->muls_cnt - step)) < search->exp)
+        return false;
+
+    // bigger sums first, they reach exp faster
+    for (size_t lt = step + 1; lt-- > 0;)
+    {
+        for (size_t rt = lt + 1; rt-- > 0;)
+        {
+            const uint64_t sum = search->vals[lt] + search->vals[rt];
+
+            if (sum <= last)
+                break;
+            if (sum > search->exp)
+                continue;
+
+            search->vals[step + 1] = sum;
+            search->chain->steps[step] = (pow_chain_step_t){.lt = lt, .rt = rt};
+
+            if (search_(search, step + 1))
+                return true;
+        }
+    }
+
+    return false;
+}
+
+// square for every bit after the highest one, multiply by x for set bits
+static bool build_binary_(const uint64_t exp, pow_chain_t* const chain)
+{
+    lassert(!is_invalid_ptr(chain), "");
+
+    size_t high_bit = 63;
+    while (!(exp >> high_bit))
+        --high_bit;
+
+    chain->muls_cnt = 0;
+    for (size_t bit = high_bit; bit-- > 0;)
+    {
+        if (chain->muls_cnt + 1 + ((exp >> bit) & 1) > POW_CHAIN_MULS_MAX)
+            return false;
+
+        const size_t last = chain->muls_cnt;
+        chain->steps[chain->muls_cnt++] = (pow_chain_step_t){.lt = last, .rt = last};
+
+        if ((exp >> bit) & 1)
+            chain->steps[chain->muls_cnt++] = (pow_chain_step_t){.lt = last + 1, .rt = 0};
+    }
+
+    return true;
+}
+
+bool pow_chain_build(const uint64_t exp, pow_chain_t* const chain)
+{
+    lassert(!is_invalid_ptr(chain), "");
+
+    if (!exp)
+        return false;
+
+    if (exp > POW_CHAIN_SEARCH_MAX)
+        return build_binary_(exp, chain);
+
+    pow_chain_search_t search = {.exp = exp, .vals = {1}, .chain = chain};
+
+    for (; search.muls_cnt <= POW_CHAIN_MULS_MAX; ++search.muls_cnt)
+    {
+        if (search_(&search, 0))
+        {
+            chain->muls_cnt = search.muls_cnt;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool is_pow_chain(const tree_elem_t* const exp, pow_chain_t* const chain)
+{
+    lassert(!is_invalid_ptr(exp), "");
+    lassert(!is_invalid_ptr(chain), "");
+
+    if (exp->lexem.type != LEXEM_TYPE_NUM)
+        return false;
+
+    *chain = (pow_chain_t){};
+
+    return exp->lexem.data.num == 0 || pow_chain_build((uint64_t)exp->lexem.data.num, chain);
+}
+
+// Elements of the chain are kept in vars after free_var, because every tmp is used once. Element,
+// that is used only by the next step, stays in its tmp. Result is the last tmp.
+static enum IrTranslationError translate_chain_(translator_t* const translator,
+                                                const long long int base_var, const num_t exp,
+                                                const pow_chain_t* const chain, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(chain), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    if (exp == 0)
+    {
+        IR_EMIT_ASSIGN_TMP_NUM_(translator->temp_var_num++, 1);
+        return IR_TRANSLATION_ERROR_SUCCESS;
+    }
+
+    const size_t elems_cnt = chain->muls_cnt + 1;
+
+    size_t uses_cnt[POW_CHAIN_MULS_MAX + 1] = {};
+    for (size_t step = 0; step < chain->muls_cnt; ++step)
+    {
+        ++uses_cnt[chain->steps[step].lt];
+        ++uses_cnt[chain->steps[step].rt];
+    }
+
+    long long int elem_vars[POW_CHAIN_MULS_MAX + 1] = {base_var};
+    bool is_in_tmp[POW_CHAIN_MULS_MAX + 1] = {};
+
+    long long int free_var = translator->inl.free_var + (base_var == translator->inl.free_var);
+    for (size_t elem = 1; elem < elems_cnt; ++elem)
+    {
+        // step elem makes element elem + 1
+        is_in_tmp[elem] = elem + 1 == elems_cnt
+                       || (uses_cnt[elem] == 1 && (chain->steps[elem].lt == elem
+                                                || chain->steps[elem].rt == elem));
+        if (!is_in_tmp[elem])
+            elem_vars[elem] = free_var++;
+    }
+
+    if (chain->muls_cnt == 0)
+        IR_EMIT_ASSIGN_TMP_VAR_(translator->temp_var_num++, base_var, "pow base");
+
+    for (size_t step = 0; step < chain->muls_cnt; ++step)
+    {
+        const pow_chain_step_t mul = chain->steps[step];
+
+        // mul is commutative, so element in tmp is the first operand
+        size_t first_op = translator->temp_var_num - 1;
+        size_t loaded = mul.rt;
+
+        if (is_in_tmp[mul.rt])
+        {
+            loaded = mul.lt;
+        }
+        else if (!is_in_tmp[mul.lt])
+        {
+            IR_EMIT_ASSIGN_TMP_VAR_(translator->temp_var_num++, elem_vars[mul.lt], "pow element");
+            first_op = translator->temp_var_num - 1;
+        }
+
+        IR_EMIT_ASSIGN_TMP_VAR_(translator->temp_var_num++, elem_vars[loaded], "pow element");
+        const size_t second_op = translator->temp_var_num - 1;
+
+        IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_MUL, first_op, second_op);
+
+        if (!is_in_tmp[step + 1])
+            IR_EMIT_ASSIGN_VAR_(elem_vars[step + 1], translator->temp_var_num - 1, "pow element");
+    }
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+enum IrTranslationError translate_pow_const(translator_t* const translator, const tree_elem_t* const elem,
+                                            FILE* out, bool* const is_translated)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+    lassert(!is_invalid_ptr(is_translated), "");
+
+    pow_chain_t chain = {};
+    if (!is_pow_chain(elem->rt, &chain))
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
+    long long int base_var = translator->inl.free_var;
+
+    if (elem->lt->lexem.type == LEXEM_TYPE_VAR)
+    {
+        CHECK_DECLD_VAR_(base_var, elem->lt);
+    }
+    else
+    {
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
+        IR_EMIT_ASSIGN_VAR_(base_var, translator->temp_var_num - 1, "pow base");
+    }
+
+    IR_TRANSLATION_ERROR_HANDLE(translate_chain_(translator, base_var, elem->rt->lexem.data.num,
+                                                 &chain, out));
+
+    // x ^= exp, x is var
+    if (elem->lexem.data.op == OP_TYPE_POW_ASSIGNMENT)
+        IR_EMIT_ASSIGN_VAR_(base_var, translator->temp_var_num - 1, "");
+
+    *is_translated = true;
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
\ No newline at end of file
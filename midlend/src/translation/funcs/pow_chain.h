@@ -0,0 +1,42 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_POW_CHAIN_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_POW_CHAIN_H
+
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#include "utils/src/tree/structs.h"
+#include "translation/structs.h"
+#include "translation/verification/verification.h"
+
+// x ^ exp with constant exp is a chain of muls: element 0 is x, every step multiplies two
+// elements before it and appends the product, the last one is the result.
+// Chains are optimal up to POW_CHAIN_SEARCH_MAX, longer exponents are lowered by binary method.
+
+#define POW_CHAIN_MULS_MAX      (12)    // longer chains are left for runtime pow
+#define POW_CHAIN_SEARCH_MAX    (256)
+
+typedef struct PowChainStep
+{
+    size_t lt;
+    size_t rt;
+} pow_chain_step_t;
+
+typedef struct PowChain
+{
+    size_t muls_cnt;
+    pow_chain_step_t steps[POW_CHAIN_MULS_MAX];
+} pow_chain_t;
+
+// false - exp is 0 or chain is longer than POW_CHAIN_MULS_MAX
+bool pow_chain_build(const uint64_t exp, pow_chain_t* const chain);
+
+// exp of pow is constant, that is lowered to chain of muls (empty one for 0)
+bool is_pow_chain(const tree_elem_t* const exp, pow_chain_t* const chain);
+
+// x ^ exp and x ^= exp, is_translated - exp is lowered to chain
+enum IrTranslationError translate_pow_const(translator_t* const translator, const tree_elem_t* const elem,
+                                            FILE* out, bool* const is_translated);
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_POW_CHAIN_H */
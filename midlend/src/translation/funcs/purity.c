@@ -0,0 +1,256 @@
+#include <stdio.h>
+#include <stdint.h>
+
+#include "utils/utils.h"
+#include "utils/src/tree/funcs/funcs.h"
+#include "utils/src/memo/structs.h"
+#include "purity.h"
+
+#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
+    do {                                                                                            \
+        const enum StackError stack_error_handler = call_func;                                      \
+        if (stack_error_handler)                                                                    \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Stack error: %s\n",                               \
+                            stack_strerror(stack_error_handler));                                   \
+            __VA_ARGS__                                                                             \
+            return IR_TRANSLATION_ERROR_STACK;                                                      \
+        }                                                                                           \
+    } while(0)
+
+#define NO_FUNC_ SIZE_MAX
+
+#define FUNCS_BEGIN_CAPACITY_ 16
+enum IrTranslationError purity_ctor(purity_t* const purity)
+{
+    lassert(!is_invalid_ptr(purity), "");
+
+    STACK_ERROR_HANDLE_(STACK_CTOR(&purity->funcs, sizeof(func_purity_t), FUNCS_BEGIN_CAPACITY_));
+    purity->memo_cnt = 0;
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+#undef FUNCS_BEGIN_CAPACITY_
+
+void purity_dtor(purity_t* const purity)
+{
+    lassert(!is_invalid_ptr(purity), "");
+
+    stack_dtor(&purity->funcs);
+
+    IF_DEBUG(purity->memo_cnt = 0;)
+}
+
+size_t func_args_cnt(const tree_elem_t* args)
+{
+    size_t count_args = (args != NULL);
+
+    for (; args != NULL; args = args->lt)
+    {
+        count_args += (args->lexem.type    == LEXEM_TYPE_OP
+                    && args->lexem.data.op == OP_TYPE_ARGS_COMMA);
+    }
+
+    return count_args;
+}
+
+void func_args_collect(const tree_elem_t* args, const size_t count_args, const tree_elem_t** const arr)
+{
+    lassert(!is_invalid_ptr(arr), "");
+
+    if (count_args == 0)
+        return;
+
+    for (size_t var_ind = count_args; var_ind > 1; --var_ind, args = args->lt)
+    {
+        arr[var_ind - 1] = args->rt;
+    }
+    arr[0] = args;
+}
+
+static bool is_op_(const tree_elem_t* const elem, const enum OpType op)
+{
+    return elem && elem->lexem.type == LEXEM_TYPE_OP && elem->lexem.data.op == op;
+}
+
+static size_t find_ind_(const purity_t* const purity, const size_t num, const size_t count_args)
+{
+    lassert(!is_invalid_ptr(purity), "");
+
+    for (size_t func_ind = 0; func_ind < stack_size(purity->funcs); ++func_ind)
+    {
+        const func_purity_t* const func = stack_get(purity->funcs, func_ind);
+        if (func->num == num && func->count_args == count_args)
+            return func_ind;
+    }
+
+    return NO_FUNC_;
+}
+
+const func_purity_t* purity_find(const purity_t* const purity, const size_t num,
+                                 const size_t count_args)
+{
+    lassert(!is_invalid_ptr(purity), "");
+
+    const size_t func_ind = find_ind_(purity, num, count_args);
+
+    return func_ind == NO_FUNC_ ? NULL : stack_get(purity->funcs, func_ind);
+}
+
+static enum TreeError collect_func_(const tree_elem_t* elem, void* const purity)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(purity), "");
+
+    if (!is_op_(elem, OP_TYPE_FUNC))
+        return TREE_ERROR_SUCCESS;
+
+    const func_purity_t func = {
+        .num        = elem->lt->lt->lexem.data.var,
+        .count_args = func_args_cnt(elem->lt->rt),
+        .locals_cnt = (size_t)elem->lt->lexem.data.num,
+        .params     = elem->lt->rt,
+        .body       = elem->rt,
+        .is_pure    = true,
+    };
+
+    return stack_push(&((purity_t*)purity)->funcs, &func) ? TREE_ERROR_STACK : TREE_ERROR_SUCCESS;
+}
+
+// callee NO_FUNC_ - function isn't declared
+typedef struct CallEdge
+{
+    size_t caller;
+    size_t callee;
+} call_edge_t;
+
+typedef struct BodyScan
+{
+    purity_t* purity;
+    size_t func_ind;
+    stack_key_t* calls;
+} body_scan_t;
+
+static enum TreeError scan_body_(const tree_elem_t* elem, void* const arg)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(arg), "");
+
+    body_scan_t* const scan = arg;
+    func_purity_t* const func = stack_get(scan->purity->funcs, scan->func_ind);
+
+    ++func->size;
+
+    if (is_op_(elem, OP_TYPE_IN) || is_op_(elem, OP_TYPE_OUT))
+        func->is_pure = false;
+
+    if (!is_op_(elem, OP_TYPE_FUNC_LBRAKET))
+        return TREE_ERROR_SUCCESS;
+
+    const call_edge_t call = {
+        .caller = scan->func_ind,
+        .callee = find_ind_(scan->purity, elem->lt->lexem.data.var, func_args_cnt(elem->rt))
+    };
+
+    if (call.callee == call.caller)
+    {
+        ++func->self_calls_cnt;
+        return TREE_ERROR_SUCCESS;
+    }
+
+    return stack_push(scan->calls, &call) ? TREE_ERROR_STACK : TREE_ERROR_SUCCESS;
+}
+
+static enum TreeError count_call_site_(const tree_elem_t* elem, void* const purity)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(purity), "");
+
+    if (!is_op_(elem, OP_TYPE_FUNC_LBRAKET))
+        return TREE_ERROR_SUCCESS;
+
+    const size_t callee = find_ind_(purity, elem->lt->lexem.data.var, func_args_cnt(elem->rt));
+    if (callee != NO_FUNC_)
+        ++((func_purity_t*)stack_get(((purity_t*)purity)->funcs, callee))->call_sites_cnt;
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static void spread_impurity_(purity_t* const purity, const stack_key_t calls)
+{
+    lassert(!is_invalid_ptr(purity), "");
+
+    for (bool is_changed = true; is_changed;)
+    {
+        is_changed = false;
+
+        for (size_t call_ind = 0; call_ind < stack_size(calls); ++call_ind)
+        {
+            const call_edge_t* const call = stack_get(calls, call_ind);
+            func_purity_t* const caller = stack_get(purity->funcs, call->caller);
+
+            const bool is_callee_pure = call->callee != NO_FUNC_
+                && ((const func_purity_t*)stack_get(purity->funcs, call->callee))->is_pure;
+
+            if (caller->is_pure && !is_callee_pure)
+            {
+                caller->is_pure = false;
+                is_changed = true;
+            }
+        }
+    }
+}
+
+#define CALLS_BEGIN_CAPACITY_ 32
+enum IrTranslationError purity_analyze(purity_t* const purity, const tree_elem_t* const root)
+{
+    lassert(!is_invalid_ptr(purity), "");
+
+    if (tree_walk_pre(root, collect_func_, purity))
+    {
+        fprintf(stderr, "Can't walk tree for funcs\n");
+        return IR_TRANSLATION_ERROR_STACK;
+    }
+
+    // main is walked too
+    if (tree_walk_pre(root, count_call_site_, purity))
+    {
+        fprintf(stderr, "Can't walk tree for call sites\n");
+        return IR_TRANSLATION_ERROR_STACK;
+    }
+
+    stack_key_t calls = 0;
+    STACK_ERROR_HANDLE_(STACK_CTOR(&calls, sizeof(call_edge_t), CALLS_BEGIN_CAPACITY_));
+
+    for (size_t func_ind = 0; func_ind < stack_size(purity->funcs); ++func_ind)
+    {
+        const func_purity_t* const func = stack_get(purity->funcs, func_ind);
+        body_scan_t scan = {.purity = purity, .func_ind = func_ind, .calls = &calls};
+
+        if (func->body && tree_walk_pre(func->body, scan_body_, &scan))
+        {
+            fprintf(stderr, "Can't walk function body for calls\n");
+            stack_dtor(&calls);
+            return IR_TRANSLATION_ERROR_STACK;
+        }
+    }
+
+    spread_impurity_(purity, calls);
+
+    stack_dtor(&calls);
+
+    // with one self call every subproblem is solved once anyway, cache pays off only with more
+    for (size_t func_ind = 0; func_ind < stack_size(purity->funcs); ++func_ind)
+    {
+        func_purity_t* const func = stack_get(purity->funcs, func_ind);
+
+        func->is_memo = func->is_pure && func->self_calls_cnt > 1
+                     && func->count_args > 0 && func->count_args <= MEMO_ARGS_MAX;
+
+        if (func->is_memo)
+            func->memo_id = purity->memo_cnt++;
+    }
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+#undef CALLS_BEGIN_CAPACITY_
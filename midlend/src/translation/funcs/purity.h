@@ -0,0 +1,54 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_PURITY_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_PURITY_H
+
+#include <stdbool.h>
+
+#include "stack_on_array/libstack.h"
+#include "utils/src/tree/structs.h"
+#include "translation/verification/verification.h"
+
+// Pure function doesn't do in and out and calls only pure functions.
+// There are no global vars, so its result depends only on args.
+// Sizes and calls of function are collected on the same walk, inliner uses them.
+typedef struct FuncPurity
+{
+    size_t num;
+    size_t count_args;
+    size_t locals_cnt;
+    const tree_elem_t* params;
+    const tree_elem_t* body;
+    size_t size;                // nodes of body
+
+    bool is_pure;
+    size_t self_calls_cnt;
+    size_t call_sites_cnt;      // in the whole program
+
+    bool is_memo;               // results are cached
+    size_t memo_id;
+} func_purity_t;
+
+typedef struct Purity
+{
+    stack_key_t funcs;
+    size_t memo_cnt;
+} purity_t;
+
+enum IrTranslationError purity_ctor(purity_t* const purity);
+void                    purity_dtor(purity_t* const purity);
+
+// funcs of the tree are collected, then impurity is spread from callees to callers.
+// is_memo is set without regard to opts, caller checks them
+enum IrTranslationError purity_analyze(purity_t* const purity, const tree_elem_t* const root);
+
+// NULL - function wasn't analyzed
+const func_purity_t*    purity_find(const purity_t* const purity, const size_t num,
+                                    const size_t count_args);
+
+// args chain of function or call
+size_t func_args_cnt(const tree_elem_t* args);
+
+// arr[i] - i-th arg of call or param of function, args chain is left-deep, its top is the last arg
+void   func_args_collect(const tree_elem_t* args, const size_t count_args,
+                         const tree_elem_t** const arr);
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_PURITY_H */
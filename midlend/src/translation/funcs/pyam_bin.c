@@ -0,0 +1,344 @@
+#include <string.h>
+
+#include "utils/utils.h"
+#include "pyam_bin.h"
+
+#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
+    do {                                                                                            \
+        const enum StackError stack_error_handler = call_func;                                      \
+        if (stack_error_handler)                                                                    \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Stack error: %s\n",                               \
+                            stack_strerror(stack_error_handler));                                   \
+            __VA_ARGS__                                                                             \
+            return IR_TRANSLATION_ERROR_STACK;                                                      \
+        }                                                                                           \
+    } while(0)
+
+#define RECORDS_BEGIN_CAPACITY_ 1024
+#define STRINGS_BEGIN_CAPACITY_ 1024
+enum IrTranslationError pyam_bin_writer_ctor(pyam_bin_writer_t* const writer)
+{
+    lassert(!is_invalid_ptr(writer), "");
+
+    STACK_ERROR_HANDLE_(STACK_CTOR(&writer->records, sizeof(pyam_bin_record_t), RECORDS_BEGIN_CAPACITY_));
+    STACK_ERROR_HANDLE_(STACK_CTOR(&writer->strings, sizeof(char), STRINGS_BEGIN_CAPACITY_),
+                        stack_dtor(&writer->records);
+    );
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+#undef STRINGS_BEGIN_CAPACITY_
+#undef RECORDS_BEGIN_CAPACITY_
+
+void pyam_bin_writer_dtor(pyam_bin_writer_t* const writer)
+{
+    lassert(!is_invalid_ptr(writer), "");
+
+    stack_dtor(&writer->records);
+    stack_dtor(&writer->strings);
+}
+
+static enum IrTranslationError push_(pyam_bin_writer_t* const writer, pyam_bin_record_t record,
+                                     const char* const label)
+{
+    lassert(!is_invalid_ptr(writer), "");
+
+    record.label_offset = PYAM_BIN_NO_LABEL;
+
+    if (label)
+    {
+        record.label_offset = (uint32_t)stack_size(writer->strings);
+
+        const size_t label_size = strlen(label) + 1;
+        for (size_t sym_ind = 0; sym_ind < label_size; ++sym_ind)
+        {
+            STACK_ERROR_HANDLE_(stack_push(&writer->strings, label + sym_ind));
+        }
+    }
+
+    STACK_ERROR_HANDLE_(stack_push(&writer->records, &record));
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+#define MAX_LABEL_SIZE_ 128
+#define SNPRINTF_LABEL_(label_, ...)                                                                \
+    do {                                                                                            \
+        if (snprintf(label_, MAX_LABEL_SIZE_, __VA_ARGS__) <= 0)                                    \
+        {                                                                                           \
+            perror("Can't snprintf " #label_);                                                      \
+            return IR_TRANSLATION_ERROR_STANDARD_ERRNO;                                             \
+        }                                                                                           \
+    } while(0)
+
+// names are the same as PYAM_IR text has
+#define FUNC_NAME_FORMAT_  "func_%zu_%zu"
+#define LABEL_FORMAT_      "label%zu"
+#define MAIN_NAME_         "main"
+
+enum IrTranslationError pyam_bin_global_vars(pyam_bin_writer_t* const writer, const size_t vars_cnt)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_GLOBAL_VARS,
+        .operand1_type = IR_OPERAND_TYPE_NUM, .operand1_num = vars_cnt
+    };
+
+    return push_(writer, record, NULL);
+}
+
+enum IrTranslationError pyam_bin_call_main(pyam_bin_writer_t* const writer, const size_t tmp)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_CALL_FUNCTION,
+        .ret_type = IR_OPERAND_TYPE_TMP, .ret_num = tmp,
+        .label_type = IR_OPERAND_TYPE_LABEL
+    };
+
+    return push_(writer, record, MAIN_NAME_);
+}
+
+enum IrTranslationError pyam_bin_call_func(pyam_bin_writer_t* const writer, const size_t tmp,
+                                           const size_t func_num, const size_t args_cnt)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_CALL_FUNCTION,
+        .ret_type = IR_OPERAND_TYPE_TMP, .ret_num = tmp,
+        .label_type = IR_OPERAND_TYPE_LABEL
+    };
+
+    char label[MAX_LABEL_SIZE_] = {};
+    SNPRINTF_LABEL_(label, FUNC_NAME_FORMAT_, func_num, args_cnt);
+
+    return push_(writer, record, label);
+}
+
+enum IrTranslationError pyam_bin_main_body(pyam_bin_writer_t* const writer, const size_t locals_cnt)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_FUNCTION_BODY,
+        .label_type = IR_OPERAND_TYPE_LABEL,
+        .operand1_type = IR_OPERAND_TYPE_NUM, .operand1_num = 0,
+        .operand2_type = IR_OPERAND_TYPE_NUM, .operand2_num = locals_cnt
+    };
+
+    return push_(writer, record, MAIN_NAME_);
+}
+
+enum IrTranslationError pyam_bin_function_body(pyam_bin_writer_t* const writer, const size_t func_num,
+                                               const size_t args_cnt, const size_t locals_cnt)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_FUNCTION_BODY,
+        .label_type = IR_OPERAND_TYPE_LABEL,
+        .operand1_type = IR_OPERAND_TYPE_NUM, .operand1_num = args_cnt,
+        .operand2_type = IR_OPERAND_TYPE_NUM, .operand2_num = locals_cnt
+    };
+
+    char label[MAX_LABEL_SIZE_] = {};
+    SNPRINTF_LABEL_(label, FUNC_NAME_FORMAT_, func_num, args_cnt);
+
+    return push_(writer, record, label);
+}
+
+enum IrTranslationError pyam_bin_syscall(pyam_bin_writer_t* const writer, const size_t tmp,
+                                         const char* const name, const size_t args_cnt)
+{
+    lassert(!is_invalid_ptr(name), "");
+
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_SYSCALL,
+        .ret_type = IR_OPERAND_TYPE_TMP, .ret_num = tmp,
+        .label_type = IR_OPERAND_TYPE_LABEL,
+        .operand1_type = IR_OPERAND_TYPE_NUM, .operand1_num = args_cnt,
+        .operand2_type = IR_OPERAND_TYPE_NUM
+    };
+
+    return push_(writer, record, name);
+}
+
+enum IrTranslationError pyam_bin_give_arg(pyam_bin_writer_t* const writer, const size_t arg,
+                                          const size_t tmp)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_ASSIGNMENT,
+        .ret_type = IR_OPERAND_TYPE_ARG, .ret_num = arg,
+        .operand1_type = IR_OPERAND_TYPE_TMP, .operand1_num = tmp
+    };
+
+    return push_(writer, record, NULL);
+}
+
+enum IrTranslationError pyam_bin_take_arg(pyam_bin_writer_t* const writer, const long long int var,
+                                          const size_t arg)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_ASSIGNMENT,
+        .ret_type = IR_OPERAND_TYPE_VAR, .ret_num = (uint64_t)var,
+        .operand1_type = IR_OPERAND_TYPE_ARG, .operand1_num = arg
+    };
+
+    return push_(writer, record, NULL);
+}
+
+enum IrTranslationError pyam_bin_assign_tmp_num(pyam_bin_writer_t* const writer, const size_t tmp,
+                                                const int64_t num)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_ASSIGNMENT,
+        .ret_type = IR_OPERAND_TYPE_TMP, .ret_num = tmp,
+        .operand1_type = IR_OPERAND_TYPE_NUM, .operand1_num = (uint64_t)num
+    };
+
+    return push_(writer, record, NULL);
+}
+
+enum IrTranslationError pyam_bin_assign_tmp_var(pyam_bin_writer_t* const writer, const size_t tmp,
+                                                const long long int var)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_ASSIGNMENT,
+        .ret_type = IR_OPERAND_TYPE_TMP, .ret_num = tmp,
+        .operand1_type = IR_OPERAND_TYPE_VAR, .operand1_num = (uint64_t)var
+    };
+
+    return push_(writer, record, NULL);
+}
+
+enum IrTranslationError pyam_bin_assign_var(pyam_bin_writer_t* const writer, const long long int var,
+                                            const size_t tmp)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_ASSIGNMENT,
+        .ret_type = IR_OPERAND_TYPE_VAR, .ret_num = (uint64_t)var,
+        .operand1_type = IR_OPERAND_TYPE_TMP, .operand1_num = tmp
+    };
+
+    return push_(writer, record, NULL);
+}
+
+enum IrTranslationError pyam_bin_operation(pyam_bin_writer_t* const writer, const size_t tmp,
+                                           const enum IrOpType op,
+                                           const size_t first_tmp, const size_t second_tmp)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_OPERATION,
+        .ret_type = IR_OPERAND_TYPE_TMP, .ret_num = tmp,
+        .operation_type = IR_OPERAND_TYPE_OPERATION, .operation_num = (uint32_t)op,
+        .operand1_type = IR_OPERAND_TYPE_TMP, .operand1_num = first_tmp,
+        .operand2_type = IR_OPERAND_TYPE_TMP, .operand2_num = second_tmp
+    };
+
+    return push_(writer, record, NULL);
+}
+
+enum IrTranslationError pyam_bin_cond_jmp(pyam_bin_writer_t* const writer, const size_t label,
+                                          const size_t tmp)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_COND_JUMP,
+        .label_type = IR_OPERAND_TYPE_LABEL,
+        .operand1_type = IR_OPERAND_TYPE_TMP, .operand1_num = tmp
+    };
+
+    char label_str[MAX_LABEL_SIZE_] = {};
+    SNPRINTF_LABEL_(label_str, LABEL_FORMAT_, label);
+
+    return push_(writer, record, label_str);
+}
+
+enum IrTranslationError pyam_bin_jmp(pyam_bin_writer_t* const writer, const size_t label)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_COND_JUMP,
+        .label_type = IR_OPERAND_TYPE_LABEL,
+        .operand1_type = IR_OPERAND_TYPE_NUM, .operand1_num = 1
+    };
+
+    char label_str[MAX_LABEL_SIZE_] = {};
+    SNPRINTF_LABEL_(label_str, LABEL_FORMAT_, label);
+
+    return push_(writer, record, label_str);
+}
+
+enum IrTranslationError pyam_bin_label(pyam_bin_writer_t* const writer, const size_t label)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_LABEL,
+        .label_type = IR_OPERAND_TYPE_LABEL
+    };
+
+    char label_str[MAX_LABEL_SIZE_] = {};
+    SNPRINTF_LABEL_(label_str, LABEL_FORMAT_, label);
+
+    return push_(writer, record, label_str);
+}
+
+enum IrTranslationError pyam_bin_ret(pyam_bin_writer_t* const writer, const size_t tmp)
+{
+    const pyam_bin_record_t record = {
+        .type = IR_OP_BLOCK_TYPE_RETURN,
+        .ret_type = IR_OPERAND_TYPE_TMP, .ret_num = tmp
+    };
+
+    return push_(writer, record, NULL);
+}
+
+#undef MAIN_NAME_
+#undef LABEL_FORMAT_
+#undef FUNC_NAME_FORMAT_
+#undef SNPRINTF_LABEL_
+#undef MAX_LABEL_SIZE_
+
+enum IrTranslationError pyam_bin_write(const pyam_bin_writer_t* const writer, FILE* out)
+{
+    lassert(!is_invalid_ptr(writer), "");
+    lassert(!is_invalid_ptr(out), "");
+
+    const size_t records_cnt  = stack_size(writer->records);
+    const size_t strings_size = stack_size(writer->strings);
+
+    const pyam_bin_header_t header = {
+        .magic          = PYAM_BIN_MAGIC,
+        .version        = PYAM_BIN_VERSION,
+        .record_size    = sizeof(pyam_bin_record_t),
+        .records_offset = sizeof(pyam_bin_header_t),
+        .records_cnt    = records_cnt,
+        .strings_offset = sizeof(pyam_bin_header_t) + records_cnt * sizeof(pyam_bin_record_t),
+        .strings_size   = strings_size
+    };
+
+    if (fwrite(&header, sizeof(header), 1, out) != 1)
+    {
+        perror("Can't fwrite binary IR header");
+        return IR_TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    if (records_cnt
+        && fwrite(stack_begin(writer->records), sizeof(pyam_bin_record_t), records_cnt, out) != records_cnt)
+    {
+        perror("Can't fwrite binary IR records");
+        return IR_TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    if (strings_size
+        && fwrite(stack_begin(writer->strings), sizeof(char), strings_size, out) != strings_size)
+    {
+        perror("Can't fwrite binary IR strings");
+        return IR_TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+pyam_bin_view_t pyam_bin_view(const pyam_bin_writer_t* const writer)
+{
+    lassert(!is_invalid_ptr(writer), "");
+
+    return (pyam_bin_view_t){
+        .records      = (const pyam_bin_record_t*)stack_begin(writer->records),
+        .records_cnt  = stack_size(writer->records),
+        .strings      = (const char*)stack_begin(writer->strings),
+        .strings_size = stack_size(writer->strings)
+    };
+}
@@ -0,0 +1,54 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_PYAM_BIN_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_PYAM_BIN_H
+
+#include <stdio.h>
+
+#include "stack_on_array/libstack.h"
+#include "PYAM_IR/include/libpyam_ir.h"
+#include "utils/src/pyam_bin/structs.h"
+#include "translation/verification/verification.h"
+
+typedef struct PyamBinWriter
+{
+    stack_key_t records;
+    stack_key_t strings;
+} pyam_bin_writer_t;
+
+enum IrTranslationError pyam_bin_writer_ctor(pyam_bin_writer_t* const writer);
+void                    pyam_bin_writer_dtor(pyam_bin_writer_t* const writer);
+
+// one function per IR block, records are the same as the text IR_*_ macros write
+enum IrTranslationError pyam_bin_global_vars   (pyam_bin_writer_t* const writer, const size_t vars_cnt);
+enum IrTranslationError pyam_bin_call_main     (pyam_bin_writer_t* const writer, const size_t tmp);
+enum IrTranslationError pyam_bin_call_func     (pyam_bin_writer_t* const writer, const size_t tmp,
+                                                const size_t func_num, const size_t args_cnt);
+enum IrTranslationError pyam_bin_main_body     (pyam_bin_writer_t* const writer, const size_t locals_cnt);
+enum IrTranslationError pyam_bin_function_body (pyam_bin_writer_t* const writer, const size_t func_num,
+                                                const size_t args_cnt, const size_t locals_cnt);
+enum IrTranslationError pyam_bin_syscall       (pyam_bin_writer_t* const writer, const size_t tmp,
+                                                const char* const name, const size_t args_cnt);
+enum IrTranslationError pyam_bin_give_arg      (pyam_bin_writer_t* const writer, const size_t arg,
+                                                const size_t tmp);
+enum IrTranslationError pyam_bin_take_arg      (pyam_bin_writer_t* const writer, const long long int var,
+                                                const size_t arg);
+enum IrTranslationError pyam_bin_assign_tmp_num(pyam_bin_writer_t* const writer, const size_t tmp,
+                                                const int64_t num);
+enum IrTranslationError pyam_bin_assign_tmp_var(pyam_bin_writer_t* const writer, const size_t tmp,
+                                                const long long int var);
+enum IrTranslationError pyam_bin_assign_var    (pyam_bin_writer_t* const writer, const long long int var,
+                                                const size_t tmp);
+enum IrTranslationError pyam_bin_operation     (pyam_bin_writer_t* const writer, const size_t tmp,
+                                                const enum IrOpType op,
+                                                const size_t first_tmp, const size_t second_tmp);
+enum IrTranslationError pyam_bin_cond_jmp      (pyam_bin_writer_t* const writer, const size_t label,
+                                                const size_t tmp);
+enum IrTranslationError pyam_bin_jmp           (pyam_bin_writer_t* const writer, const size_t label);
+enum IrTranslationError pyam_bin_label         (pyam_bin_writer_t* const writer, const size_t label);
+enum IrTranslationError pyam_bin_ret           (pyam_bin_writer_t* const writer, const size_t tmp);
+
+enum IrTranslationError pyam_bin_write(const pyam_bin_writer_t* const writer, FILE* out);
+
+// records without copying, valid until the next push
+pyam_bin_view_t         pyam_bin_view (const pyam_bin_writer_t* const writer);
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_PYAM_BIN_H */
@@ -0,0 +1,243 @@
+#include <stdbool.h>
+
+#include "utils/utils.h"
+#include "utils/src/tree/funcs/funcs.h"
+#define IR_file out
+#define NUM_SPECIFER_ "%ld"
+#include "PYAM_IR/include/libpyam_ir.h"
+#include "ir_emit.h"
+#include "translation_lib.h"
+#include "purity.h"
+#include "tail_rec.h"
+
+static bool is_op_(const tree_elem_t* const elem, const enum OpType op)
+{
+    return elem && elem->lexem.type == LEXEM_TYPE_OP && elem->lexem.data.op == op;
+}
+
+static bool is_self_call_(const tail_rec_t* const tail_rec, const tree_elem_t* const elem)
+{
+    lassert(!is_invalid_ptr(tail_rec), "");
+
+    return is_op_(elem, OP_TYPE_FUNC_LBRAKET)
+        && elem->lt->lexem.data.var == tail_rec->func_num
+        && func_args_cnt(elem->rt) == tail_rec->count_args;
+}
+
+static enum TreeError find_call_(const tree_elem_t* elem, void* const is_found)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(is_found), "");
+
+    *(bool*)is_found |= is_op_(elem, OP_TYPE_FUNC_LBRAKET);
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static bool has_call_(const tree_elem_t* const elem)
+{
+    bool is_found = false;
+
+    // walk stack fails only on allocation, then expression is treated as one with calls
+    return tree_walk_pre(elem, find_call_, &is_found) || is_found;
+}
+
+// ret_val is op(f(args), x) or op(x, f(args)) with op of accumulator
+static bool is_acc_ret_(const tail_rec_t* const tail_rec, const tree_elem_t* const ret_val,
+                        const enum OpType acc_op, const tree_elem_t** call, const tree_elem_t** x)
+{
+    lassert(!is_invalid_ptr(tail_rec), "");
+    lassert(!is_invalid_ptr(call), "");
+    lassert(!is_invalid_ptr(x), "");
+
+    if (acc_op == OP_TYPE_UNKNOWN || !is_op_(ret_val, acc_op))
+        return false;
+
+    if (is_self_call_(tail_rec, ret_val->lt) && !has_call_(ret_val->rt))
+    {
+        *call = ret_val->lt;
+        *x    = ret_val->rt;
+        return true;
+    }
+
+    if (is_self_call_(tail_rec, ret_val->rt) && !has_call_(ret_val->lt))
+    {
+        *call = ret_val->rt;
+        *x    = ret_val->lt;
+        return true;
+    }
+
+    return false;
+}
+
+typedef struct TailRecScan
+{
+    tail_rec_t* tail_rec;
+    bool is_acc_mixed;
+} tail_rec_scan_t;
+
+static enum TreeError scan_ret_(const tree_elem_t* elem, void* const arg)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(arg), "");
+
+    tail_rec_scan_t* const scan = arg;
+    tail_rec_t* const tail_rec = scan->tail_rec;
+
+    if (!is_op_(elem, OP_TYPE_RET))
+        return TREE_ERROR_SUCCESS;
+
+    if (is_self_call_(tail_rec, elem->lt))
+    {
+        tail_rec->is_on = true;
+        return TREE_ERROR_SUCCESS;
+    }
+
+    const tree_elem_t* call = NULL;
+    const tree_elem_t* x = NULL;
+    if (is_acc_ret_(tail_rec, elem->lt, OP_TYPE_SUM, &call, &x))
+    {
+        scan->is_acc_mixed |= (tail_rec->acc_op == OP_TYPE_MUL);
+        tail_rec->acc_op = OP_TYPE_SUM;
+    }
+    else if (is_acc_ret_(tail_rec, elem->lt, OP_TYPE_MUL, &call, &x))
+    {
+        scan->is_acc_mixed |= (tail_rec->acc_op == OP_TYPE_SUM);
+        tail_rec->acc_op = OP_TYPE_MUL;
+    }
+
+    return TREE_ERROR_SUCCESS;
+}
+
+enum IrTranslationError tail_rec_scan(const tree_elem_t* const body, const func_t func,
+                                      tail_rec_t* const tail_rec)
+{
+    lassert(!is_invalid_ptr(tail_rec), "");
+
+    *tail_rec = (tail_rec_t){.func_num = func.num, .count_args = func.count_args,
+                             .acc_op = OP_TYPE_UNKNOWN};
+
+    tail_rec_scan_t scan = {.tail_rec = tail_rec, .is_acc_mixed = false};
+    if (tree_walk_pre(body, scan_ret_, &scan))
+    {
+        fprintf(stderr, "Can't walk function body for tail recursion\n");
+        return IR_TRANSLATION_ERROR_STACK;
+    }
+
+    // sums and products of different returns can't be in one accumulator
+    if (scan.is_acc_mixed)
+        tail_rec->acc_op = OP_TYPE_UNKNOWN;
+
+    tail_rec->is_on |= (tail_rec->acc_op != OP_TYPE_UNKNOWN);
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+enum IrTranslationError translate_tail_rec_start(translator_t* const translator,
+                                                 tail_rec_t* const tail_rec, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(tail_rec), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    if (tail_rec->acc_op != OP_TYPE_UNKNOWN)
+    {
+        IR_EMIT_ASSIGN_TMP_NUM_(translator->temp_var_num++, tail_rec->acc_op == OP_TYPE_MUL ? 1l : 0l);
+        IR_EMIT_ASSIGN_VAR_(tail_rec->acc_var, translator->temp_var_num - 1, "accumulator");
+    }
+
+    if (tail_rec->is_on)
+    {
+        tail_rec->label_start = USE_LABEL_();
+        IR_EMIT_LABEL_(tail_rec->label_start, "start of tail recursive func");
+    }
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+enum IrTranslationError translate_acc(translator_t* const translator, const size_t tmp, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    const tail_rec_t* const tail_rec = &translator->tail_rec;
+    if (!tail_rec->is_on || tail_rec->acc_op == OP_TYPE_UNKNOWN)
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
+    const size_t acc_tmp = translator->temp_var_num++;
+    IR_EMIT_ASSIGN_TMP_VAR_(acc_tmp, tail_rec->acc_var, "accumulator");
+
+    if (tail_rec->acc_op == OP_TYPE_MUL)
+        IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_MUL, tmp, acc_tmp);
+    else
+        IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_SUM, tmp, acc_tmp);
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+enum IrTranslationError translate_tail_call(translator_t* const translator,
+                                            const tree_elem_t* const ret_val, FILE* out,
+                                            bool* const is_translated)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!is_invalid_ptr(ret_val), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+    lassert(!is_invalid_ptr(is_translated), "");
+
+    const tail_rec_t* const tail_rec = &translator->tail_rec;
+    if (!tail_rec->is_on)
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
+    const tree_elem_t* call = NULL;
+    const tree_elem_t* x = NULL;
+    if (is_self_call_(tail_rec, ret_val))
+        call = ret_val;
+    else if (!is_acc_ret_(tail_rec, ret_val, tail_rec->acc_op, &call, &x))
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
+    const size_t count_args = tail_rec->count_args;
+    const tree_elem_t** const args = calloc(count_args + 1, sizeof(*args));
+    size_t* const arg_tmps = calloc(count_args + 1, sizeof(*arg_tmps));
+    if (!args || !arg_tmps)
+    {
+        perror("Can't calloc args");
+        free(args);
+        free(arg_tmps);
+        return IR_TRANSLATION_ERROR_STANDARD_ERRNO;
+    }
+
+    func_args_collect(call->rt, count_args, args);
+
+    // all args are computed before params are changed
+    for (size_t var_ind = 0; var_ind < count_args; ++var_ind)
+    {
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, args[var_ind], out),
+                                                                 free(args);free(arg_tmps););
+        arg_tmps[var_ind] = translator->temp_var_num - 1;
+    }
+
+    free(args);
+
+    if (x)
+    {
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, x, out),        free(arg_tmps););
+        IR_TRANSLATION_ERROR_HANDLE(translate_acc(translator, translator->temp_var_num - 1, out),
+                                                                                     free(arg_tmps););
+        IR_EMIT_ASSIGN_VAR_(tail_rec->acc_var, translator->temp_var_num - 1, "accumulator");
+    }
+
+    // in reverse, so tmps on stack are taken from its top
+    for (size_t var_ind = count_args; var_ind > 0; --var_ind)
+    {
+        IR_EMIT_ASSIGN_VAR_(tail_rec->first_arg_var + (long long int)var_ind - 1, 
+                            arg_tmps[var_ind - 1], "tail call arg");
+    }
+
+    free(arg_tmps);
+
+    IR_EMIT_JMP_(tail_rec->label_start, "tail call");
+
+    *is_translated = true;
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
\ No newline at end of file
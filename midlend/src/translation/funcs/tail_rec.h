@@ -0,0 +1,34 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_TAIL_REC_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_TAIL_REC_H
+
+#include <stdio.h>
+#include <stdbool.h>
+
+#include "utils/src/tree/structs.h"
+#include "translation/structs.h"
+#include "translation/verification/verification.h"
+
+// Tail recursion. In function, that calls itself in return:
+// - return f(args) is assignment of args to params and jump to the start of the function,
+// - return f(args) op x, where op is + or * and x has no calls, is the same jump, but before it
+//   x is accumulated: acc = acc op x. Then every other return gives acc op value.
+// x may be moved before the call, because without calls it has no side effects,
+// and op is associative and commutative (also in overflow).
+
+// tail_rec->is_on - body has self calls, that are rewritten
+enum IrTranslationError tail_rec_scan(const tree_elem_t* const body, const func_t func,
+                                      tail_rec_t* const tail_rec);
+
+// after args are taken: accumulator init and label_start of tail_rec
+enum IrTranslationError translate_tail_rec_start(translator_t* const translator,
+                                                 tail_rec_t* const tail_rec, FILE* out);
+
+// tmp with res = acc op tmp, if function has accumulator
+enum IrTranslationError translate_acc(translator_t* const translator, const size_t tmp, FILE* out);
+
+// is_translated - ret_val is a self call, that is replaced with jump, if tail_rec is on
+enum IrTranslationError translate_tail_call(translator_t* const translator,
+                                            const tree_elem_t* const ret_val, FILE* out,
+                                            bool* const is_translated);
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_TAIL_REC_H */
\ No newline at end of file
@@ -1,14 +1,22 @@
 #include <stdbool.h>
 
 #include "utils/utils.h"
+#include "utils/src/tree/funcs/funcs.h"
 #include "stack_on_array/libstack.h"
 #include "translation/funcs/funcs.h"
 #include "hash_table/libhash_table.h"
 #define IR_file out
 #define NUM_SPECIFER_ "%ld"
 #include "PYAM_IR/include/libpyam_ir.h"
+#include "ir_emit.h"
 #include "translation/structs.h"
 #include "map_utils.h"
+#include "translation_lib.h"
+#include "purity.h"
+#include "pow_chain.h"
+#include "tail_rec.h"
+#include "memo.h"
+#include "inline.h"
 
 #define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
     do {                                                                                            \
@@ -42,15 +50,23 @@ static enum IrTranslationError translator_ctor_(translator_t* const translator)
 
     STACK_ERROR_HANDLE_(STACK_CTOR(&translator->vars, sizeof(stack_key_t), 1));
     STACK_ERROR_HANDLE_(STACK_CTOR(&translator->funcs, sizeof(func_t), 10));
+    IR_TRANSLATION_ERROR_HANDLE(purity_ctor(&translator->purity));
     translator->label_num = 0;
     translator->temp_var_num = 0;
     translator->var_num_base = 0;
+    translator->bin = NULL;
+    translator->names = NULL;
+    translator->opts = (ir_translation_opts_t){};
+    translator->tail_rec = (tail_rec_t){.is_on = false, .acc_op = OP_TYPE_UNKNOWN};
+    translator->memo = (memo_t){.is_on = false};
+    translator->inl = (inline_t){};
+    translator->inlined_cnt = 0;
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
 #undef SMASH_MAP_SIZE_
 
-static enum IrTranslationError clean_vars_stacks_(translator_t* const translator)
+enum IrTranslationError clean_vars_stacks(translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
@@ -71,10 +87,12 @@ static void translator_dtor_(translator_t* const translator)
 
     smash_map_dtor(&translator->func_arg_num);
 
-    clean_vars_stacks_(translator);
+    clean_vars_stacks(translator);
 
     stack_dtor(&translator->vars);
     stack_dtor(&translator->funcs);
+    purity_dtor(&translator->purity);
+
     IF_DEBUG(translator->label_num = 0;)
     IF_DEBUG(translator->temp_var_num = 0;)
     IF_DEBUG(translator->var_num_base = 0;)
@@ -89,83 +107,106 @@ static void translator_dtor_(translator_t* const translator)
 
 #undef OPERATION_HANDLE
 
-static enum IrTranslationError translate_recursive_(translator_t* const translator, 
-                                                    const tree_elem_t* elem, 
-                                                    FILE* out);
 
+static enum IrTranslationError translate_entry_(translator_t* const translator, FILE* out)
+{
+    lassert(!is_invalid_ptr(translator), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    const size_t ret_main_tmp = translator->temp_var_num++;
+    
+    IR_EMIT_GLOBAL_VARS_NUM_(0ul); //hard cock
+    IR_EMIT_CALL_MAIN_(ret_main_tmp);
 
-enum IrTranslationError translate(const tree_t* const tree, FILE* out)
+    IR_EMIT_GIVE_ARG_((size_t)0, ret_main_tmp);
+    IR_EMIT_SYSCALL_(translator->temp_var_num++, 
+        kIR_SYS_CALL_ARRAY[SYSCALL_HLT_INDEX].Name, 
+        kIR_SYS_CALL_ARRAY[SYSCALL_HLT_INDEX].NumberOfArguments
+    );
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+enum IrTranslationError translate_ir(const tree_t* const tree, const interner_t* const names,
+                                     const ir_translation_opts_t opts, FILE* out,
+                                     pyam_bin_writer_t* const bin)
 {
     TREE_VERIFY_ASSERT(tree);
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+    lassert(!bin || !is_invalid_ptr(bin), "");
 
     translator_t translator = {};
     IR_TRANSLATION_ERROR_HANDLE(translator_ctor_(&translator));
+    translator.names = names;
+    translator.bin = bin;
+    translator.opts = opts;
 
-    const size_t ret_main_tmp = translator.temp_var_num++;
-    
-    IR_GLOBAL_VARS_NUM_(0ul); //hard cock
-    IR_CALL_MAIN_(ret_main_tmp);
+    if (opts.memo || opts.inline_calls)
+    {
+        IR_TRANSLATION_ERROR_HANDLE(purity_analyze(&translator.purity, tree->Groot),
+                                    translator_dtor_(&translator);
+        );
+    }
 
-    IR_GIVE_ARG_((size_t)0, ret_main_tmp);
-    IR_SYSCALL_(translator.temp_var_num++, 
-        kIR_SYS_CALL_ARRAY[SYSCALL_HLT_INDEX].Name, 
-        kIR_SYS_CALL_ARRAY[SYSCALL_HLT_INDEX].NumberOfArguments
+    IR_TRANSLATION_ERROR_HANDLE(translate_entry_(&translator, out),
+                                translator_dtor_(&translator);
     );
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(&translator, tree->Groot, out),     
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(&translator, tree->Groot, out),     
                                 translator_dtor_(&translator);
     );
 
+    // size of IR is the count of binary records
+    if (opts.report)
+        fprintf(stderr, "inline: %zu calls inlined, IR size %zu blocks\n",
+                        translator.inlined_cnt, bin ? stack_size(bin->records) : 0ul);
+
     translator_dtor_(&translator);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
 
-#define CUR_VAR_STACK_                                                                              \
-        (stack_size(translator->vars)                                                               \
-            ? (stack_key_t*)stack_get(translator->vars, stack_size(translator->vars) - 1)           \
-            : NULL)
+enum IrTranslationError translate(const tree_t* const tree, const interner_t* const names,
+                                  const ir_translation_opts_t opts, FILE* out, FILE* bin_out)
+{
+    TREE_VERIFY_ASSERT(tree);
+    lassert(!is_invalid_ptr(out), "");
 
-#define CUR_VAR_STACK_SIZE_                                                                         \
-        (CUR_VAR_STACK_ ? stack_size(*CUR_VAR_STACK_) : 0ul)
+    if (!bin_out)
+        return translate_ir(tree, names, opts, out, NULL);
 
-#define CHECK_DECLD_VAR_(result_, elem_)                                                            \
-    do {                                                                                            \
-        size_t* founded_elem = NULL;                                                                \
-        long long int base_counter = translator->var_num_base + (long long int)CUR_VAR_STACK_SIZE_;                   \
-        for (size_t stack_ind = stack_size(translator->vars); stack_ind > 0; --stack_ind)           \
-        {                                                                                           \
-            const stack_key_t stack = *(stack_key_t*)stack_get(translator->vars, stack_ind - 1);    \
-            base_counter -= (long long int)stack_size(stack);                                                \
-            if ((founded_elem = (size_t*)stack_find(stack, &elem_->lexem.data.var, NULL)))          \
-            {                                                                                       \
-                result_ = base_counter                                                              \
-                        + (founded_elem - (size_t*)stack_begin(stack));                             \
-                break;                                                                              \
-            }                                                                                       \
-        }                                                                                           \
-        if (!founded_elem)                                                                          \
-        {                                                                                           \
-            fprintf(stderr, "Use undeclarated var with %zu num\n", elem_->lexem.data.var);          \
-            return IR_TRANSLATION_ERROR_UNDECL_VAR;                                                 \
-        }                                                                                           \
-    } while(0)
+    pyam_bin_writer_t bin = {};
+    IR_TRANSLATION_ERROR_HANDLE(pyam_bin_writer_ctor(&bin));
 
-#define CHECK_UNDECLD_VAR_(elem_)                                                                   \
-    do {                                                                                            \
-        if (stack_find(*CUR_VAR_STACK_, &elem_->lexem.data.var, NULL))                              \
-        {                                                                                           \
-            fprintf(stderr, "Redeclarated var with %zu num\n", elem_->lexem.data.var);              \
-            return IR_TRANSLATION_ERROR_REDECL_VAR;                                                 \
-        }                                                                                           \
-    } while(0)
+    IR_TRANSLATION_ERROR_HANDLE(translate_ir(tree, names, opts, out, &bin),
+                                pyam_bin_writer_dtor(&bin);
+    );
+
+    IR_TRANSLATION_ERROR_HANDLE(pyam_bin_write(&bin, bin_out),
+                                pyam_bin_writer_dtor(&bin);
+    );
+
+    pyam_bin_writer_dtor(&bin);
+
+    return IR_TRANSLATION_ERROR_SUCCESS;
+}
+
+const wchar_t* var_name(const translator_t* const translator, const size_t var)
+{
+    lassert(!is_invalid_ptr(translator), "");
+
+    if (!translator->names || var >= translator->names->size)
+        return L"?";
+
+    return interner_get(translator->names, var);
+}
 
 #define CHECK_DECLD_FUNC_(func_)                                                                    \
     do {                                                                                            \
         if (!(func_t*)stack_find(translator->funcs, &func_, NULL))                                  \
         {                                                                                           \
-            fprintf(stderr, "Use undeclarated func with %zu num\n", func_.num);                     \
+            fprintf(stderr, "Use undeclarated func '%ls' with %zu num\n",                           \
+                            var_name(translator, func_.num), func_.num);                            \
             return IR_TRANSLATION_ERROR_UNDECL_VAR;                                                 \
         }                                                                                           \
     } while(0)
@@ -174,33 +215,31 @@ enum IrTranslationError translate(const tree_t* const tree, FILE* out)
     do {                                                                                            \
         if (stack_find(translator->vars, &func_, NULL))                                             \
         {                                                                                           \
-            fprintf(stderr, "Redeclarated func with %zu num\n", func_.num);                         \
+            fprintf(stderr, "Redeclarated func '%ls' with %zu num\n",                               \
+                            var_name(translator, func_.num), func_.num);                            \
             return IR_TRANSLATION_ERROR_REDECL_VAR;                                                 \
         }                                                                                           \
     } while(0)
 
 
-    
-#define USE_LABEL_()                                                                                \
-        (translator->label_num++)
 
 #define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
         case num_: IR_TRANSLATION_ERROR_HANDLE(translate_##name_(translator, elem, out)); break;
 
-enum IrTranslationError translate_recursive_(translator_t* const translator, const tree_elem_t* elem, 
-                                             FILE* out)
+enum IrTranslationError translate_recursive(translator_t* const translator, const tree_elem_t* elem,
+                                            FILE* out)
 {
     if (!elem) return IR_TRANSLATION_ERROR_SUCCESS;
 
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     switch (elem->lexem.type)
     {
     case LEXEM_TYPE_NUM:
     {
-        IR_ASSIGN_TMP_NUM_(translator->temp_var_num++, elem->lexem.data.num);
+        IR_EMIT_ASSIGN_TMP_NUM_(translator->temp_var_num++, elem->lexem.data.num);
         break;
     }
 
@@ -209,7 +248,7 @@ enum IrTranslationError translate_recursive_(translator_t* const translator, con
         long long int var_ind = 0;
         CHECK_DECLD_VAR_(var_ind, elem);
 
-        IR_ASSIGN_TMP_VAR_(translator->temp_var_num++, var_ind, "");
+        IR_EMIT_ASSIGN_TMP_VAR_(translator->temp_var_num++, var_ind, "");
         break;
     }
 
@@ -240,17 +279,17 @@ static enum IrTranslationError translate_SUM(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_SUM, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_SUM, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -259,17 +298,17 @@ static enum IrTranslationError translate_SUB(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_SUB, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_SUB, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -278,17 +317,17 @@ static enum IrTranslationError translate_MUL(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_MUL, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_MUL, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -297,17 +336,17 @@ static enum IrTranslationError translate_DIV(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_DIV, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_DIV, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -316,7 +355,13 @@ static enum IrTranslationError translate_POW(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    bool is_translated = false;
+    IR_TRANSLATION_ERROR_HANDLE(translate_pow_const(translator, elem, out, &is_translated));
+
+    if (is_translated)
+        return IR_TRANSLATION_ERROR_SUCCESS;
 
     func_t func = {
         .num = SIZE_MAX - SYSCALL_POW_INDEX, 
@@ -334,18 +379,18 @@ static enum IrTranslationError translate_POW(translator_t* const translator, con
         );
     }
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_GIVE_ARG_((size_t)0, first_op);
-    IR_GIVE_ARG_((size_t)1, second_op);
+    IR_EMIT_GIVE_ARG_((size_t)0, first_op);
+    IR_EMIT_GIVE_ARG_((size_t)1, second_op);
 
-    IR_SYSCALL_(translator->temp_var_num++, kIR_SYS_CALL_ARRAY[SYSCALL_POW_INDEX].Name, 
+    IR_EMIT_SYSCALL_(translator->temp_var_num++, kIR_SYS_CALL_ARRAY[SYSCALL_POW_INDEX].Name, 
         kIR_SYS_CALL_ARRAY[SYSCALL_POW_INDEX].NumberOfArguments
     );
 
@@ -356,7 +401,7 @@ static enum IrTranslationError translate_LBRAKET(translator_t* const translator,
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -370,7 +415,7 @@ static enum IrTranslationError translate_RBRAKET(translator_t* const translator,
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -384,10 +429,26 @@ static enum IrTranslationError translate_PLEASE(translator_t* const translator,
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    // statements chain is left-deep, it is flattened to not recurse on its length
+    stack_key_t statements = 0;
+    STACK_ERROR_HANDLE_(STACK_CTOR(&statements, sizeof(const tree_elem_t*), 16));
+
+    if (tree_chain_collect(&statements, elem, OP_TYPE_PLEASE))
+    {
+        stack_dtor(&statements);
+        return IR_TRANSLATION_ERROR_STACK;
+    }
+
+    for (size_t ind = 0; ind < stack_size(statements); ++ind)
+    {
+        const tree_elem_t* const statement = *(const tree_elem_t**)stack_get(statements, ind);
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, statement, out),
+                                                                          stack_dtor(&statements););
+    }
+
+    stack_dtor(&statements);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -396,18 +457,18 @@ static enum IrTranslationError translate_ASSIGNMENT(translator_t* const translat
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     lassert(elem->lt->lexem.type == LEXEM_TYPE_VAR, "");
 
     long long int first_op = 0;
     CHECK_DECLD_VAR_(first_op, elem->lt);
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_ASSIGN_VAR_(first_op, second_op, "");
+    IR_EMIT_ASSIGN_VAR_(first_op, second_op, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -416,7 +477,7 @@ static enum IrTranslationError translate_DECL_ASSIGNMENT(translator_t* const tra
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     lassert(elem->lt->lexem.type == LEXEM_TYPE_VAR, "");
 
@@ -427,16 +488,16 @@ static enum IrTranslationError translate_DECL_ASSIGNMENT(translator_t* const tra
 
     if (elem->rt)
     {
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
     }
     else
     {
-        IR_ASSIGN_TMP_NUM_(translator->temp_var_num++, 0l);
+        IR_EMIT_ASSIGN_TMP_NUM_(translator->temp_var_num++, 0l);
     }
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_ASSIGN_VAR_(first_op, second_op, "");
+    IR_EMIT_ASSIGN_VAR_(first_op, second_op, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -445,7 +506,7 @@ static enum IrTranslationError translate_DECL_FLAG(translator_t* const translato
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -455,7 +516,7 @@ static enum IrTranslationError translate_DECL_FLAG(translator_t* const translato
     return IR_TRANSLATION_ERROR_INVALID_OP_TYPE;
 }
 
-static enum IrTranslationError create_new_var_frame_(translator_t* const translator)
+enum IrTranslationError create_new_var_frame(translator_t* const translator)
 {
     lassert(!is_invalid_ptr(translator), "");
 
@@ -482,41 +543,41 @@ static enum IrTranslationError translate_IF(translator_t* const translator, cons
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t cond_res = translator->temp_var_num - 1;
 
     size_t label_else = USE_LABEL_();
     size_t label_help = USE_LABEL_();
 
-    IR_COND_JMP_(label_help, cond_res, "check IF condition, jmp after else");
-    IR_JMP_(label_else, "jmp to else in IF");
-    IR_LABEL_(label_help, "label not else in IF");
+    IR_EMIT_COND_JMP_(label_help, cond_res, "check IF condition, jmp after else");
+    IR_EMIT_JMP_(label_else, "jmp to else in IF");
+    IR_EMIT_LABEL_(label_help, "label not else in IF");
 
-    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame_(translator));
+    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame(translator));
 
     if (elem->rt->rt)
     {
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt->lt, out));
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt->lt, out));
 
         size_t label_end = USE_LABEL_();
 
-        IR_JMP_(label_end, "jmp to end IF");
-        IR_LABEL_(label_else, "label else for IF");
+        IR_EMIT_JMP_(label_end, "jmp to end IF");
+        IR_EMIT_LABEL_(label_else, "label else for IF");
 
         STACK_ERROR_HANDLE_(stack_clean(CUR_VAR_STACK_));
 
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt->rt, out));
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt->rt, out));
 
-        IR_LABEL_(label_end, "label end for IF");
+        IR_EMIT_LABEL_(label_end, "label end for IF");
     }
     else
     {
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt->lt, out));
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt->lt, out));
 
-        IR_LABEL_(label_else, "label else for IF");
+        IR_EMIT_LABEL_(label_else, "label else for IF");
     }
 
     IR_TRANSLATION_ERROR_HANDLE(delete_top_var_frame_(translator));
@@ -528,7 +589,7 @@ static enum IrTranslationError translate_LBODY(translator_t* const translator, c
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -542,7 +603,7 @@ static enum IrTranslationError translate_RBODY(translator_t* const translator, c
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -556,7 +617,7 @@ static enum IrTranslationError translate_COND_LBRAKET(translator_t* const transl
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -570,7 +631,7 @@ static enum IrTranslationError translate_COND_RBRAKET(translator_t* const transl
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -580,60 +641,55 @@ static enum IrTranslationError translate_COND_RBRAKET(translator_t* const transl
     return IR_TRANSLATION_ERROR_INVALID_OP_TYPE;
 }
 
+// loop is rotated: condition is checked once before it and then at the bottom of the body,
+// so each iteration ends with the only jump back to the body
 static enum IrTranslationError translate_WHILE(translator_t* const translator, const tree_elem_t* elem, FILE* out)
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    size_t label_condition  = USE_LABEL_();
     size_t label_body       = USE_LABEL_();
     size_t label_end        = USE_LABEL_();
-    size_t label_else       = 0;
-
-    if (elem->rt->rt)
-    {
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
-
-        const size_t cond_res = translator->temp_var_num - 1;
-
-        IR_COND_JMP_(label_body, cond_res, "first check WHILE condition, jump to body WHILE");
+    size_t label_else       = elem->rt->rt ? USE_LABEL_() : label_end;
 
-        label_else = USE_LABEL_();
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
-        IR_JMP_(label_else, "jmp to else WHILE");
-    }
+    size_t cond_res = translator->temp_var_num - 1;
 
-    IR_LABEL_(label_condition, "start condition WHILE");
+    IR_EMIT_COND_JMP_(label_body, cond_res, "first check WHILE condition, jump to body WHILE");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_EMIT_JMP_(label_else, "jmp to else or end WHILE");
 
-    const size_t cond_res = translator->temp_var_num - 1;
+    IR_EMIT_LABEL_(label_body, "start body WHILE");
 
-    IR_COND_JMP_(label_body, cond_res, "second check WHILE condition, jmp to body");
+    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame(translator));
 
-    IR_JMP_(label_end,  "jmp to end");
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt->lt, out));
 
-    IR_LABEL_(label_body, "start body WHILE");
+    // vars of the body are out of scope in condition
+    IR_TRANSLATION_ERROR_HANDLE(delete_top_var_frame_(translator));
 
-    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame_(translator));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt->lt, out));
+    cond_res = translator->temp_var_num - 1;
 
-    IR_JMP_(label_condition, "jump to condition WHILE");
+    IR_EMIT_COND_JMP_(label_body, cond_res, "check WHILE condition, jmp to body");
 
     if (elem->rt->rt)
     {
-        STACK_ERROR_HANDLE_(stack_clean(CUR_VAR_STACK_));
+        IR_EMIT_JMP_(label_end, "jmp to end");
 
-        IR_LABEL_(label_else, "start else WHILE");
+        IR_EMIT_LABEL_(label_else, "start else WHILE");
 
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt->rt, out));
-    }
+        IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame(translator));
 
-    IR_LABEL_(label_end, "end WHILE");
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt->rt, out));
 
-    IR_TRANSLATION_ERROR_HANDLE(delete_top_var_frame_(translator));
+        IR_TRANSLATION_ERROR_HANDLE(delete_top_var_frame_(translator));
+    }
+
+    IR_EMIT_LABEL_(label_end, "end WHILE");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -642,10 +698,19 @@ static enum IrTranslationError translate_POW_ASSIGNMENT(translator_t* const tran
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     lassert(elem->lt->lexem.type == LEXEM_TYPE_VAR, "");
 
+    long long int first_op = 0;
+    CHECK_DECLD_VAR_(first_op, elem->lt);
+
+    bool is_translated = false;
+    IR_TRANSLATION_ERROR_HANDLE(translate_pow_const(translator, elem, out, &is_translated));
+
+    if (is_translated)
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
     func_t func = {
         .num = SIZE_MAX - SYSCALL_POW_INDEX, 
         .count_args = (size_t)kIR_SYS_CALL_ARRAY[SYSCALL_POW_INDEX].NumberOfArguments
@@ -662,25 +727,22 @@ static enum IrTranslationError translate_POW_ASSIGNMENT(translator_t* const tran
         );
     }
 
-    long long int first_op = 0;
-    CHECK_DECLD_VAR_(first_op, elem->lt);
+    // var is loaded first: stack backend takes operands in order, they are pushed
+    const size_t first_op_tmp = translator->temp_var_num++;
+    IR_EMIT_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
-
-    const size_t first_op_tmp = translator->temp_var_num++;
     const size_t op_res_tmp = translator->temp_var_num++;
 
-    IR_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
+    IR_EMIT_GIVE_ARG_((size_t)0, first_op_tmp);
+    IR_EMIT_GIVE_ARG_((size_t)1, second_op);
 
-    IR_GIVE_ARG_((size_t)0, first_op_tmp);
-    IR_GIVE_ARG_((size_t)1, second_op);
-
-    IR_SYSCALL_(op_res_tmp, kIR_SYS_CALL_ARRAY[SYSCALL_POW_INDEX].Name, 
+    IR_EMIT_SYSCALL_(op_res_tmp, kIR_SYS_CALL_ARRAY[SYSCALL_POW_INDEX].Name, 
         kIR_SYS_CALL_ARRAY[SYSCALL_POW_INDEX].NumberOfArguments
     );
-    IR_ASSIGN_VAR_(first_op, op_res_tmp, "");
+    IR_EMIT_ASSIGN_VAR_(first_op, op_res_tmp, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -689,23 +751,22 @@ static enum IrTranslationError translate_SUM_ASSIGNMENT(translator_t* const tran
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     lassert(elem->lt->lexem.type == LEXEM_TYPE_VAR, "");
 
     long long int first_op = 0;
     CHECK_DECLD_VAR_(first_op, elem->lt);
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    const size_t first_op_tmp = translator->temp_var_num++;
+    IR_EMIT_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
 
-    const size_t second_op = translator->temp_var_num - 1;
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
-    const size_t first_op_tmp = translator->temp_var_num++;
+    const size_t second_op = translator->temp_var_num - 1;
     const size_t op_res_tmp = translator->temp_var_num++;
-
-    IR_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
-    IR_OPERATION_(op_res_tmp, IR_OP_TYPE_SUM, first_op_tmp, second_op);
-    IR_ASSIGN_VAR_(first_op, op_res_tmp, "");
+    IR_EMIT_OPERATION_(op_res_tmp, IR_OP_TYPE_SUM, first_op_tmp, second_op);
+    IR_EMIT_ASSIGN_VAR_(first_op, op_res_tmp, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -714,23 +775,22 @@ static enum IrTranslationError translate_SUB_ASSIGNMENT(translator_t* const tran
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     lassert(elem->lt->lexem.type == LEXEM_TYPE_VAR, "");
 
     long long int first_op = 0;
     CHECK_DECLD_VAR_(first_op, elem->lt);
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    const size_t first_op_tmp = translator->temp_var_num++;
+    IR_EMIT_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
 
-    const size_t second_op = translator->temp_var_num - 1;
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
-    const size_t first_op_tmp = translator->temp_var_num++;
+    const size_t second_op = translator->temp_var_num - 1;
     const size_t op_res_tmp = translator->temp_var_num++;
-
-    IR_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
-    IR_OPERATION_(op_res_tmp, IR_OP_TYPE_SUB, first_op_tmp, second_op);
-    IR_ASSIGN_VAR_(first_op, op_res_tmp, "");
+    IR_EMIT_OPERATION_(op_res_tmp, IR_OP_TYPE_SUB, first_op_tmp, second_op);
+    IR_EMIT_ASSIGN_VAR_(first_op, op_res_tmp, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -739,23 +799,22 @@ static enum IrTranslationError translate_MUL_ASSIGNMENT(translator_t* const tran
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     lassert(elem->lt->lexem.type == LEXEM_TYPE_VAR, "");
 
     long long int first_op = 0;
     CHECK_DECLD_VAR_(first_op, elem->lt);
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    const size_t first_op_tmp = translator->temp_var_num++;
+    IR_EMIT_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
 
-    const size_t second_op = translator->temp_var_num - 1;
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
-    const size_t first_op_tmp = translator->temp_var_num++;
+    const size_t second_op = translator->temp_var_num - 1;
     const size_t op_res_tmp = translator->temp_var_num++;
-
-    IR_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
-    IR_OPERATION_(op_res_tmp, IR_OP_TYPE_MUL, first_op_tmp, second_op);
-    IR_ASSIGN_VAR_(first_op, op_res_tmp, "");
+    IR_EMIT_OPERATION_(op_res_tmp, IR_OP_TYPE_MUL, first_op_tmp, second_op);
+    IR_EMIT_ASSIGN_VAR_(first_op, op_res_tmp, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -764,23 +823,22 @@ static enum IrTranslationError translate_DIV_ASSIGNMENT(translator_t* const tran
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     lassert(elem->lt->lexem.type == LEXEM_TYPE_VAR, "");
 
     long long int first_op = 0;
     CHECK_DECLD_VAR_(first_op, elem->lt);
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    const size_t first_op_tmp = translator->temp_var_num++;
+    IR_EMIT_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
 
-    const size_t second_op = translator->temp_var_num - 1;
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
-    const size_t first_op_tmp = translator->temp_var_num++;
+    const size_t second_op = translator->temp_var_num - 1;
     const size_t op_res_tmp = translator->temp_var_num++;
-
-    IR_ASSIGN_TMP_VAR_(first_op_tmp, first_op, "");
-    IR_OPERATION_(op_res_tmp, IR_OP_TYPE_DIV, first_op_tmp, second_op);
-    IR_ASSIGN_VAR_(first_op, op_res_tmp, "");
+    IR_EMIT_OPERATION_(op_res_tmp, IR_OP_TYPE_DIV, first_op_tmp, second_op);
+    IR_EMIT_ASSIGN_VAR_(first_op, op_res_tmp, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -789,17 +847,17 @@ static enum IrTranslationError translate_EQ(translator_t* const translator, cons
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_EQ, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_EQ, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -808,17 +866,17 @@ static enum IrTranslationError translate_NEQ(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_NEQ, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_NEQ, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -827,17 +885,17 @@ static enum IrTranslationError translate_LESS(translator_t* const translator, co
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_LESS, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_LESS, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -846,17 +904,17 @@ static enum IrTranslationError translate_LESSEQ(translator_t* const translator,
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_LESSEQ, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_LESSEQ, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -865,17 +923,17 @@ static enum IrTranslationError translate_GREAT(translator_t* const translator, c
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_GREAT, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_GREAT, first_op, second_op);
 
 
     return IR_TRANSLATION_ERROR_SUCCESS;
@@ -885,17 +943,17 @@ static enum IrTranslationError translate_GREATEQ(translator_t* const translator,
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     const size_t first_op = translator->temp_var_num - 1;
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
     const size_t second_op = translator->temp_var_num - 1;
 
-    IR_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_GREATEQ, first_op, second_op);
+    IR_EMIT_OPERATION_(translator->temp_var_num++, IR_OP_TYPE_GREATEQ, first_op, second_op);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -904,7 +962,7 @@ static enum IrTranslationError translate_ELSE(translator_t* const translator, co
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -922,13 +980,7 @@ static enum IrTranslationError init_func_(translator_t* const translator, const
     lassert(!is_invalid_ptr(translator), "");
 
     func->num        = tree_ptr->lt->lexem.data.var;
-    func->count_args = (tree_ptr->rt != NULL);
-
-    for (tree_ptr = tree_ptr->rt; tree_ptr != NULL; tree_ptr = tree_ptr->lt)
-    {
-        func->count_args += (tree_ptr->lexem.type    == LEXEM_TYPE_OP 
-                          && tree_ptr->lexem.data.op == OP_TYPE_ARGS_COMMA);
-    }
+    func->count_args = func_args_cnt(tree_ptr->rt);
 
     if (!smash_map_get_val(&translator->func_arg_num, func))
     {
@@ -948,7 +1000,7 @@ static enum IrTranslationError translate_FUNC(translator_t* const translator, co
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     func_t func = {};
     IR_TRANSLATION_ERROR_HANDLE(init_func_(translator, elem->lt, &func));
@@ -956,9 +1008,33 @@ static enum IrTranslationError translate_FUNC(translator_t* const translator, co
     CHECK_UNDECLD_FUNC_(func);
     STACK_ERROR_HANDLE_(stack_push(&translator->funcs, &func));
 
-    IR_FUNCTION_BODY_(func.num, func.count_args, (size_t)elem->lt->lexem.data.num, ""); 
+    tail_rec_t tail_rec = {.is_on = false, .acc_op = OP_TYPE_UNKNOWN};
+    if (translator->opts.tail_rec)
+    {
+        IR_TRANSLATION_ERROR_HANDLE(tail_rec_scan(elem->rt, func, &tail_rec));
+    }
+
+    const func_purity_t* const purity = purity_find(&translator->purity, func.num, func.count_args);
+
+    // accumulator, copies of args for memo and vars of inlined calls are after locals of the function
+    const size_t locals_cnt = (size_t)elem->lt->lexem.data.num;
+    const size_t acc_cnt = (tail_rec.acc_op != OP_TYPE_UNKNOWN);
+    tail_rec.acc_var = (long long int)locals_cnt;
+
+    translator->memo = memo_of_func(translator, purity, func.count_args, 
+                                    (long long int)(locals_cnt + acc_cnt));
+
+    translator->inl = (inline_t){
+        .chain      = {purity},
+        .free_var   = translator->memo.first_var + (long long int)translator->memo.count_args
+    };
 
-    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame_(translator));
+    long long int vars_end = 0;
+    IR_TRANSLATION_ERROR_HANDLE(inline_vars_end(translator, &translator->inl, elem->rt, &vars_end));
+
+    IR_EMIT_FUNCTION_BODY_(func.num, func.count_args, (size_t)vars_end, ""); 
+
+    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame(translator));
 
     const tree_elem_t** arr_vars = calloc(func.count_args, sizeof(*arr_vars));
 
@@ -981,15 +1057,26 @@ static enum IrTranslationError translate_FUNC(translator_t* const translator, co
         const long long int first_op = translator->var_num_base + (long long int)(CUR_VAR_STACK_SIZE_ - 1);
         const size_t second_op = var_ind;
 
-        IR_TAKE_ARG_(first_op, second_op, "");
+        IR_EMIT_TAKE_ARG_(first_op, second_op, "");
+
+        if (var_ind == 0)
+            tail_rec.first_arg_var = first_op;
     }
 
     free(arr_vars);
 
+    IR_TRANSLATION_ERROR_HANDLE(translate_memo_get(translator, tail_rec.first_arg_var, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_tail_rec_start(translator, &tail_rec, out));
+
+    translator->tail_rec = tail_rec;
+
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    translator->tail_rec = (tail_rec_t){.is_on = false, .acc_op = OP_TYPE_UNKNOWN};
+    translator->memo = (memo_t){.is_on = false};
+    translator->inl = (inline_t){};
 
-    IR_TRANSLATION_ERROR_HANDLE(clean_vars_stacks_(translator));
+    IR_TRANSLATION_ERROR_HANDLE(clean_vars_stacks(translator));
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -998,17 +1085,21 @@ static enum IrTranslationError translate_FUNC_LBRAKET(translator_t* const transl
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     func_t func = {};
     IR_TRANSLATION_ERROR_HANDLE(init_func_(translator, elem, &func));
 
+    const func_purity_t* const callee = inline_callee(translator, &translator->inl, elem);
+    if (callee)
+        return translate_inline(translator, elem, callee, out);
+
     // const tree_elem_t* arg = elem->rt;
     // for (size_t count = 1; count < func.count_args; ++count, arg = arg->lt)
     // {
     //     const size_t first_op = start_arg_num + func.count_args - count;
 
-    //     IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, arg->rt, out));
+    //     IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, arg->rt, out));
     //     const size_t second_op = translator->temp_var_num - 1;
 
     //     IR_GIVE_ARG_(first_op, second_op);
@@ -1017,7 +1108,7 @@ static enum IrTranslationError translate_FUNC_LBRAKET(translator_t* const transl
     // {
     //     const size_t first_op = start_arg_num;
 
-    //     IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, arg, out));
+    //     IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, arg, out));
     //     const size_t second_op = translator->temp_var_num - 1;
 
     //     IR_GIVE_ARG_(first_op, second_op);
@@ -1040,15 +1131,15 @@ static enum IrTranslationError translate_FUNC_LBRAKET(translator_t* const transl
         const size_t first_op = var_ind;
 
         arg = arr_vars[func.count_args - var_ind - 1];
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, arg, out));
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, arg, out));
         const size_t second_op = translator->temp_var_num - 1;
 
-        IR_GIVE_ARG_(first_op, second_op);
+        IR_EMIT_GIVE_ARG_(first_op, second_op);
     }
 
     free(arr_vars);
 
-    IR_CALL_FUNC_(translator->temp_var_num++, func.num, func.count_args, "");
+    IR_EMIT_CALL_FUNC_(translator->temp_var_num++, func.num, func.count_args, "");
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -1057,7 +1148,7 @@ static enum IrTranslationError translate_FUNC_RBRAKET(translator_t* const transl
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -1071,17 +1162,26 @@ static enum IrTranslationError translate_MAIN(translator_t* const translator, co
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
+
+    translator->inl = (inline_t){.free_var = (long long int)elem->lt->lexem.data.num};
 
-    IR_MAIN_BODY_((size_t)elem->lt->lexem.data.num);
+    long long int vars_end = 0;
+    long long int decls_vars_end = 0;
+    IR_TRANSLATION_ERROR_HANDLE(inline_vars_end(translator, &translator->inl, elem->rt, &vars_end));
+    IR_TRANSLATION_ERROR_HANDLE(inline_vars_end(translator, &translator->inl, elem->lt->lt, 
+                                                 &decls_vars_end));
 
-    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame_(translator));
+    IR_EMIT_MAIN_BODY_((size_t)(vars_end > decls_vars_end ? vars_end : decls_vars_end));
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt->lt, out));
-    IR_TRANSLATION_ERROR_HANDLE(clean_vars_stacks_(translator));
+    IR_TRANSLATION_ERROR_HANDLE(create_new_var_frame(translator));
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt->lt, out));
+    IR_TRANSLATION_ERROR_HANDLE(clean_vars_stacks(translator));
 
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
+
+    translator->inl = (inline_t){};
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -1090,10 +1190,10 @@ static enum IrTranslationError translate_ARGS_COMMA(translator_t* const translat
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    // IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->rt, out));
-    // IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    // IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->rt, out));
+    // IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
 
     fprintf(stderr, "Invalid op type: %s\n", __func__);
 
@@ -1104,7 +1204,7 @@ static enum IrTranslationError translate_CALL_FUNC_LBRAKET(translator_t* const t
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -1118,7 +1218,7 @@ static enum IrTranslationError translate_CALL_FUNC_RBRAKET(translator_t* const t
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
     (void)translator;
     (void)elem;
     (void)out;
@@ -1132,13 +1232,25 @@ static enum IrTranslationError translate_RET(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
-    IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, elem->lt, out));
+    if (translator->inl.depth)
+        return translate_inline_ret(translator, elem, out);
+
+    bool is_translated = false;
+    IR_TRANSLATION_ERROR_HANDLE(translate_tail_call(translator, elem->lt, out, &is_translated));
+    if (is_translated)
+        return IR_TRANSLATION_ERROR_SUCCESS;
+
+    IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, elem->lt, out));
+
+    // result goes through accumulator and cache, if they are on
+    IR_TRANSLATION_ERROR_HANDLE(translate_acc     (translator, translator->temp_var_num - 1, out));
+    IR_TRANSLATION_ERROR_HANDLE(translate_memo_put(translator, translator->temp_var_num - 1, out));
 
     const size_t ret_val = translator->temp_var_num - 1;
 
-    IR_RET_(ret_val);
+    IR_EMIT_RET_(ret_val);
 
     return IR_TRANSLATION_ERROR_SUCCESS;
 }
@@ -1147,7 +1259,7 @@ static enum IrTranslationError translate_IN(translator_t* const translator, cons
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     size_t count_args = (elem->lt != NULL);
 
@@ -1178,13 +1290,13 @@ static enum IrTranslationError translate_IN(translator_t* const translator, cons
         long long int var = arr_vars[count_args - var_ind - 1];
         const size_t tmp_num = translator->temp_var_num++;
 
-        IR_SYSCALL_(
+        IR_EMIT_SYSCALL_(
             tmp_num, 
             kIR_SYS_CALL_ARRAY[SYSCALL_IN_INDEX].Name, 
             kIR_SYS_CALL_ARRAY[SYSCALL_IN_INDEX].NumberOfArguments
         );
 
-        IR_ASSIGN_VAR_(var, tmp_num, "IN arg");
+        IR_EMIT_ASSIGN_VAR_(var, tmp_num, "IN arg");
     }
 
     free(arr_vars);
@@ -1197,7 +1309,7 @@ static enum IrTranslationError translate_OUT(translator_t* const translator, con
 {
     lassert(!is_invalid_ptr(translator), "");
     lassert(!is_invalid_ptr(elem), "");
-    lassert(!is_invalid_ptr(out), "");
+    lassert(!out || !is_invalid_ptr(out), "");
 
     func_t func = {
         .num = SIZE_MAX - SYSCALL_OUT_INDEX, 
@@ -1238,12 +1350,12 @@ static enum IrTranslationError translate_OUT(translator_t* const translator, con
     for (size_t var_ind = 0; var_ind < count_args; ++var_ind)
     {
         arg = arr_vars[count_args - var_ind - 1];
-        IR_TRANSLATION_ERROR_HANDLE(translate_recursive_(translator, arg, out));
+        IR_TRANSLATION_ERROR_HANDLE(translate_recursive(translator, arg, out));
         size_t argument = translator->temp_var_num - 1;
 
-        IR_GIVE_ARG_((size_t)0, argument);
+        IR_EMIT_GIVE_ARG_((size_t)0, argument);
 
-        IR_SYSCALL_(
+        IR_EMIT_SYSCALL_(
             translator->temp_var_num++, 
             kIR_SYS_CALL_ARRAY[SYSCALL_OUT_INDEX].Name, 
             kIR_SYS_CALL_ARRAY[SYSCALL_OUT_INDEX].NumberOfArguments
@@ -0,0 +1,68 @@
+#ifndef MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_TRANSLATION_LIB_H
+#define MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_TRANSLATION_LIB_H
+
+#include <stdio.h>
+#include <wchar.h>
+
+#include "stack_on_array/libstack.h"
+#include "utils/src/tree/structs.h"
+#include "translation/structs.h"
+#include "translation/verification/verification.h"
+
+// Shared by translation.c and units of optimizations, that emit blocks by ir_emit.h and
+// translate subtrees back by translate_recursive.
+
+enum IrTranslationError translate_recursive(translator_t* const translator, const tree_elem_t* elem,
+                                            FILE* out);
+
+enum IrTranslationError create_new_var_frame(translator_t* const translator);
+enum IrTranslationError clean_vars_stacks   (translator_t* const translator);
+
+// name from frontend names table for diagnostics
+const wchar_t* var_name(const translator_t* const translator, const size_t var);
+
+#define CUR_VAR_STACK_                                                                              \
+        (stack_size(translator->vars)                                                               \
+            ? (stack_key_t*)stack_get(translator->vars, stack_size(translator->vars) - 1)           \
+            : NULL)
+
+#define CUR_VAR_STACK_SIZE_                                                                         \
+        (CUR_VAR_STACK_ ? stack_size(*CUR_VAR_STACK_) : 0ul)
+
+#define CHECK_DECLD_VAR_(result_, elem_)                                                            \
+    do {                                                                                            \
+        size_t* founded_elem = NULL;                                                                \
+        long long int base_counter = translator->var_num_base + (long long int)CUR_VAR_STACK_SIZE_;                   \
+        for (size_t stack_ind = stack_size(translator->vars); stack_ind > 0; --stack_ind)           \
+        {                                                                                           \
+            const stack_key_t stack = *(stack_key_t*)stack_get(translator->vars, stack_ind - 1);    \
+            base_counter -= (long long int)stack_size(stack);                                                \
+            if ((founded_elem = (size_t*)stack_find(stack, &elem_->lexem.data.var, NULL)))          \
+            {                                                                                       \
+                result_ = base_counter                                                              \
+                        + (founded_elem - (size_t*)stack_begin(stack));                             \
+                break;                                                                              \
+            }                                                                                       \
+        }                                                                                           \
+        if (!founded_elem)                                                                          \
+        {                                                                                           \
+            fprintf(stderr, "Use undeclarated var '%ls' with %zu num\n",                            \
+                            var_name(translator, elem_->lexem.data.var), elem_->lexem.data.var);    \
+            return IR_TRANSLATION_ERROR_UNDECL_VAR;                                                 \
+        }                                                                                           \
+    } while(0)
+
+#define CHECK_UNDECLD_VAR_(elem_)                                                                   \
+    do {                                                                                            \
+        if (stack_find(*CUR_VAR_STACK_, &elem_->lexem.data.var, NULL))                              \
+        {                                                                                           \
+            fprintf(stderr, "Redeclarated var '%ls' with %zu num\n",                                \
+                            var_name(translator, elem_->lexem.data.var), elem_->lexem.data.var);    \
+            return IR_TRANSLATION_ERROR_REDECL_VAR;                                                 \
+        }                                                                                           \
+    } while(0)
+
+#define USE_LABEL_()                                                                                \
+        (translator->label_num++)
+
+#endif /* MASIK_IR_BACKEND_SRC_TRANSLATION_FUNCS_TRANSLATION_LIB_H */
\ No newline at end of file
@@ -3,9 +3,14 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <stdbool.h>
 
 #include "hash_table/libhash_table.h"
 #include "stack_on_array/libstack.h"
+#include "translation/funcs/pyam_bin.h"
+#include "translation/funcs/purity.h"
+#include "utils/src/interner/interner.h"
+#include "utils/src/tree/structs.h"
 
 typedef struct Func
 {
@@ -13,6 +18,51 @@ typedef struct Func
     size_t count_args;
 } func_t;
 
+// optimizations of translation, all false - straightforward IR
+typedef struct IrTranslationOpts
+{
+    bool tail_rec;      // self calls in tail position are jumps, linear recursion gets accumulator
+    bool memo;          // pure functions with several self calls cache their results
+    bool inline_calls;  // calls of small functions are replaced with their bodies
+    bool report;        // inlined calls and size of IR are printed to stderr
+} ir_translation_opts_t;
+
+// current function, if its self calls are rewritten
+typedef struct TailRec
+{
+    bool is_on;
+    size_t func_num;
+    size_t count_args;
+    long long int first_arg_var;
+    size_t label_start;         // after args are taken
+    enum OpType acc_op;         // OP_TYPE_SUM or OP_TYPE_MUL, OP_TYPE_UNKNOWN - without accumulator
+    long long int acc_var;
+} tail_rec_t;
+
+// current function, if its results are cached
+typedef struct Memo
+{
+    bool is_on;
+    size_t id;
+    size_t count_args;
+    long long int first_var;    // copies of args, params may be changed by tail calls
+} memo_t;
+
+#define INLINE_DEPTH_MAX (3)
+
+// calls, that are inlined in current function now. Callee body is translated at call site
+// in its own var frames, its vars are after vars of the function and of outer inlined calls
+typedef struct Inline
+{
+    size_t depth;                                   // 0 - body of the function itself
+    const func_purity_t* chain[INLINE_DEPTH_MAX + 1];  // [0] - function, NULL in main
+    long long int free_var;                         // first var, that isn't used
+    long long int res_var;
+    size_t label_end;
+    const tree_elem_t* body;                        // returns at its end fall through to label_end
+    bool is_end_jumped;
+} inline_t;
+
 typedef struct Translator
 {
     stack_key_t vars;
@@ -22,6 +72,18 @@ typedef struct Translator
     long long int var_num_base;
 
     smash_map_t func_arg_num;
+
+    pyam_bin_writer_t* bin;
+    const interner_t* names;
+
+    ir_translation_opts_t opts;
+    tail_rec_t tail_rec;
+
+    purity_t purity;
+    memo_t memo;
+
+    inline_t inl;
+    size_t inlined_cnt;
 } translator_t;
 
 #endif /*MASIK_IR_BACKEND_SRC_TRANSLATION_STUCTS_H*/
\ No newline at end of file
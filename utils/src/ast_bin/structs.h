@@ -0,0 +1,32 @@
+#ifndef MASIK_UTILS_SRC_AST_BIN_STRUCTS_H
+#define MASIK_UTILS_SRC_AST_BIN_STRUCTS_H
+
+#include <stdint.h>
+#include <assert.h>
+
+// Binary form of frontend tree: header, then nodes in preorder.
+// Node starts with tag byte: lexem type, has lt, has rt and value if it is less than
+// AST_BIN_TAG_VALUE_BIG, else value - AST_BIN_TAG_VALUE_BIG follows as LEB128 varint.
+// Value is op, var id or zigzag coded num, so small negative nums are short too.
+
+#define AST_BIN_MAGIC           "MASKAST"
+#define AST_BIN_MAGIC_SIZE      (8)
+#define AST_BIN_VERSION         (1u)
+
+#define AST_BIN_TAG_TYPE_SHIFT  (6)
+#define AST_BIN_TAG_LT          (1u << 5)
+#define AST_BIN_TAG_RT          (1u << 4)
+#define AST_BIN_TAG_VALUE_BIG   (0x0Fu)
+
+typedef struct AstBinHeader
+{
+    char     magic[AST_BIN_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t reserved;
+
+    uint64_t nodes_cnt;
+    uint64_t nodes_size;        // bytes after header
+} ast_bin_header_t;
+static_assert(sizeof(ast_bin_header_t) == 32, "");
+
+#endif /* MASIK_UTILS_SRC_AST_BIN_STRUCTS_H */
@@ -0,0 +1,262 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "interner/interner.h"
+#include "logger/liblogger.h"
+#include "utils.h"
+
+#define CASE_ENUM_TO_STRING_(error) case error: return #error
+const char* interner_strerror(const enum InternerError error)
+{
+    switch(error)
+    {
+        CASE_ENUM_TO_STRING_(INTERNER_ERROR_SUCCESS);
+        CASE_ENUM_TO_STRING_(INTERNER_ERROR_STANDARD_ERRNO);
+        CASE_ENUM_TO_STRING_(INTERNER_ERROR_INVALID_FILE);
+        default:
+            return "UNKNOWN_INTERNER_ERROR";
+    }
+    return "UNKNOWN_INTERNER_ERROR";
+}
+#undef CASE_ENUM_TO_STRING_
+
+#define ARENA_BEGIN_CAPACITY_   1024
+#define OFFSETS_BEGIN_CAPACITY_ 64
+#define TABLE_BEGIN_CAPACITY_   128
+enum InternerError interner_ctor(interner_t* const interner)
+{
+    lassert(!is_invalid_ptr(interner), "");
+
+    *interner = (interner_t){
+        .arena            = calloc(ARENA_BEGIN_CAPACITY_,   sizeof(*interner->arena)),
+        .arena_capacity   = ARENA_BEGIN_CAPACITY_,
+        .offsets          = calloc(OFFSETS_BEGIN_CAPACITY_, sizeof(*interner->offsets)),
+        .offsets_capacity = OFFSETS_BEGIN_CAPACITY_,
+        .table            = calloc(TABLE_BEGIN_CAPACITY_,   sizeof(*interner->table)),
+        .table_capacity   = TABLE_BEGIN_CAPACITY_
+    };
+
+    if (!interner->arena || !interner->offsets || !interner->table)
+    {
+        perror("Can't calloc interner");
+        interner_dtor(interner);
+        return INTERNER_ERROR_STANDARD_ERRNO;
+    }
+
+    return INTERNER_ERROR_SUCCESS;
+}
+#undef TABLE_BEGIN_CAPACITY_
+#undef OFFSETS_BEGIN_CAPACITY_
+#undef ARENA_BEGIN_CAPACITY_
+
+void interner_dtor(interner_t* const interner)
+{
+    lassert(!is_invalid_ptr(interner), "");
+
+    free(interner->arena);   interner->arena   = NULL;
+    free(interner->offsets); interner->offsets = NULL;
+    free(interner->table);   interner->table   = NULL;
+
+    IF_DEBUG(*interner = (interner_t){};)
+}
+
+// FNV-1a
+static size_t hash_(const wchar_t* const name, const size_t name_len)
+{
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (size_t ind = 0; ind < name_len; ++ind)
+    {
+        hash ^= (uint64_t)name[ind];
+        hash *= 0x100000001b3ull;
+    }
+
+    return (size_t)hash;
+}
+
+static size_t* find_slot_(const interner_t* const interner, const wchar_t* const name,
+                          const size_t name_len)
+{
+    const size_t mask = interner->table_capacity - 1;
+
+    for (size_t slot = hash_(name, name_len) & mask; ; slot = (slot + 1) & mask)
+    {
+        const size_t id_plus_one = interner->table[slot];
+        if (!id_plus_one)
+            return interner->table + slot;
+
+        const wchar_t* const slot_name = interner->arena + interner->offsets[id_plus_one - 1];
+        if (wcsncmp(slot_name, name, name_len) == 0 && slot_name[name_len] == L'\0')
+            return interner->table + slot;
+    }
+}
+
+static enum InternerError table_grow_(interner_t* const interner)
+{
+    lassert(!is_invalid_ptr(interner), "");
+
+    size_t* const old_table = interner->table;
+
+    interner->table_capacity *= 2;
+    interner->table = calloc(interner->table_capacity, sizeof(*interner->table));
+    if (!interner->table)
+    {
+        perror("Can't calloc interner table");
+        interner->table = old_table;
+        interner->table_capacity /= 2;
+        return INTERNER_ERROR_STANDARD_ERRNO;
+    }
+
+    for (size_t id = 0; id < interner->size; ++id)
+    {
+        const wchar_t* const name = interner->arena + interner->offsets[id];
+        *find_slot_(interner, name, wcslen(name)) = id + 1;
+    }
+
+    free(old_table);
+
+    return INTERNER_ERROR_SUCCESS;
+}
+
+static enum InternerError realloc_(void** const data, size_t* const capacity, const size_t min_capacity,
+                                   const size_t elem_size)
+{
+    lassert(!is_invalid_ptr(data), "");
+    lassert(!is_invalid_ptr(capacity), "");
+
+    if (min_capacity <= *capacity)
+        return INTERNER_ERROR_SUCCESS;
+
+    size_t new_capacity = *capacity;
+    while (new_capacity < min_capacity)
+        new_capacity *= 2;
+
+    void* const new_data = realloc(*data, new_capacity * elem_size);
+    if (!new_data)
+    {
+        perror("Can't realloc interner");
+        return INTERNER_ERROR_STANDARD_ERRNO;
+    }
+
+    *data     = new_data;
+    *capacity = new_capacity;
+
+    return INTERNER_ERROR_SUCCESS;
+}
+
+enum InternerError interner_intern(interner_t* const interner, const wchar_t* const name,
+                                   const size_t name_len, size_t* const id)
+{
+    lassert(!is_invalid_ptr(interner), "");
+    lassert(!is_invalid_ptr(name), "");
+    lassert(!is_invalid_ptr(id), "");
+
+    size_t* slot = find_slot_(interner, name, name_len);
+    if (*slot)
+    {
+        *id = *slot - 1;
+        return INTERNER_ERROR_SUCCESS;
+    }
+
+    // load factor <= 1/2. Everything grows before the name is added, so error leaves interner as it was
+    if ((interner->size + 1) * 2 > interner->table_capacity)
+    {
+        INTERNER_ERROR_HANDLE(table_grow_(interner));
+        slot = find_slot_(interner, name, name_len);
+    }
+
+    INTERNER_ERROR_HANDLE(realloc_((void**)&interner->arena, &interner->arena_capacity,
+                                   interner->arena_size + name_len + 1, sizeof(*interner->arena)));
+    INTERNER_ERROR_HANDLE(realloc_((void**)&interner->offsets, &interner->offsets_capacity,
+                                   interner->size + 1, sizeof(*interner->offsets)));
+
+    wmemcpy(interner->arena + interner->arena_size, name, name_len);
+    interner->arena[interner->arena_size + name_len] = L'\0';
+
+    interner->offsets[interner->size] = interner->arena_size;
+    interner->arena_size += name_len + 1;
+
+    *id = interner->size++;
+    *slot = *id + 1;
+
+    return INTERNER_ERROR_SUCCESS;
+}
+
+const wchar_t* interner_get(const interner_t* const interner, const size_t id)
+{
+    lassert(!is_invalid_ptr(interner), "");
+    lassert(id < interner->size, "");
+
+    return interner->arena + interner->offsets[id];
+}
+
+enum InternerError interner_print(const interner_t* const interner, FILE* out)
+{
+    lassert(!is_invalid_ptr(interner), "");
+    lassert(!is_invalid_ptr(out), "");
+
+    for (size_t id = 0; id < interner->size; ++id)
+    {
+        if (fprintf(out, "%ls\n", interner_get(interner, id)) < 0)
+        {
+            perror("Can't fprintf name");
+            return INTERNER_ERROR_STANDARD_ERRNO;
+        }
+    }
+
+    return INTERNER_ERROR_SUCCESS;
+}
+
+enum InternerError interner_read(interner_t* const interner, const char* const filename)
+{
+    lassert(!is_invalid_ptr(interner), "");
+    lassert(!is_invalid_ptr(filename), "");
+
+    struct stat file_stat = {};
+    if (stat(filename, &file_stat))
+    {
+        perror("Can't stat names file");
+        return INTERNER_ERROR_STANDARD_ERRNO;
+    }
+
+    if (!file_stat.st_size)
+        return INTERNER_ERROR_SUCCESS;
+
+    wchar_t* text = NULL;
+    size_t text_size = 0;
+    if (str_from_file(filename, &text, &text_size))
+    {
+        fprintf(stderr, "Can't str_from_file\n");
+        return INTERNER_ERROR_STANDARD_ERRNO;
+    }
+
+    for (wchar_t* name = text; *name != L'\0'; )
+    {
+        wchar_t* const name_end = wcschr(name, L'\n');
+        if (!name_end)
+        {
+            fprintf(stderr, "Names file doesn't end with new line\n");
+            free(text);
+            return INTERNER_ERROR_INVALID_FILE;
+        }
+
+        const size_t expected_id = interner->size;
+        size_t id = 0;
+        INTERNER_ERROR_HANDLE(interner_intern(interner, name, (size_t)(name_end - name), &id),
+                                                                                        free(text););
+
+        if (id != expected_id)
+        {
+            fprintf(stderr, "Name '%ls' is repeated in names file\n", interner_get(interner, id));
+            free(text);
+            return INTERNER_ERROR_INVALID_FILE;
+        }
+
+        name = name_end + 1;
+    }
+
+    free(text); text = NULL;
+
+    return INTERNER_ERROR_SUCCESS;
+}
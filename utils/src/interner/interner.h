@@ -0,0 +1,59 @@
+#ifndef MASIK_UTILS_SRC_INTERNER_INTERNER_H
+#define MASIK_UTILS_SRC_INTERNER_INTERNER_H
+
+#include <stdio.h>
+#include <wchar.h>
+#include <assert.h>
+
+// Identifiers interner: equal names get equal ids, ids go from 0 in order of the first meeting.
+// Names lie one by one in one arena, each ends with L'\0'. Lookup is open addressing hash table
+// with ids, so interner_intern is O(len) expected.
+
+enum InternerError
+{
+    INTERNER_ERROR_SUCCESS          = 0,
+    INTERNER_ERROR_STANDARD_ERRNO   = 1,
+    INTERNER_ERROR_INVALID_FILE     = 2,
+};
+static_assert(INTERNER_ERROR_SUCCESS == 0);
+
+const char* interner_strerror(const enum InternerError error);
+
+#define INTERNER_ERROR_HANDLE(call_func, ...)                                                       \
+    do {                                                                                            \
+        enum InternerError error_handler = call_func;                                               \
+        if (error_handler)                                                                          \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Error: %s\n",                                     \
+                            interner_strerror(error_handler));                                      \
+            __VA_ARGS__                                                                             \
+            return error_handler;                                                                   \
+        }                                                                                           \
+    } while(0)
+
+typedef struct Interner
+{
+    wchar_t* arena;
+    size_t   arena_size;
+    size_t   arena_capacity;
+
+    size_t*  offsets;               // id -> name offset in arena
+    size_t   size;
+    size_t   offsets_capacity;
+
+    size_t*  table;                 // id + 1, 0 - empty
+    size_t   table_capacity;        // power of 2
+} interner_t;
+
+enum InternerError interner_ctor(interner_t* const interner);
+void               interner_dtor(interner_t* const interner);
+
+enum InternerError interner_intern(interner_t* const interner, const wchar_t* const name,
+                                   const size_t name_len, size_t* const id);
+const wchar_t*     interner_get   (const interner_t* const interner, const size_t id);
+
+// names table: name of id i on line i
+enum InternerError interner_print(const interner_t* const interner, FILE* out);
+enum InternerError interner_read (interner_t* const interner, const char* const filename);
+
+#endif /* MASIK_UTILS_SRC_INTERNER_INTERNER_H */
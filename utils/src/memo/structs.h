@@ -0,0 +1,29 @@
+#ifndef MASIK_UTILS_SRC_MEMO_STRUCTS_H
+#define MASIK_UTILS_SRC_MEMO_STRUCTS_H
+
+// Memoization of pure recursive functions. Midlend emits syscall blocks of masik runtime,
+// backend gives them the cache:
+//   memo_get(id, arg0, arg1)      - 1, if result of function id for args is cached, 0 otherwise
+//   memo_val()                    - result found by the last memo_get
+//   memo_put(val, id, arg0, arg1) - caches result, returns val
+// Args, that function doesn't have, are 0.
+// Cache is direct-mapped: entry {id + 1, arg0, arg1, val} is chosen by hash of the key,
+// so new result evicts the old one. Empty entry has 0 instead of id + 1.
+
+#define MEMO_GET_NAME           "memo_get"
+#define MEMO_VAL_NAME           "memo_val"
+#define MEMO_PUT_NAME           "memo_put"
+
+#define MEMO_GET_ARGS_CNT       (3)
+#define MEMO_VAL_ARGS_CNT       (0)
+#define MEMO_PUT_ARGS_CNT       (4)
+
+#define MEMO_ARGS_MAX           (2)
+
+#define MEMO_ENTRIES_LOG        (12)
+#define MEMO_ENTRIES            (1ul << MEMO_ENTRIES_LOG)
+
+// hash = (((id + 1) * MUL ^ arg0) * MUL ^ arg1) * MUL >> (64 - MEMO_ENTRIES_LOG)
+#define MEMO_HASH_MUL           (0x9E3779B97F4A7C15ul)
+
+#endif /* MASIK_UTILS_SRC_MEMO_STRUCTS_H */
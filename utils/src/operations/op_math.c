@@ -1,4 +1,4 @@
-#include <math.h>
+#include <stdint.h>
 
 #include "op_math.h"
 
@@ -25,9 +25,18 @@ num_t math_DIV(const num_t first, const num_t second)
     return first / second;
 }
 
+// the same, as pow routine of runtime: 64-bit wrapping square-and-multiply, power is unsigned
 num_t math_POW(const num_t first, const num_t second)
 {
-    return (num_t)powl((long double)first, (long double)second);
+    uint64_t res = 1;
+    for (uint64_t base = (uint64_t)first, power = (uint64_t)second; power; power >>= 1)
+    {
+        if (power & 1)
+            res *= base;
+        base *= base;
+    }
+
+    return (num_t)res;
 }
 
 num_t math_EQ(const num_t first, const num_t second)
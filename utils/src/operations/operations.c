@@ -1,6 +1,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <wchar.h>
+#include <stdint.h>
 
 #include "operations/operations.h"
 #include "logger/liblogger.h"
@@ -23,8 +24,9 @@ const char* op_type_to_str(const enum OpType type)
 }
 #undef OPERATION_HANDLE
 
-#define OPERATION_HANDLE(num_, name_, keyword_, is_ariphmetic_)                                                 \
-    (operation_t){.type = num_,  .keyword = keyword_, .is_ariphmetic = is_ariphmetic_},
+#define OPERATION_HANDLE(num_, name_, keyword_, is_ariphmetic_)                                     \
+    (operation_t){.type = num_,  .keyword = keyword_, .is_ariphmetic = is_ariphmetic_,              \
+                  .keyword_len = sizeof(keyword_) / sizeof(wchar_t) - 1},
 
 const operation_t OPERATIONS[] =
 {
@@ -34,15 +36,92 @@ const operation_t OPERATIONS[] =
 
 const size_t OPERATIONS_SIZE = sizeof(OPERATIONS) / sizeof(*OPERATIONS);
 
+// Keywords DFA. States are nodes of the keywords trie, transitions go by char class, class 0 is
+// the class of chars, that aren't in any keyword. State 0 is root, so transition to 0 means no way.
+// It is built once from OPERATIONS and find_op goes through the text only once with the longest
+// match. Equal keywords give the first one from codegen.h.
+
 #define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
-        if (wcsncmp(keyword_, str, wcslen(keyword_)) == 0) return OP_TYPE_##name_;
+    + sizeof(keyword_) / sizeof(wchar_t) - 1
+
+enum { KEYWORD_STATES_MAX_ = 1
+    #include "operations/codegen.h"
+};
+#undef OPERATION_HANDLE
+
+#define KEYWORD_CLASSES_MAX_    64
+#define KEYWORD_SYM_MAX_        0x500
+
+static uint16_t     keyword_dfa_   [KEYWORD_STATES_MAX_][KEYWORD_CLASSES_MAX_] = {};
+static enum OpType  keyword_accept_[KEYWORD_STATES_MAX_]                       = {};
+static uint8_t      keyword_class_ [KEYWORD_SYM_MAX_]                          = {};
+static bool         keyword_dfa_is_built_ = false;
+
+static size_t keyword_class_get_(const wchar_t sym)
+{
+    return (size_t)sym < KEYWORD_SYM_MAX_ ? keyword_class_[sym] : 0;
+}
+
+static void keyword_dfa_build_(void)
+{
+    for (size_t state = 0; state < KEYWORD_STATES_MAX_; ++state)
+        keyword_accept_[state] = OP_TYPE_UNKNOWN;
+
+    size_t states_cnt  = 1;
+    size_t classes_cnt = 1;
+
+    for (size_t op_ind = 0; op_ind < OPERATIONS_SIZE; ++op_ind)
+    {
+        size_t state = 0;
+
+        for (const wchar_t* sym = OPERATIONS[op_ind].keyword; *sym != L'\0'; ++sym)
+        {
+            lassert((size_t)*sym < KEYWORD_SYM_MAX_, "Keyword symbol is too big for keywords DFA");
+
+            if (!keyword_class_[*sym])
+            {
+                lassert(classes_cnt < KEYWORD_CLASSES_MAX_, "Too many symbols in keywords");
+                keyword_class_[*sym] = (uint8_t)classes_cnt++;
+            }
+
+            uint16_t* const next = &keyword_dfa_[state][keyword_class_[*sym]];
+            if (!*next)
+            {
+                lassert(states_cnt < KEYWORD_STATES_MAX_, "");
+                *next = (uint16_t)states_cnt++;
+            }
+
+            state = *next;
+        }
+
+        if (keyword_accept_[state] == OP_TYPE_UNKNOWN)
+            keyword_accept_[state] = OPERATIONS[op_ind].type;
+    }
+
+    keyword_dfa_is_built_ = true;
+}
 
 enum OpType find_op(const wchar_t* const str)
 {
     lassert(!is_invalid_ptr(str), "");
 
-    #include "operations/codegen.h"
+    if (!keyword_dfa_is_built_)
+        keyword_dfa_build_();
+
+    enum OpType op = OP_TYPE_UNKNOWN;
+    size_t state = 0;
+
+    for (const wchar_t* sym = str; *sym != L'\0'; ++sym)
+    {
+        state = keyword_dfa_[state][keyword_class_get_(*sym)];
+        if (!state)
+            break;
 
-    return OP_TYPE_UNKNOWN;
+        if (keyword_accept_[state] != OP_TYPE_UNKNOWN)
+            op = keyword_accept_[state];
+    }
+
+    return op;
 }
-#undef OPERATION_HANDLE
+#undef KEYWORD_SYM_MAX_
+#undef KEYWORD_CLASSES_MAX_
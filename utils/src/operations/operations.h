@@ -24,6 +24,7 @@ typedef struct Operation
 
     // const wchar_t* const name;
     const wchar_t* const keyword;
+    const size_t keyword_len;
 
     const bool is_ariphmetic;
 } operation_t;
@@ -31,6 +32,7 @@ typedef struct Operation
 extern const operation_t OPERATIONS[];
 extern const size_t OPERATIONS_SIZE;
 
+// longest keyword at the begin of str
 enum OpType find_op(const wchar_t* const str);
 
 #endif /* MASIK_UTILS_SRC_OPERATIONS_OPERATIONS_H  */
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef MASIK_UTILS_SRC_PYAM_BIN_STRUCTS_H
+#define MASIK_UTILS_SRC_PYAM_BIN_STRUCTS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <assert.h>
+
+// Binary form of PYAM IR: header, records, string table.
+// Records have fixed width, so the reader can use them right from the mmaped file.
+// Labels are offsets of '\0'-terminated strings in the string table.
+
+#define PYAM_BIN_MAGIC          "PYAMBIN"
+#define PYAM_BIN_MAGIC_SIZE     (8)
+#define PYAM_BIN_VERSION        (1u)
+#define PYAM_BIN_NO_LABEL       (UINT32_MAX)
+
+typedef struct PyamBinHeader
+{
+    char     magic[PYAM_BIN_MAGIC_SIZE];
+    uint32_t version;
+    uint32_t record_size;
+
+    uint64_t records_offset;
+    uint64_t records_cnt;
+
+    uint64_t strings_offset;
+    uint64_t strings_size;
+} pyam_bin_header_t;
+static_assert(sizeof(pyam_bin_header_t) == 48, "");
+
+typedef struct PyamBinRecord
+{
+    uint8_t  type;              // enum IrOpBlockType
+    uint8_t  ret_type;          // enum IrOperandType
+    uint8_t  label_type;
+    uint8_t  operation_type;
+    uint8_t  operand1_type;
+    uint8_t  operand2_type;
+    uint16_t reserved;
+
+    uint32_t operation_num;     // enum IrOpType
+    uint32_t label_offset;
+
+    uint64_t ret_num;
+    uint64_t operand1_num;
+    uint64_t operand2_num;
+} pyam_bin_record_t;
+static_assert(sizeof(pyam_bin_record_t) == 40, "");
+
+// records and string table lying in memory: in the mmaped file or in the midlend writer
+typedef struct PyamBinView
+{
+    const pyam_bin_record_t* records;
+    size_t                   records_cnt;
+
+    const char*              strings;
+    size_t                   strings_size;
+} pyam_bin_view_t;
+
+#endif /* MASIK_UTILS_SRC_PYAM_BIN_STRUCTS_H */
@@ -0,0 +1,231 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "logger/liblogger.h"
+#include "utils/utils.h"
+#include "tree/verification/verification.h"
+#include "tree/funcs/funcs.h"
+#include "stack_on_array/libstack.h"
+#include "ast_bin/structs.h"
+
+typedef struct AstBinBuffer
+{
+    uint8_t* data;
+    size_t   size;
+    size_t   capacity;
+    size_t   nodes_cnt;
+} ast_bin_buffer_t;
+
+static enum TreeError ast_bin_put_(ast_bin_buffer_t* const buffer, const uint8_t byte)
+{
+    lassert(!is_invalid_ptr(buffer), "");
+
+    if (buffer->size == buffer->capacity)
+    {
+        const size_t new_capacity = buffer->capacity ? buffer->capacity * 2 : 4096;
+        uint8_t* const new_data = realloc(buffer->data, new_capacity);
+        if (!new_data)
+        {
+            perror("Can't realloc ast bin buffer");
+            return TREE_ERROR_STANDARD_ERRNO;
+        }
+
+        buffer->data     = new_data;
+        buffer->capacity = new_capacity;
+    }
+
+    buffer->data[buffer->size++] = byte;
+
+    return TREE_ERROR_SUCCESS;
+}
+
+static enum TreeError tree_print_bin_elem_(const tree_elem_t* elem, void* const buffer)
+{
+    lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(buffer), "");
+
+    uint64_t value = 0;
+    switch (elem->lexem.type)
+    {
+        case LEXEM_TYPE_OP:  value = (uint64_t)elem->lexem.data.op;                             break;
+        case LEXEM_TYPE_VAR: value = (uint64_t)elem->lexem.data.var;                            break;
+        case LEXEM_TYPE_NUM:
+            value = ((uint64_t)elem->lexem.data.num << 1) ^ (uint64_t)(elem->lexem.data.num >> 63);
+            break;
+
+        case LEXEM_TYPE_END:
+        default:
+            return TREE_ERROR_INVALID_OP_TYPE;
+    }
+
+    const uint8_t tag = (uint8_t)(((unsigned)elem->lexem.type << AST_BIN_TAG_TYPE_SHIFT)
+                                | (elem->lt ? AST_BIN_TAG_LT : 0u)
+                                | (elem->rt ? AST_BIN_TAG_RT : 0u)
+                                | (value < AST_BIN_TAG_VALUE_BIG ? value : AST_BIN_TAG_VALUE_BIG));
+
+    TREE_ERROR_HANDLE(ast_bin_put_(buffer, tag));
+
+    if (value >= AST_BIN_TAG_VALUE_BIG)
+    {
+        value -= AST_BIN_TAG_VALUE_BIG;
+        for (; value >= 0x80; value >>= 7)
+        {
+            TREE_ERROR_HANDLE(ast_bin_put_(buffer, (uint8_t)(value | 0x80)));
+        }
+        TREE_ERROR_HANDLE(ast_bin_put_(buffer, (uint8_t)value));
+    }
+
+    ++((ast_bin_buffer_t*)buffer)->nodes_cnt;
+
+    return TREE_ERROR_SUCCESS;
+}
+
+enum TreeError tree_print_bin(const tree_t tree, FILE* out)
+{
+    TREE_VERIFY_ASSERT(&tree);
+    lassert(!is_invalid_ptr(out), "");
+
+    ast_bin_buffer_t buffer = {};
+    TREE_ERROR_HANDLE(tree_walk_pre(tree.Groot, tree_print_bin_elem_, &buffer),
+                                                                                 free(buffer.data););
+
+    ast_bin_header_t header = {
+        .version    = AST_BIN_VERSION,
+        .nodes_cnt  = buffer.nodes_cnt,
+        .nodes_size = buffer.size
+    };
+    memcpy(header.magic, AST_BIN_MAGIC, AST_BIN_MAGIC_SIZE);
+
+    if (fwrite(&header, sizeof(header), 1, out) != 1
+     || (buffer.size && fwrite(buffer.data, buffer.size, 1, out) != 1))
+    {
+        perror("Can't fwrite ast bin");
+        free(buffer.data);
+        return TREE_ERROR_STANDARD_ERRNO;
+    }
+
+    free(buffer.data);
+
+    return TREE_ERROR_SUCCESS;
+}
+
+bool tree_is_bin(const char* const data, const size_t data_size)
+{
+    lassert(!data_size || !is_invalid_ptr(data), "");
+
+    return data_size >= sizeof(ast_bin_header_t) && !memcmp(data, AST_BIN_MAGIC, AST_BIN_MAGIC_SIZE);
+}
+
+#define INVALID_BIN_(...)                                                                           \
+    do {                                                                                            \
+        fprintf(stderr, "Invalid binary AST: " __VA_ARGS__);                                        \
+        stack_dtor(&slots);                                                                         \
+        tree_pool_dtor(&tree->pool);                                                                \
+        *tree = (tree_t){};                                                                         \
+        return TREE_ERROR_INVALID_BIN;                                                              \
+    } while(0)
+
+// nodes are read in preorder, stack keeps slots of children to be read
+enum TreeError tree_ctor_bin(tree_t* const tree, const char* const data, const size_t data_size)
+{
+    lassert(!is_invalid_ptr(tree), "");
+    lassert(tree_is_bin(data, data_size), "");
+
+    ast_bin_header_t header = {};
+    memcpy(&header, data, sizeof(header));
+
+    if (header.version != AST_BIN_VERSION || header.nodes_size != data_size - sizeof(header))
+    {
+        fprintf(stderr, "Invalid binary AST header\n");
+        return TREE_ERROR_INVALID_BIN;
+    }
+
+    tree_pool_ctor(&tree->pool);
+    tree->Groot = NULL;
+    tree->size  = 0;
+
+    stack_key_t slots = 0;
+    if (STACK_CTOR(&slots, sizeof(tree_elem_t**), 64))
+    {
+        fprintf(stderr, "Can't ctor stack for tree_ctor_bin\n");
+        return TREE_ERROR_STACK;
+    }
+
+    const uint8_t*       cur = (const uint8_t*)data + sizeof(header);
+    const uint8_t* const end = cur + header.nodes_size;
+
+    tree_elem_t** slot = &tree->Groot;
+    if (header.nodes_cnt && stack_push(&slots, &slot))
+        INVALID_BIN_("can't push slot\n");
+
+    while (!stack_is_empty(slots))
+    {
+        if (stack_pop(&slots, &slot))
+            INVALID_BIN_("can't pop slot\n");
+
+        if (cur == end)
+            INVALID_BIN_("unexpected end\n");
+
+        const uint8_t tag = *cur++;
+
+        uint64_t value = tag & AST_BIN_TAG_VALUE_BIG;
+        if (value == AST_BIN_TAG_VALUE_BIG)
+        {
+            uint64_t varint = 0;
+            unsigned shift = 0;
+            for (;; shift += 7)
+            {
+                if (cur == end || shift > 63)
+                    INVALID_BIN_("broken varint\n");
+
+                varint |= (uint64_t)(*cur & 0x7F) << shift;
+                if (!(*cur++ & 0x80))
+                    break;
+            }
+            value += varint;
+        }
+
+        lexem_t lexem = {.type = (enum LexemType)(tag >> AST_BIN_TAG_TYPE_SHIFT)};
+        switch (lexem.type)
+        {
+            case LEXEM_TYPE_OP:
+                if (value >= OPERATIONS_SIZE)
+                    INVALID_BIN_("op %lu\n", value);
+                lexem.data.op = (enum OpType)value;
+                break;
+            case LEXEM_TYPE_VAR:
+                lexem.data.var = (size_t)value;
+                break;
+            case LEXEM_TYPE_NUM:
+                lexem.data.num = (num_t)((value >> 1) ^ (~(value & 1) + 1));
+                break;
+
+            case LEXEM_TYPE_END:
+            default:
+                INVALID_BIN_("lexem type %u\n", (unsigned)lexem.type);
+        }
+
+        tree_elem_t* const elem = tree_elem_ctor(&tree->pool, lexem, NULL, NULL);
+        if (!elem)
+            INVALID_BIN_("can't ctor elem\n");
+
+        *slot = elem;
+        ++tree->size;
+
+        tree_elem_t** const rt = &elem->rt;
+        tree_elem_t** const lt = &elem->lt;
+        if ((tag & AST_BIN_TAG_RT) && stack_push(&slots, &rt))
+            INVALID_BIN_("can't push slot\n");
+        if ((tag & AST_BIN_TAG_LT) && stack_push(&slots, &lt))
+            INVALID_BIN_("can't push slot\n");
+    }
+
+    if (cur != end || tree->size != header.nodes_cnt)
+        INVALID_BIN_("%zu nodes read, %lu expected\n", tree->size, header.nodes_cnt);
+
+    stack_dtor(&slots);
+
+    return TREE_ERROR_SUCCESS;
+}
+#undef INVALID_BIN_
@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
 
 #include "logger/liblogger.h"
 #include "utils/utils.h"
@@ -22,16 +23,72 @@ const char* lexem_type_to_str(const enum LexemType type)
 }
 
 
-tree_elem_t* tree_elem_ctor(lexem_t lexem, tree_elem_t* lt, tree_elem_t* rt)
+void tree_pool_ctor(tree_pool_t* const pool)
 {
-    tree_elem_t* elem = calloc(1, sizeof(tree_elem_t));
+    lassert(!is_invalid_ptr(pool), "");
 
-    if (!elem)
+    *pool = (tree_pool_t){};
+}
+
+void tree_pool_dtor(tree_pool_t* const pool)
+{
+    lassert(!is_invalid_ptr(pool), "");
+
+    while (pool->chunks)
     {
-        perror("Can't calloc elem");
-        return NULL;
+        tree_pool_chunk_t* const next = pool->chunks->next;
+        free(pool->chunks);
+        pool->chunks = next;
+    }
+
+    pool->chunk_used = 0;
+    pool->free_list  = NULL;
+}
+
+void tree_pool_print_stats(const tree_pool_t* const pool, const char* const stage, FILE* out)
+{
+    lassert(!is_invalid_ptr(pool), "");
+    lassert(!is_invalid_ptr(stage), "");
+    lassert(!is_invalid_ptr(out), "");
+
+    fprintf(out, "%s tree: %zu nodes (%zu reused), %zu bytes\n",
+            stage, pool->nodes_cnt, pool->nodes_reused_cnt, pool->bytes_cnt);
+}
+
+tree_elem_t* tree_elem_ctor(tree_pool_t* const pool, lexem_t lexem, tree_elem_t* lt, tree_elem_t* rt)
+{
+    lassert(!is_invalid_ptr(pool), "");
+
+    tree_elem_t* elem = NULL;
+
+    if (pool->free_list)
+    {
+        elem = pool->free_list;
+        pool->free_list = elem->lt;
+        ++pool->nodes_reused_cnt;
+    }
+    else
+    {
+        if (!pool->chunks || pool->chunk_used == TREE_POOL_CHUNK_SIZE)
+        {
+            tree_pool_chunk_t* const chunk = calloc(1, sizeof(tree_pool_chunk_t));
+            if (!chunk)
+            {
+                perror("Can't calloc tree pool chunk");
+                return NULL;
+            }
+
+            chunk->next       = pool->chunks;
+            pool->chunks      = chunk;
+            pool->chunk_used  = 0;
+            pool->bytes_cnt  += sizeof(tree_pool_chunk_t);
+        }
+
+        elem = pool->chunks->elems + pool->chunk_used++;
     }
 
+    ++pool->nodes_cnt;
+
     elem->lexem = lexem;
     elem->lt    = lt;
     elem->rt    = rt;
@@ -39,41 +96,117 @@ tree_elem_t* tree_elem_ctor(lexem_t lexem, tree_elem_t* lt, tree_elem_t* rt)
     return elem;
 }
 
-void tree_elem_dtor(tree_elem_t** elem)
+void tree_elem_dtor(tree_pool_t* const pool, tree_elem_t** elem)
 {
+    lassert(!is_invalid_ptr(pool), "");
     lassert(!is_invalid_ptr(elem), "");
 
     if (!*elem) return;
 
     lassert(!is_invalid_ptr(*elem), "");
 
-    free(*elem); *elem = NULL;
+    IF_DEBUG((*elem)->lexem = (lexem_t){};)
+    (*elem)->rt = NULL;
+    (*elem)->lt = pool->free_list;
+    pool->free_list = *elem;
+
+    *elem = NULL;
 }
 
-void tree_elem_dtor_recursive(tree_elem_t** elem)
+// without stack, if it can't be allocated. Depth of recursion is the depth of subtree
+static size_t elem_dtor_by_recursion_(tree_pool_t* const pool, tree_elem_t* elem)
 {
+    if (!elem) return 0;
+
+    const size_t count_dtored = 1 + elem_dtor_by_recursion_(pool, elem->lt)
+                                  + elem_dtor_by_recursion_(pool, elem->rt);
+
+    tree_elem_dtor(pool, &elem);
+
+    return count_dtored;
+}
+
+size_t tree_elem_dtor_recursive(tree_pool_t* const pool, tree_elem_t** elem)
+{
+    lassert(!is_invalid_ptr(pool), "");
     lassert(!is_invalid_ptr(elem), "");
 
-    if (!*elem) return;
+    if (!*elem) return 0;
 
     lassert(!is_invalid_ptr(*elem), "");
 
-    tree_elem_dtor_recursive(&(*elem)->lt);
-    tree_elem_dtor_recursive(&(*elem)->rt);
+    tree_elem_t* cur = *elem;
+    *elem = NULL;
+
+    stack_key_t stack = 0;
+    if (STACK_CTOR(&stack, sizeof(tree_elem_t*), 64))
+        return elem_dtor_by_recursion_(pool, cur);
+
+    // pushed child is detached, so after failed push cur and stack hold disjoint subtrees
+    size_t count_dtored = 0;
+    bool is_failed = false;
+    for (;;)
+    {
+        if (cur->lt)
+        {
+            if ((is_failed = stack_push(&stack, &cur->lt))) break;
+            cur->lt = NULL;
+        }
+        if (cur->rt)
+        {
+            if ((is_failed = stack_push(&stack, &cur->rt))) break;
+            cur->rt = NULL;
+        }
+
+        tree_elem_dtor(pool, &cur);
+        ++count_dtored;
+
+        if (stack_is_empty(stack) || stack_pop(&stack, &cur)) break;
+    }
+
+    if (is_failed)
+    {
+        count_dtored += elem_dtor_by_recursion_(pool, cur);
+
+        while (!stack_is_empty(stack) && !stack_pop(&stack, &cur))
+            count_dtored += elem_dtor_by_recursion_(pool, cur);
+    }
+
+    stack_dtor(&stack);
 
-    tree_elem_dtor(elem);
+    return count_dtored;
 }
 
 
 static size_t size_ = 0;
 
-tree_elem_t* tree_ctor_recursive_(wchar_t** token, wchar_t** buffer);
+tree_elem_t* tree_ctor_elems_(tree_pool_t* const pool, wchar_t** token, wchar_t** buffer);
 
 enum TreeError tree_ctor(tree_t* tree, const char* const filename)
 {
     TREE_VERIFY_ASSERT(tree);
     lassert(!is_invalid_ptr(filename), "");
 
+    const char* data = NULL;
+    size_t data_size = 0;
+    if (map_file(filename, &data, &data_size))
+    {
+        fprintf(stderr, "Can't map_file\n");
+        return TREE_ERROR_STANDARD_ERRNO;
+    }
+
+    if (tree_is_bin(data, data_size))
+    {
+        TREE_ERROR_HANDLE(tree_ctor_bin(tree, data, data_size),
+                                                          munmap((void*)(uintptr_t)data, data_size););
+
+        munmap((void*)(uintptr_t)data, data_size);
+        return TREE_ERROR_SUCCESS;
+    }
+
+    if (data_size)
+        munmap((void*)(uintptr_t)data, data_size);
+
     wchar_t* text = NULL;
     size_t text_size = 0;
     if (str_from_file(filename, &text, &text_size))
@@ -88,7 +221,8 @@ enum TreeError tree_ctor(tree_t* tree, const char* const filename)
     wchar_t* token = wcstok(text, L" ", &buffer);
 
     size_ = 0;
-    tree->Groot = tree_ctor_recursive_(&token, &buffer);
+    tree_pool_ctor(&tree->pool);
+    tree->Groot = tree_ctor_elems_(&tree->pool, &token, &buffer);
     tree->size = size_;
 
     lassert(token == NULL, "");
@@ -100,51 +234,91 @@ enum TreeError tree_ctor(tree_t* tree, const char* const filename)
 
 lexem_t tree_ctor_lexem_(wchar_t** token, wchar_t** buffer);
 
+// node whose children are being read
+typedef struct TreeCtorFrame
+{
+    lexem_t lexem;
+    size_t count;
+    size_t readed;
+    tree_elem_t* children[2];
+} tree_ctor_frame_t;
+
 #define NEXT_TOKEN_                                                                                 \
     do {                                                                                            \
-        if (!*token) {fprintf(stderr, "Incorrect tree in file\n"); return NULL;}                    \
+        if (!*token)                                                                                \
+        {                                                                                           \
+            fprintf(stderr, "Incorrect tree in file\n");                                            \
+            stack_dtor(&stack);                                                                     \
+            return NULL;                                                                            \
+        }                                                                                           \
         *token = wcstok(NULL, L" ", buffer);                                                        \
     } while (0)
 
-tree_elem_t* tree_ctor_recursive_(wchar_t** token, wchar_t** buffer)
+#define STACK_CALL_(call_)                                                                          \
+    do {                                                                                            \
+        if (call_)                                                                                  \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_ "\n");                                                  \
+            stack_dtor(&stack);                                                                     \
+            return NULL;                                                                            \
+        }                                                                                           \
+    } while (0)
+
+// preorder "lexem count children..." with explicit stack of unfinished nodes
+tree_elem_t* tree_ctor_elems_(tree_pool_t* const pool, wchar_t** token, wchar_t** buffer)
 {
+    lassert(!is_invalid_ptr(pool), "");
     lassert(!is_invalid_ptr(buffer), "");
     lassert(!is_invalid_ptr(token), "");
-    lassert(!is_invalid_ptr(*token), "");
 
-    ++size_;
+    stack_key_t stack = 0;
+    if (STACK_CTOR(&stack, sizeof(tree_ctor_frame_t), 64))
+    {
+        fprintf(stderr, "Can't ctor stack for tree_ctor\n");
+        return NULL;
+    }
 
-    lexem_t lexem = tree_ctor_lexem_(token, buffer);
-    // fprintf(stderr, "token: %ls\n", token);
-    
-    size_t count = 0;
-    swscanf(*token, L"%zu ", &count);
-    NEXT_TOKEN_;
+    for (;;)
+    {
+        lassert(!is_invalid_ptr(*token), "");
 
-    tree_elem_t* lt = NULL;
-    tree_elem_t* rt = NULL;
+        ++size_;
 
-    if (count > 0)
-    {
-        lt = tree_ctor_recursive_(token, buffer);
-        if (!lt)
+        tree_ctor_frame_t frame = {.lexem = tree_ctor_lexem_(token, buffer)};
+
+        swscanf(*token, L"%zu ", &frame.count);
+        NEXT_TOKEN_;
+
+        if (frame.count > 0)
         {
-            return NULL;
+            STACK_CALL_(stack_push(&stack, &frame));
+            continue;
         }
-    }
-    
-    if (count > 1)
-    {
-        rt = tree_ctor_recursive_(token, buffer);
-        if (!rt)
+
+        tree_elem_t* elem = tree_elem_ctor(pool, frame.lexem, NULL, NULL);
+
+        // finished node completes its parent, maybe several in a row
+        for (;;)
         {
-            tree_elem_dtor_recursive(&lt);
-            return NULL;
+            if (stack_is_empty(stack))
+            {
+                stack_dtor(&stack);
+                return elem;
+            }
+
+            tree_ctor_frame_t* const parent = (tree_ctor_frame_t*)stack_get(stack, stack_size(stack) - 1);
+            parent->children[parent->readed++] = elem;
+
+            if (parent->readed < parent->count && parent->readed < 2)
+                break;
+
+            STACK_CALL_(stack_pop(&stack, &frame));
+            elem = tree_elem_ctor(pool, frame.lexem, frame.children[0], frame.children[1]);
         }
     }
-    return tree_elem_ctor(lexem, lt, rt);
 }
 
+#undef STACK_CALL_
 #undef NEXT_TOKEN_
 #define NEXT_TOKEN_                                                                                 \
     do {                                                                                            \
@@ -198,11 +372,12 @@ void tree_dtor(tree_t* const tree)
 {
     TREE_VERIFY_ASSERT(tree);
 
-    tree_elem_dtor_recursive(&tree->Groot);
+    tree_pool_dtor(&tree->pool);
+    tree->Groot = NULL;
     tree->size = 0;
 }
 
-enum TreeError tree_print_recursive_(const tree_elem_t* elem, FILE* out);
+enum TreeError tree_print_elem_(const tree_elem_t* elem, void* out);
 enum TreeError tree_print_lexem_(const lexem_t lexem, FILE* out);
 
 enum TreeError tree_print(const tree_t tree, FILE* out)
@@ -210,17 +385,15 @@ enum TreeError tree_print(const tree_t tree, FILE* out)
     TREE_VERIFY_ASSERT(&tree);
     lassert(!is_invalid_ptr(out), "");
 
-    TREE_ERROR_HANDLE(tree_print_recursive_(tree.Groot, out));
+    TREE_ERROR_HANDLE(tree_walk_pre(tree.Groot, tree_print_elem_, out));
 
     // fprintf(out, "");
 
     return TREE_ERROR_SUCCESS;
 }
 
-enum TreeError tree_print_recursive_(const tree_elem_t* elem, FILE* out)
+enum TreeError tree_print_elem_(const tree_elem_t* elem, void* out)
 {
-    if (!elem) return TREE_ERROR_SUCCESS;
-
     lassert(!is_invalid_ptr(elem), "");
     lassert(!is_invalid_ptr(out), "");
     
@@ -229,9 +402,6 @@ enum TreeError tree_print_recursive_(const tree_elem_t* elem, FILE* out)
     size_t count = (size_t)(elem->lt != NULL) + (size_t)(elem->rt != NULL);
     fprintf(out, "%zu ", count);
 
-    TREE_ERROR_HANDLE(tree_print_recursive_(elem->lt, out));
-    TREE_ERROR_HANDLE(tree_print_recursive_(elem->rt, out));
-
     return TREE_ERROR_SUCCESS;
 }
 
@@ -270,20 +440,28 @@ enum TreeError tree_print_lexem_(const lexem_t lexem, FILE* out)
     return TREE_ERROR_SUCCESS;
 }
 
-size_t tree_size_(const tree_elem_t* const elem);
+enum TreeError tree_size_elem_(const tree_elem_t* elem, void* size);
 
 void tree_update_size(tree_t* const tree)
 {
     lassert(!is_invalid_ptr(tree), "");
 
-    tree->size = tree_size_(tree->Groot);
+    size_t size = 0;
+    if (tree_walk_pre(tree->Groot, tree_size_elem_, &size))
+    {
+        fprintf(stderr, "Can't count tree size\n");
+        return;
+    }
+
+    tree->size = size;
 }
 
-size_t tree_size_(const tree_elem_t* const elem)
+enum TreeError tree_size_elem_(const tree_elem_t* elem, void* size)
 {
-    if (!elem) return 0;
-
     lassert(!is_invalid_ptr(elem), "");
+    lassert(!is_invalid_ptr(size), "");
+
+    ++*(size_t*)size;
 
-    return 1 + tree_size_(elem->lt) + tree_size_(elem->rt);
-}
\ No newline at end of file
+    return TREE_ERROR_SUCCESS;
+}
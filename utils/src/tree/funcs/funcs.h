@@ -3,18 +3,42 @@
 
 #include "utils/src/tree/structs.h"
 #include "utils/src/tree/verification/verification.h"
+#include "stack_on_array/libstack.h"
 
 const char* lexem_type_to_str(const enum LexemType type);
 
-tree_elem_t*   tree_elem_ctor(lexem_t lexem, tree_elem_t* lt, tree_elem_t* rt);
-void           tree_elem_dtor          (tree_elem_t** elem);
-void           tree_elem_dtor_recursive(tree_elem_t** elem);
+void           tree_pool_ctor(tree_pool_t* const pool);
+void           tree_pool_dtor(tree_pool_t* const pool);
+void           tree_pool_print_stats(const tree_pool_t* const pool, const char* const stage, FILE* out);
 
+tree_elem_t*   tree_elem_ctor(tree_pool_t* const pool, lexem_t lexem, tree_elem_t* lt, tree_elem_t* rt);
+void           tree_elem_dtor          (tree_pool_t* const pool, tree_elem_t** elem);
+// returns count of dtored elems
+size_t         tree_elem_dtor_recursive(tree_pool_t* const pool, tree_elem_t** elem);
+
+// file is binary AST (utils/src/ast_bin/structs.h) or text from tree_print, checked by magic
 enum TreeError tree_ctor(tree_t* tree, const char* const filename);
 void           tree_dtor(tree_t* const tree);
 
 enum TreeError tree_print(const tree_t tree, FILE* out);
 
+bool           tree_is_bin   (const char* const data, const size_t data_size);
+enum TreeError tree_ctor_bin (tree_t* const tree, const char* const data, const size_t data_size);
+enum TreeError tree_print_bin(const tree_t tree, FILE* out);
+
 void tree_update_size(tree_t* const tree);
 
+// walks use explicit stack, so C stack doesn't grow with tree depth (statements chain is left-deep)
+typedef enum TreeError (*tree_visit_t)     (const tree_elem_t* elem, void* arg);
+typedef enum TreeError (*tree_visit_slot_t)(tree_elem_t** elem, void* arg);
+
+enum TreeError tree_walk_pre (const tree_elem_t* const root, const tree_visit_t visit, void* const arg);
+// visit may replace *elem, its children are already visited. is_descend NULL - descend everywhere
+enum TreeError tree_walk_post(tree_elem_t** const root, bool (*is_descend)(const tree_elem_t* elem),
+                              const tree_visit_slot_t visit, void* const arg);
+
+// push operands of op(op(a, b), c) to items of const tree_elem_t* as a, b, c
+enum TreeError tree_chain_collect(stack_key_t* const items, const tree_elem_t* elem,
+                                  const enum OpType op);
+
 #endif /* MASIK_UTILS_SRC_TREE_FUNCS_FUNCS_H */
\ No newline at end of file
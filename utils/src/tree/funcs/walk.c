@@ -0,0 +1,130 @@
+#include <stdio.h>
+
+#include "logger/liblogger.h"
+#include "utils/utils.h"
+#include "tree/verification/verification.h"
+#include "tree/funcs/funcs.h"
+#include "stack_on_array/libstack.h"
+
+#define STACK_ERROR_HANDLE_(call_func, ...)                                                         \
+    do {                                                                                            \
+        const enum StackError stack_error_handler = call_func;                                      \
+        if (stack_error_handler)                                                                    \
+        {                                                                                           \
+            fprintf(stderr, "Can't " #call_func". Stack error: %s\n",                               \
+                            stack_strerror(stack_error_handler));                                   \
+            __VA_ARGS__                                                                             \
+            return TREE_ERROR_STACK;                                                                \
+        }                                                                                           \
+    } while(0)
+
+#define WALK_BEGIN_CAPACITY_ 64
+
+enum TreeError tree_walk_pre(const tree_elem_t* const root, const tree_visit_t visit, void* const arg)
+{
+    lassert(visit, "");
+
+    if (!root)
+        return TREE_ERROR_SUCCESS;
+
+    stack_key_t stack = 0;
+    STACK_ERROR_HANDLE_(STACK_CTOR(&stack, sizeof(const tree_elem_t*), WALK_BEGIN_CAPACITY_));
+    STACK_ERROR_HANDLE_(stack_push(&stack, &root),                                 stack_dtor(&stack););
+
+    while (!stack_is_empty(stack))
+    {
+        const tree_elem_t* elem = NULL;
+        STACK_ERROR_HANDLE_(stack_pop(&stack, &elem),                              stack_dtor(&stack););
+
+        TREE_ERROR_HANDLE(visit(elem, arg),                                        stack_dtor(&stack););
+
+        if (elem->rt)
+            STACK_ERROR_HANDLE_(stack_push(&stack, &elem->rt),                     stack_dtor(&stack););
+        if (elem->lt)
+            STACK_ERROR_HANDLE_(stack_push(&stack, &elem->lt),                     stack_dtor(&stack););
+    }
+
+    stack_dtor(&stack);
+
+    return TREE_ERROR_SUCCESS;
+}
+
+typedef struct WalkFrame
+{
+    tree_elem_t** elem;
+    bool is_children_done;
+} walk_frame_t;
+
+enum TreeError tree_walk_post(tree_elem_t** const root, bool (*is_descend)(const tree_elem_t* elem),
+                              const tree_visit_slot_t visit, void* const arg)
+{
+    lassert(!is_invalid_ptr(root), "");
+    lassert(visit, "");
+
+    if (!*root)
+        return TREE_ERROR_SUCCESS;
+
+    stack_key_t stack = 0;
+    STACK_ERROR_HANDLE_(STACK_CTOR(&stack, sizeof(walk_frame_t), WALK_BEGIN_CAPACITY_));
+
+    walk_frame_t frame = {.elem = root, .is_children_done = false};
+    STACK_ERROR_HANDLE_(stack_push(&stack, &frame),                                stack_dtor(&stack););
+
+    while (!stack_is_empty(stack))
+    {
+        STACK_ERROR_HANDLE_(stack_pop(&stack, &frame),                             stack_dtor(&stack););
+
+        tree_elem_t* const elem = *frame.elem;
+
+        if (!frame.is_children_done && (!is_descend || is_descend(elem)))
+        {
+            frame.is_children_done = true;
+            STACK_ERROR_HANDLE_(stack_push(&stack, &frame),                        stack_dtor(&stack););
+
+            // lt is pushed last to be visited first
+            walk_frame_t child = {.elem = &elem->rt, .is_children_done = false};
+            if (elem->rt)
+                STACK_ERROR_HANDLE_(stack_push(&stack, &child),                    stack_dtor(&stack););
+
+            child.elem = &elem->lt;
+            if (elem->lt)
+                STACK_ERROR_HANDLE_(stack_push(&stack, &child),                    stack_dtor(&stack););
+
+            continue;
+        }
+
+        TREE_ERROR_HANDLE(visit(frame.elem, arg),                                  stack_dtor(&stack););
+    }
+
+    stack_dtor(&stack);
+
+    return TREE_ERROR_SUCCESS;
+}
+#undef WALK_BEGIN_CAPACITY_
+
+enum TreeError tree_chain_collect(stack_key_t* const items, const tree_elem_t* elem,
+                                  const enum OpType op)
+{
+    lassert(!is_invalid_ptr(items), "");
+
+    const size_t items_begin = stack_size(*items);
+
+    for (; elem && elem->lexem.type == LEXEM_TYPE_OP && elem->lexem.data.op == op; elem = elem->lt)
+    {
+        STACK_ERROR_HANDLE_(stack_push(items, &elem->rt));
+    }
+    STACK_ERROR_HANDLE_(stack_push(items, &elem));
+
+    // operands were pushed from the last one
+    for (size_t lt = items_begin, rt = stack_size(*items) - 1; lt < rt; ++lt, --rt)
+    {
+        const tree_elem_t** const lt_item = (const tree_elem_t**)stack_get(*items, lt);
+        const tree_elem_t** const rt_item = (const tree_elem_t**)stack_get(*items, rt);
+
+        const tree_elem_t* const temp = *lt_item;
+        *lt_item = *rt_item;
+        *rt_item = temp;
+    }
+
+    return TREE_ERROR_SUCCESS;
+}
@@ -42,10 +42,32 @@ typedef struct TreeElem
     struct TreeElem* rt;
 } tree_elem_t;
 
+// Elems are taken from chunks of TREE_POOL_CHUNK_SIZE elems, dtored elems go to free list
+// (linked by lt) and are reused. All chunks are freed at once in tree_pool_dtor.
+#define TREE_POOL_CHUNK_SIZE 1024
+
+typedef struct TreePoolChunk
+{
+    struct TreePoolChunk* next;
+    tree_elem_t elems[TREE_POOL_CHUNK_SIZE];
+} tree_pool_chunk_t;
+
+typedef struct TreePool
+{
+    tree_pool_chunk_t* chunks;
+    size_t chunk_used;
+    tree_elem_t* free_list;
+
+    size_t nodes_cnt;
+    size_t nodes_reused_cnt;
+    size_t bytes_cnt;
+} tree_pool_t;
+
 typedef struct Tree
 {
     tree_elem_t* Groot;
     size_t size;
+    tree_pool_t pool;
 } tree_t;
 
 
@@ -5,6 +5,7 @@
 #include <string.h>
 
 #include "tree/verification/dumb.h"
+#include "tree/funcs/funcs.h"
 #include "logger/liblogger.h"
 #include "utils/utils.h"
 
@@ -343,8 +344,14 @@ static const char* handle_invalid_ptr_(const void* const check_ptr)
     return "MIPT SHIT";
 }
 
-int create_tree_dot_recursive_(const tree_elem_t* const elem, const size_t size, 
-                                   size_t* const cur_size);
+// walk stops with TREE_ERROR_SIZE_LESSER after tree size nodes, so broken tree can't loop the dump
+typedef struct DotState
+{
+    size_t size;
+    size_t cur_size;
+} dot_state_t;
+
+enum TreeError create_tree_dot_elem_(const tree_elem_t* const elem, void* const state);
 
 int create_tree_dot_(const tree_t* const syntaxer)
 {
@@ -354,11 +361,12 @@ int create_tree_dot_(const tree_t* const syntaxer)
                               "rankdir=TB;\n"
                               "node[style = filled]\n");
 
-    size_t size = 0;
+    dot_state_t state = {.size = syntaxer->size, .cur_size = 0};
 
-    if (create_tree_dot_recursive_(syntaxer->Groot, syntaxer->size, &size))
+    const enum TreeError error = tree_walk_pre(syntaxer->Groot, create_tree_dot_elem_, &state);
+    if (error && error != TREE_ERROR_SIZE_LESSER)
     {
-        fprintf(stderr, "Can't create syntaxer dot recursive\n");
+        fprintf(stderr, "Can't create syntaxer dot\n");
         return -1;
     }
 
@@ -369,33 +377,24 @@ int create_tree_dot_(const tree_t* const syntaxer)
 
 int dot_print_node_(const tree_elem_t* const elem);
 
-int create_tree_dot_recursive_(const tree_elem_t* const elem, const size_t size, 
-                                   size_t* const cur_size)
+enum TreeError create_tree_dot_elem_(const tree_elem_t* const elem, void* const state)
 {
-    if (*cur_size >= size)      return  0;
-    if (is_invalid_ptr(elem))   return -1;
+    dot_state_t* const dot_state = (dot_state_t*)state;
 
-    ++*cur_size;
+    if (dot_state->cur_size >= dot_state->size) return TREE_ERROR_SIZE_LESSER;
+    if (is_invalid_ptr(elem))                   return TREE_ERROR_ELEM_IS_INVALID;
 
-    dot_print_node_(elem);
+    ++dot_state->cur_size;
 
-    const tree_elem_t* const parent_ptr = elem;
+    dot_print_node_(elem);
 
     if (elem->lt)
-    {
-        fprintf(DUMBER_.dot_file, "node%p -> node%p [color=red]\n",  parent_ptr, elem->lt);
-        if (create_tree_dot_recursive_(elem->lt, size, cur_size))
-            return -1;
-    }
+        fprintf(DUMBER_.dot_file, "node%p -> node%p [color=red]\n",  elem, elem->lt);
 
     if (elem->rt)
-    {
-        fprintf(DUMBER_.dot_file, "node%p -> node%p [color=green]\n",parent_ptr, elem->rt);
-        if (create_tree_dot_recursive_(elem->rt, size, cur_size))
-            return -1;
-    }
+        fprintf(DUMBER_.dot_file, "node%p -> node%p [color=green]\n",elem, elem->rt);
 
-    return 0;
+    return TREE_ERROR_SUCCESS;
 }
 
 int dot_print_node_(const tree_elem_t* const elem)
@@ -4,6 +4,7 @@
 #include "utils/utils.h"
 #include "logger/liblogger.h"
 #include "tree/structs.h"
+#include "tree/funcs/funcs.h"
 
 
 #define CASE_ENUM_TO_STRING_(error) case error: return #error
@@ -22,6 +23,7 @@ const char* tree_strerror(const enum TreeError error)
         CASE_ENUM_TO_STRING_(TREE_ERROR_SIZE_LESSER);
         CASE_ENUM_TO_STRING_(TREE_ERROR_INVALID_OP_TYPE);
         CASE_ENUM_TO_STRING_(TREE_ERROR_INVALID_DATA_NUM);
+        CASE_ENUM_TO_STRING_(TREE_ERROR_INVALID_BIN);
         CASE_ENUM_TO_STRING_(TREE_ERROR_UNKNOWN);
 
         default:
@@ -31,7 +33,7 @@ const char* tree_strerror(const enum TreeError error)
 }
 #undef CASE_ENUM_TO_STRING_
 
-enum TreeError tree_verify_recursive_(const tree_elem_t* const elem, size_t* const size);
+enum TreeError tree_verify_elem_(const tree_elem_t* const elem, void* const size);
 
 enum TreeError tree_verify(const tree_t* const syntaxer)
 {
@@ -49,7 +51,7 @@ enum TreeError tree_verify(const tree_t* const syntaxer)
 
     size_t size = 0;
 
-    TREE_ERROR_HANDLE(tree_verify_recursive_(syntaxer->Groot, &size));
+    TREE_ERROR_HANDLE(tree_walk_pre(syntaxer->Groot, tree_verify_elem_, &size));
 
     if (syntaxer->size > size) return TREE_ERROR_SIZE_GREATER;
     if (syntaxer->size < size) return TREE_ERROR_SIZE_LESSER;
@@ -60,10 +62,8 @@ enum TreeError tree_verify(const tree_t* const syntaxer)
 #define OPERATION_HANDLE(num_, name_, keyword_, ...)                                                \
         case num_: break;
 
-enum TreeError tree_verify_recursive_(const tree_elem_t* const elem, size_t* const size)
+enum TreeError tree_verify_elem_(const tree_elem_t* const elem, void* const size)
 {
-    if (!elem) return TREE_ERROR_SUCCESS;
-
     switch (is_invalid_ptr(elem))
     {
         case PTR_STATES_VALID:       break;
@@ -88,10 +88,7 @@ enum TreeError tree_verify_recursive_(const tree_elem_t* const elem, size_t* con
         }
     }
 
-    ++*size;
-
-    TREE_ERROR_HANDLE(tree_verify_recursive_(elem->lt, size));
-    TREE_ERROR_HANDLE(tree_verify_recursive_(elem->rt, size));
+    ++*(size_t*)size;
 
     return TREE_ERROR_SUCCESS;
 }
@@ -1,3 +1,5 @@
+#define _GNU_SOURCE // process_vm_readv
+
 #include <stdlib.h>
 #include <errno.h>
 #include <stdio.h>
@@ -9,52 +11,184 @@
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
+#include <time.h>
 
 #include "utils.h"
 #include "logger/liblogger.h"
 
-enum PtrState is_invalid_ptr(const void* ptr)
+// Levels of is_invalid_ptr, set by -DPTR_CHECK_LEVEL=N:
+// 0 - only NULL check, release default
+// 1 - NULL check and binary search in cached readable ranges of /proc/self/maps, debug default.
+//     Cache is reread only on miss, so valid pointers are O(log ranges) without syscalls.
+//     Range unmapped after caching is still valid for it.
+// 2 - NULL check and process_vm_readv of one byte: one syscall per call, exact
+#ifndef PTR_CHECK_LEVEL
+#ifndef NDEBUG
+#define PTR_CHECK_LEVEL 1
+#else /*NDEBUG*/
+#define PTR_CHECK_LEVEL 0
+#endif /*NDEBUG*/
+#endif /*PTR_CHECK_LEVEL*/
+
+#if PTR_CHECK_LEVEL == 1
+
+typedef struct PtrRange
 {
-    errno = 0;
-    if (ptr == NULL)
+    uintptr_t begin;
+    uintptr_t end;
+} ptr_range_t;
+
+static ptr_range_t* ptr_ranges_          = NULL;
+static size_t       ptr_ranges_size_     = 0;
+static size_t       ptr_ranges_capacity_ = 0;
+
+// lassert can't be used here, it calls is_invalid_ptr
+static int ptr_ranges_push_(const uintptr_t begin, const uintptr_t end)
+{
+    if (ptr_ranges_size_ && ptr_ranges_[ptr_ranges_size_ - 1].end == begin)
     {
-        return PTR_STATES_NULL;
+        ptr_ranges_[ptr_ranges_size_ - 1].end = end;
+        return 0;
+    }
+
+    if (ptr_ranges_size_ == ptr_ranges_capacity_)
+    {
+        const size_t new_capacity = ptr_ranges_capacity_ ? 2 * ptr_ranges_capacity_ : 256;
+        ptr_range_t* const new_ranges = realloc(ptr_ranges_, new_capacity * sizeof(*ptr_ranges_));
+        if (!new_ranges)
+        {
+            perror("Can't realloc ptr_ranges_");
+            return -1;
+        }
+
+        ptr_ranges_          = new_ranges;
+        ptr_ranges_capacity_ = new_capacity;
     }
 
-    char filename[] = "/tmp/chupapi_munyanya.XXXXXX";
-    const int fd = mkstemp(filename);
+    ptr_ranges_[ptr_ranges_size_++] = (ptr_range_t){.begin = begin, .end = end};
+
+    return 0;
+}
 
-    if (fd == -1) 
+#define MAPS_BUFFER_SIZE_ 4096
+// /proc/self/maps is sorted by address, adjacent readable ranges are merged
+static int ptr_ranges_update_(void)
+{
+    const int fd = open("/proc/self/maps", O_RDONLY);
+    if (fd == -1)
     {
-        perror("Can't mkstemp file");
-        return PTR_STATES_ERROR;
+        perror("Can't open /proc/self/maps");
+        return -1;
     }
-    
-    const ssize_t write_result = write(fd, ptr, 1);
 
-    if (remove(filename))
+    ptr_ranges_size_ = 0;
+
+    char buffer[MAPS_BUFFER_SIZE_ + 1] = {};
+    size_t buffer_size = 0;
+    ssize_t read_size = 0;
+
+    while ((read_size = read(fd, buffer + buffer_size, MAPS_BUFFER_SIZE_ - buffer_size)) > 0)
     {
-        perror("Can't remove temp file");
-        return PTR_STATES_ERROR;
+        buffer_size += (size_t)read_size;
+        buffer[buffer_size] = '\0';
+
+        char* line = buffer;
+        char* line_end = NULL;
+        while ((line_end = strchr(line, '\n')))
+        {
+            char* cur = line;
+            const uintptr_t begin = (uintptr_t)strtoull(cur, &cur, 16);
+            const uintptr_t end   = (uintptr_t)strtoull(cur + 1, &cur, 16);
+
+            if (cur[1] == 'r' && ptr_ranges_push_(begin, end))
+            {
+                close(fd);
+                return -1;
+            }
+
+            line = line_end + 1;
+        }
+
+        buffer_size -= (size_t)(line - buffer);
+        memmove(buffer, line, buffer_size);
     }
 
-    if (close(fd))
+    if (close(fd) || read_size < 0)
     {
-        perror("Can't close temp file");
-        return PTR_STATES_ERROR;
+        perror("Can't read /proc/self/maps");
+        return -1;
+    }
+
+    return 0;
+}
+#undef MAPS_BUFFER_SIZE_
+
+static bool ptr_ranges_find_(const uintptr_t ptr)
+{
+    size_t left = 0;
+    size_t right = ptr_ranges_size_;
+
+    while (left < right)
+    {
+        const size_t middle = left + (right - left) / 2;
+
+        if (ptr_ranges_[middle].end <= ptr)
+            left = middle + 1;
+        else
+            right = middle;
     }
 
-    if (write_result == 1)
+    return left < ptr_ranges_size_ && ptr_ranges_[left].begin <= ptr;
+}
+
+#elif PTR_CHECK_LEVEL == 2
+
+#include <sys/uio.h>
+
+#endif /*PTR_CHECK_LEVEL*/
+
+enum PtrState is_invalid_ptr(const void* ptr)
+{
+    if (ptr == NULL)
+    {
+        return PTR_STATES_NULL;
+    }
+
+#if PTR_CHECK_LEVEL == 1
+
+    if (ptr_ranges_find_((uintptr_t)ptr))
+        return PTR_STATES_VALID;
+
+    // new mapping since the last update
+    if (ptr_ranges_update_())
+        return PTR_STATES_ERROR;
+
+    return ptr_ranges_find_((uintptr_t)ptr) ? PTR_STATES_VALID : PTR_STATES_INVALID;
+
+#elif PTR_CHECK_LEVEL == 2
+
+    char byte = 0;
+    const struct iovec local  = {.iov_base = &byte,                  .iov_len = 1};
+    const struct iovec remote = {.iov_base = (void*)(uintptr_t)ptr, .iov_len = 1};
+
+    const int saved_errno = errno;
+    if (process_vm_readv(getpid(), &local, 1, &remote, 1, 0) == 1)
         return PTR_STATES_VALID;
 
-    if (errno == EFAULT) 
+    if (errno == EFAULT)
     {
-        errno = 0;
+        errno = saved_errno;
         return PTR_STATES_INVALID;
     }
-    
-    perror("Unpredictable errno state, after write into temp file");
+
+    perror("Unpredictable errno state, after process_vm_readv");
     return PTR_STATES_ERROR;
+
+#else /*PTR_CHECK_LEVEL*/
+
+    return PTR_STATES_VALID;
+
+#endif /*PTR_CHECK_LEVEL*/
 }
 
 int is_empty_file (FILE* file)
@@ -141,6 +275,48 @@ int str_from_file(const char* const filename, wchar_t** str, size_t* const str_s
     return 0;
 }
 
+int map_file(const char* const filename, const char** data, size_t* const data_size)
+{
+    lassert(!is_invalid_ptr(filename), "");
+    lassert(!is_invalid_ptr(data), "");
+    lassert(data_size, "");
+
+    const int fd = open(filename, O_RDONLY);
+    if (fd == -1)
+    {
+        perror("Can't open input file");
+        return 1;
+    }
+
+    if (str_size_from_file_(data_size, fd))
+    {
+        fprintf(stderr, "Can't str_size_from_file_\n");
+        close(fd);
+        return 1;
+    }
+
+    *data = NULL;
+    if (*data_size)
+    {
+        void* const map = mmap(NULL, *data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (map == MAP_FAILED)
+        {
+            perror("Can't mmap");
+            close(fd);
+            return 1;
+        }
+        *data = map;
+    }
+
+    if (close(fd))
+    {
+        perror("Can't close input file");
+        return 1;
+    }
+
+    return 0;
+}
+
 static int str_size_from_file_(size_t* const str_size, const int fd)
 {
     lassert(str_size, "");
@@ -162,4 +338,16 @@ static int str_size_from_file_(size_t* const str_size, const int fd)
 bool isnum(const wchar_t chr)
 {
     return L'0' <= chr && chr <= L'9';
-}
\ No newline at end of file
+}
+
+double time_ms(void)
+{
+    struct timespec time = {};
+    if (clock_gettime(CLOCK_MONOTONIC, &time))
+    {
+        perror("Can't clock_gettime");
+        return 0;
+    }
+
+    return (double)time.tv_sec * 1000. + (double)time.tv_nsec / 1000000.;
+}
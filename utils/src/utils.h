@@ -28,14 +28,18 @@ enum PtrState
 };
 static_assert(PTR_STATES_VALID == 0);
 
+// NULL check in release, cached /proc/self/maps lookup in debug, see PTR_CHECK_LEVEL in utils.c
 enum PtrState is_invalid_ptr(const void* ptr);
 
 int is_empty_file (FILE* file);
 
 int str_from_file(const char* const filename, wchar_t** str, size_t* const str_size);
+// read only mmap of whole file, unmap with munmap(data, data_size) if data_size is not 0
+int map_file     (const char* const filename, const char** data, size_t* const data_size);
 
 bool isnum(const wchar_t chr);
 
-#define VAR_NAME_MAX 512
+// CLOCK_MONOTONIC time in milliseconds, only for differences
+double time_ms(void);
 
 #endif /*MASIK_UTILS_SRC_UTILS_H*/
\ No newline at end of file
@@ -6,5 +6,6 @@
 #include "src/tree/funcs/funcs.h"
 #include "src/tree/verification/verification.h"
 #include "src/tree/structs.h"
+#include "src/interner/interner.h"
 
 #endif /* MASIK_UTILS_UTILS_H */
\ No newline at end of file